@@ -0,0 +1,2340 @@
+/*
+ * Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+ */
+
+/**
+ * Micro-benchmarks for the library routines. The binary is built with the
+ * library unless SCA_ENABLE_CHECKS=OFF, in which case use `make sca_bench` in
+ * the build directory.
+ *
+ * Every benchmark runs a number of samples, each sample is a fixed number of
+ * iterations over a range of dates. Mean time per call, throughput and
+ * percentiles of the per-sample time per call are reported. With --threads
+ * every benchmark is also run concurrently in several threads using the
+ * library's thread pool, each thread runs all the samples; the throughput is
+ * then summed over the threads. With --json the results are printed as a
+ * JSON document suitable for comparison between builds. With --stats the
+ * library counters of the internal stages (see scastats.h) are reported for
+ * every benchmark, the library must be built with SCA_ENABLE_STATS=ON.
+ *
+ * With --check accuracy checks are run instead: fast paths (batch routines,
+ * accuracy tiers, time stepper, ephemeris cache, star reductions) are compared
+ * against the reference routines for dates from 1800 to 2200, trigonometric
+ * kernels of scafastmath.h are compared against libm, and results for
+ * worked examples from Meeus "Astronomical Algorithms" are compared against
+ * the published values. Maximum and RMS errors are reported, the exit status
+ * is non-zero if any error exceeds the accuracy documented for the routine.
+ * The checks are registered with CTest as sca_bench_check. Reference routines
+ * use libm unless the library is built with SCA_ENABLE_FAST_MATH=ON, then only
+ * the Meeus and math_* checks compare against independent values.
+ *
+ * Usage: sca_bench [--check] [--stats] [--threads N] [--samples N] [--iterations N] [--json] [NAME...]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <time.h>
+#endif
+
+#include <scalib.h>
+#include <scathreadpool.h>
+#include <scafastmath.h>
+
+#define SCA_BENCH_SAMPLES	20
+#define SCA_BENCH_ITERATIONS	10000
+#define SCA_BENCH_JD_BEGIN	2451545.0
+#define SCA_BENCH_JD_STEP	0.1
+#define SCA_BENCH_BATCH		256
+
+/* Runs the iterations and returns a sum of the results */
+typedef double (*SCABenchFunc) (size_t iterations);
+
+typedef struct _SCABench {
+	const char	*name;
+	SCABenchFunc	func;
+} SCABench;
+
+typedef struct _SCABenchJob {
+	SCABenchFunc	func;
+	size_t		iterations;
+	double		*times;		/* Time per call for every sample, in ns	*/
+	double		*sinks;		/* Sums of the results for every sample		*/
+} SCABenchJob;
+
+typedef struct _SCABenchResult {
+	int		threads;
+	double		mean;		/* Mean time per call, in ns			*/
+	double		ops;		/* Calls per second over all the threads	*/
+	double		p50;
+	double		p90;
+	double		p99;
+} SCABenchResult;
+
+/* Keeps the results alive so that the calls are not optimized out */
+static volatile double bench_sink;
+
+static double
+_sca_bench_get_time (void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER	freq, counter;
+
+	QueryPerformanceFrequency (&freq);
+	QueryPerformanceCounter (&counter);
+
+	return (double) counter.QuadPart / (double) freq.QuadPart;
+#else
+	struct timespec	ts;
+
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+
+	return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+#endif
+}
+
+static double
+_sca_bench_planet_earth (size_t iterations)
+{
+	SCAAngle	lon, lat;
+	double		dst, sink;
+	size_t		i;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		sca_planet_data_get (SCA_PLANET_EARTH, SCA_BENCH_JD_BEGIN + i * SCA_BENCH_JD_STEP, &lon, &lat, &dst);
+		sink += lon + lat + dst;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_planet_earth_lon (size_t iterations)
+{
+	double		sink;
+	SCAAngle	lon;
+	size_t		i;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		sca_planet_data_get (SCA_PLANET_EARTH, SCA_BENCH_JD_BEGIN + i * SCA_BENCH_JD_STEP, &lon, NULL, NULL);
+		sink += lon;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_planet_all (size_t iterations)
+{
+	SCAAngle	lon, lat;
+	double		dst, sink;
+	size_t		i;
+	int		planet;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i)
+		for (planet = SCA_PLANET_MERCURY; planet <= SCA_PLANET_NEPTUNE; ++planet) {
+			if (sca_planet_data_get ((SCAPlanet) planet,
+						 SCA_BENCH_JD_BEGIN + i * SCA_BENCH_JD_STEP,
+						 &lon, &lat, &dst) == 0)
+				sink += lon + lat + dst;
+		}
+
+	return sink;
+}
+
+static double
+_sca_bench_planet_earth_many (size_t iterations)
+{
+	double		jds[SCA_BENCH_BATCH], dst[SCA_BENCH_BATCH], sink;
+	SCAAngle	lon[SCA_BENCH_BATCH], lat[SCA_BENCH_BATCH];
+	size_t		i, k, count;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; i += count) {
+		count = (iterations - i < SCA_BENCH_BATCH) ? iterations - i : SCA_BENCH_BATCH;
+
+		for (k = 0; k < count; ++k)
+			jds[k] = SCA_BENCH_JD_BEGIN + (i + k) * SCA_BENCH_JD_STEP;
+
+		sca_planet_data_get_many (SCA_PLANET_EARTH, jds, count, lon, lat, dst);
+
+		for (k = 0; k < count; ++k)
+			sink += lon[k] + lat[k] + dst[k];
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_time_stepper (size_t iterations)
+{
+	SCATimeStepper	stepper;
+	SCAAngle	lon, lat;
+	double		dst, sink;
+	size_t		i;
+
+	sink = 0.0;
+
+	sca_time_stepper_new (&stepper, SCA_BENCH_JD_BEGIN, 1.0 / 86400.0);
+	sca_time_stepper_add (&stepper, SCA_EPHEMERIS_SUN);
+	sca_time_stepper_add (&stepper, SCA_EPHEMERIS_MOON);
+	sca_time_stepper_add (&stepper, SCA_EPHEMERIS_NUTATION);
+
+	for (i = 0; i < iterations; ++i) {
+		sca_time_stepper_next (&stepper);
+		sca_time_stepper_get (&stepper, SCA_EPHEMERIS_MOON, &lon, &lat, &dst);
+		sink += lon + lat + dst;
+	}
+
+	sca_time_stepper_free (&stepper);
+
+	return sink;
+}
+
+/* Built by the warm-up call, before the threads start, and kept until exit */
+static SCAEphemerisCache	bench_cache;
+static int			bench_cache_ready;
+
+static double
+_sca_bench_ephemeris_cache_get (size_t iterations)
+{
+	SCAAngle	lon, lat;
+	double		dst, sink;
+	size_t		i;
+
+	if (!bench_cache_ready) {
+		if (sca_ephemeris_cache_new (&bench_cache, SCA_BENCH_JD_BEGIN, SCA_BENCH_JD_BEGIN + 1000.0) != 0)
+			return 0.0;
+
+		if (sca_ephemeris_cache_add (&bench_cache, SCA_EPHEMERIS_MOON, 0.0, 0, NULL) != 0) {
+			sca_ephemeris_cache_free (&bench_cache);
+			return 0.0;
+		}
+
+		bench_cache_ready = 1;
+	}
+
+	sink = 0.0;
+
+	/* Steps over the cache interval so that different segments are used */
+	for (i = 0; i < iterations; ++i) {
+		sca_ephemeris_cache_get (&bench_cache, SCA_EPHEMERIS_MOON,
+					 SCA_BENCH_JD_BEGIN + fmod (i * SCA_BENCH_JD_STEP, 1000.0),
+					 &lon, &lat, &dst);
+		sink += lon + lat + dst;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_moon_local (size_t iterations)
+{
+	double		sink;
+	SCAEpoch	epoch;
+	SCAMoon		moon;
+	SCAGeoLocation	loc;
+	SCAObserver	obs;
+	SCAAngle	A, h;
+	size_t		i;
+
+	sink = 0.0;
+
+	sca_epoch_new (&epoch, SCA_BENCH_JD_BEGIN);
+	sca_moon_update_ctx (&moon, &epoch);
+
+	for (i = 0; i < iterations; ++i) {
+		loc.longitude	= -180.0 + (i % 3600) * 0.1;
+		loc.latitude	= -60.0 + (i % 1200) * 0.1;
+
+		sca_observer_new (&obs, &loc, 0.0);
+		sca_moon_get_local_coordinates_observer (&moon, &epoch, &obs, &A, &h);
+		sink += A + h;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_moon_local_many (size_t iterations)
+{
+	double		sink;
+	SCAEpoch	epoch;
+	SCAMoon		moon;
+	SCAAngle	lons[SCA_BENCH_BATCH], lats[SCA_BENCH_BATCH];
+	SCAAngle	A[SCA_BENCH_BATCH], h[SCA_BENCH_BATCH];
+	size_t		i, k, count;
+
+	sink = 0.0;
+
+	sca_epoch_new (&epoch, SCA_BENCH_JD_BEGIN);
+	sca_moon_update_ctx (&moon, &epoch);
+
+	for (i = 0; i < iterations; i += count) {
+		count = (iterations - i < SCA_BENCH_BATCH) ? iterations - i : SCA_BENCH_BATCH;
+
+		for (k = 0; k < count; ++k) {
+			lons[k] = -180.0 + ((i + k) % 3600) * 0.1;
+			lats[k] = -60.0 + ((i + k) % 1200) * 0.1;
+		}
+
+		sca_moon_get_local_coordinates_many (&moon, &epoch, lons, lats, count, A, h);
+
+		for (k = 0; k < count; ++k)
+			sink += A[k] + h[k];
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_sun_update_jd (size_t iterations)
+{
+	double	sink;
+	SCASun	sun;
+	size_t	i;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		sca_sun_update_jd (&sun, SCA_BENCH_JD_BEGIN + i * SCA_BENCH_JD_STEP);
+		sink += sun.ra + sun.dec;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_sun_update_series (size_t iterations)
+{
+	SCASun	suns[SCA_BENCH_BATCH];
+	double	jds[SCA_BENCH_BATCH], sink;
+	size_t	i, k, count;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; i += count) {
+		count = (iterations - i < SCA_BENCH_BATCH) ? iterations - i : SCA_BENCH_BATCH;
+
+		for (k = 0; k < count; ++k)
+			jds[k] = SCA_BENCH_JD_BEGIN + (i + k) * SCA_BENCH_JD_STEP;
+
+		sca_sun_update_series (suns, jds, count);
+
+		for (k = 0; k < count; ++k)
+			sink += suns[k].ra + suns[k].dec;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_jd_to_calendar (size_t iterations)
+{
+	double		sink;
+	SCADate		date;
+	SCAWeekDay	weekday;
+	size_t		i;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		sca_jd_to_calendar_date (SCA_BENCH_JD_BEGIN + i * SCA_BENCH_JD_STEP, &date);
+		sca_jd_get_weekday (SCA_BENCH_JD_BEGIN + i * SCA_BENCH_JD_STEP, &weekday);
+		sink += date.year + date.month + date.day + weekday;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_jd_to_calendar_many (size_t iterations)
+{
+	double		jds[SCA_BENCH_BATCH], days[SCA_BENCH_BATCH], sink;
+	int		years[SCA_BENCH_BATCH];
+	SCAMonth	months[SCA_BENCH_BATCH];
+	SCAWeekDay	weekdays[SCA_BENCH_BATCH];
+	size_t		i, k, count;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; i += count) {
+		count = (iterations - i < SCA_BENCH_BATCH) ? iterations - i : SCA_BENCH_BATCH;
+
+		for (k = 0; k < count; ++k)
+			jds[k] = SCA_BENCH_JD_BEGIN + (i + k) * SCA_BENCH_JD_STEP;
+
+		sca_jd_to_calendar_date_many (jds, count, years, months, days);
+		sca_jd_get_weekday_many (jds, count, weekdays);
+
+		for (k = 0; k < count; ++k)
+			sink += years[k] + months[k] + days[k] + weekdays[k];
+	}
+
+	return sink;
+}
+
+static void
+_sca_bench_get_date (size_t i, SCADate *date)
+{
+	date->year	= 2000;
+	date->month	= SCA_MONTH_JANUARY;
+	date->day	= 1.0 + (i % 300) * SCA_BENCH_JD_STEP;
+}
+
+static double
+_sca_bench_sun_update_date (size_t iterations)
+{
+	SCASun	sun;
+	SCADate	date;
+	double	sink;
+	size_t	i;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		_sca_bench_get_date (i, &date);
+		sca_sun_update_date (&sun, &date);
+		sink += sun.ra + sun.dec;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_moon_update_date (size_t iterations)
+{
+	SCAMoon	moon;
+	SCADate	date;
+	double	sink;
+	size_t	i;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		_sca_bench_get_date (i, &date);
+		sca_moon_update_date (&moon, &date);
+		sink += moon.ra + moon.dec;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_star_update_date (size_t iterations)
+{
+	SCAStar	star;
+	SCADate	date;
+	double	sink;
+	size_t	i;
+
+	/* Sirius */
+	sca_star_new (&star,
+		      sca_angle_from_decimal_degrees (101.287155),
+		      sca_angle_from_decimal_degrees (-16.716116),
+		      sca_angle_from_decimal_degrees (-0.546 / 3600.0),
+		      sca_angle_from_decimal_degrees (-1.223 / 3600.0));
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		_sca_bench_get_date (i, &date);
+		sca_star_update_date (&star, &date);
+		sink += star.ra + star.dec;
+	}
+
+	return sink;
+}
+
+/* Stars along a spiral over the sky, one per iteration */
+static void
+_sca_bench_get_star (size_t i, SCAAngle *ra, SCAAngle *dec)
+{
+	*ra	= fmod (i * 137.508, 360.0);
+	*dec	= -80.0 + fmod (i * 7.31, 160.0);
+}
+
+static double
+_sca_bench_star_update_catalog (size_t iterations)
+{
+	SCAStar		*stars;
+	SCAAngle	ra, dec;
+	double		sink;
+	size_t		i;
+
+	if ((stars = malloc (iterations * sizeof (SCAStar))) == NULL)
+		return 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		_sca_bench_get_star (i, &ra, &dec);
+		sca_star_new (&stars[i], ra, dec, 0.0, 0.0);
+	}
+
+	sca_star_update_catalog (stars, iterations, SCA_BENCH_JD_BEGIN);
+
+	for (i = 0, sink = 0.0; i < iterations; ++i)
+		sink += stars[i].ra + stars[i].dec;
+
+	free (stars);
+
+	return sink;
+}
+
+static double
+_sca_bench_star_catalog_update (size_t iterations)
+{
+	SCAStarCatalog	catalog;
+	SCAAngle	ra, dec;
+	double		sink;
+	size_t		i;
+
+	if (sca_star_catalog_new (&catalog, iterations) != 0)
+		return 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		_sca_bench_get_star (i, &ra, &dec);
+		sca_star_catalog_set (&catalog, i, ra, dec, 0.0, 0.0);
+	}
+
+	sca_star_catalog_update (&catalog, SCA_BENCH_JD_BEGIN);
+
+	for (i = 0, sink = 0.0; i < iterations; ++i)
+		sink += catalog.ra[i] + catalog.dec[i];
+
+	sca_star_catalog_free (&catalog);
+
+	return sink;
+}
+
+static double
+_sca_bench_parallel_star_update_catalog (size_t iterations)
+{
+	SCAStar		*stars;
+	SCAAngle	ra, dec;
+	double		sink;
+	size_t		i;
+
+	if ((stars = malloc (iterations * sizeof (SCAStar))) == NULL)
+		return 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		_sca_bench_get_star (i, &ra, &dec);
+		sca_star_new (&stars[i], ra, dec, 0.0, 0.0);
+	}
+
+	sca_parallel_star_update_catalog (stars, iterations, SCA_BENCH_JD_BEGIN);
+
+	for (i = 0, sink = 0.0; i < iterations; ++i)
+		sink += stars[i].ra + stars[i].dec;
+
+	free (stars);
+
+	return sink;
+}
+
+static double
+_sca_bench_parallel_star_catalog_update (size_t iterations)
+{
+	SCAStarCatalog	catalog;
+	SCAAngle	ra, dec;
+	double		sink;
+	size_t		i;
+
+	if (sca_star_catalog_new (&catalog, iterations) != 0)
+		return 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		_sca_bench_get_star (i, &ra, &dec);
+		sca_star_catalog_set (&catalog, i, ra, dec, 0.0, 0.0);
+	}
+
+	sca_parallel_star_catalog_update (&catalog, SCA_BENCH_JD_BEGIN);
+
+	for (i = 0, sink = 0.0; i < iterations; ++i)
+		sink += catalog.ra[i] + catalog.dec[i];
+
+	sca_star_catalog_free (&catalog);
+
+	return sink;
+}
+
+static double
+_sca_bench_parallel_eq_to_local (size_t iterations)
+{
+	SCAGeoLocation	*locs;
+	SCAAngle	*A, *h;
+	SCAEpoch	epoch;
+	double		sink;
+	size_t		i;
+
+	locs	= malloc (iterations * sizeof (SCAGeoLocation));
+	A	= malloc (iterations * sizeof (SCAAngle));
+	h	= malloc (iterations * sizeof (SCAAngle));
+	sink	= 0.0;
+
+	if (locs != NULL && A != NULL && h != NULL) {
+		for (i = 0; i < iterations; ++i) {
+			locs[i].longitude	= -180.0 + (i % 3600) * 0.1;
+			locs[i].latitude	= -60.0 + (i % 1200) * 0.1;
+		}
+
+		sca_epoch_new (&epoch, SCA_BENCH_JD_BEGIN);
+		sca_parallel_equatorial_to_local (&epoch, locs, iterations, 101.287155, -16.716116, A, h);
+
+		for (i = 0; i < iterations; ++i)
+			sink += A[i] + h[i];
+	}
+
+	free (locs);
+	free (A);
+	free (h);
+
+	return sink;
+}
+
+static double
+_sca_bench_parallel_sun_update_series (size_t iterations)
+{
+	SCASun	*suns;
+	double	*jds, sink;
+	size_t	i;
+
+	suns	= malloc (iterations * sizeof (SCASun));
+	jds	= malloc (iterations * sizeof (double));
+	sink	= 0.0;
+
+	if (suns != NULL && jds != NULL) {
+		for (i = 0; i < iterations; ++i)
+			jds[i] = SCA_BENCH_JD_BEGIN + i * SCA_BENCH_JD_STEP;
+
+		sca_parallel_sun_update_series (suns, jds, iterations);
+
+		for (i = 0; i < iterations; ++i)
+			sink += suns[i].ra + suns[i].dec;
+	}
+
+	free (suns);
+	free (jds);
+
+	return sink;
+}
+
+static double
+_sca_bench_parallel_moon_update_series (size_t iterations)
+{
+	SCAMoon	*moons;
+	double	*jds, sink;
+	size_t	i;
+
+	moons	= malloc (iterations * sizeof (SCAMoon));
+	jds	= malloc (iterations * sizeof (double));
+	sink	= 0.0;
+
+	if (moons != NULL && jds != NULL) {
+		for (i = 0; i < iterations; ++i)
+			jds[i] = SCA_BENCH_JD_BEGIN + i * SCA_BENCH_JD_STEP;
+
+		sca_parallel_moon_update_series (moons, jds, iterations);
+
+		for (i = 0; i < iterations; ++i)
+			sink += moons[i].ra + moons[i].dec;
+	}
+
+	free (moons);
+	free (jds);
+
+	return sink;
+}
+
+static double
+_sca_bench_earth_nutation (size_t iterations)
+{
+	SCAAngle	nut, obl;
+	double		sink;
+	size_t		i;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		sca_earth_get_nutation (SCA_BENCH_JD_BEGIN + i * SCA_BENCH_JD_STEP, &nut, &obl);
+		sink += nut + obl;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_earth_parallax (size_t iterations)
+{
+	SCAGeoLocation	loc;
+	SCAAngle	d_ra, d_dec;
+	double		sink;
+	size_t		i;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		loc.longitude	= -180.0 + (i % 3600) * 0.1;
+		loc.latitude	= -60.0 + (i % 1200) * 0.1;
+
+		sca_earth_get_parallax_equatorial (SCA_BENCH_JD_BEGIN + i * SCA_BENCH_JD_STEP,
+						   0.0025, &loc, (i % 3600) * 0.1, 10.0, &d_ra, &d_dec);
+		sink += d_ra + d_dec;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_sidereal_time (size_t iterations)
+{
+	SCAAngle	sidereal;
+	double		sink;
+	size_t		i;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		sca_jd_get_sidereal_time (SCA_BENCH_JD_BEGIN + i * SCA_BENCH_JD_STEP, &sidereal);
+		sink += sidereal;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_coords_eq_to_ecl (size_t iterations)
+{
+	SCAAngle	lon, lat;
+	double		sink;
+	size_t		i;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		sca_coordinates_equatorial_to_ecliptic (SCA_BENCH_JD_BEGIN + i * SCA_BENCH_JD_STEP,
+							(i % 3600) * 0.1, -60.0 + (i % 1200) * 0.1,
+							&lon, &lat);
+		sink += lon + lat;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_coords_ecl_to_eq (size_t iterations)
+{
+	SCAAngle	ra, dec;
+	double		sink;
+	size_t		i;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		sca_coordinates_ecliptic_to_equatorial (SCA_BENCH_JD_BEGIN + i * SCA_BENCH_JD_STEP,
+							(i % 3600) * 0.1, -60.0 + (i % 1200) * 0.1,
+							&ra, &dec);
+		sink += ra + dec;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_coords_eq_to_local (size_t iterations)
+{
+	SCAGeoLocation	loc;
+	SCAAngle	A, h;
+	double		sink;
+	size_t		i;
+
+	loc.longitude	= -37.6;
+	loc.latitude	= 55.75;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		sca_coordinates_equatorial_to_local (SCA_BENCH_JD_BEGIN + i * SCA_BENCH_JD_STEP, &loc,
+						     (i % 3600) * 0.1, -60.0 + (i % 1200) * 0.1,
+						     &A, &h);
+		sink += A + h;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_coords_eq_to_ecl_ctx (size_t iterations)
+{
+	SCAEpoch	epoch;
+	SCAAngle	lon, lat;
+	double		sink;
+	size_t		i;
+
+	sca_epoch_new (&epoch, SCA_BENCH_JD_BEGIN);
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		sca_coordinates_equatorial_to_ecliptic_ctx (&epoch, (i % 3600) * 0.1, -60.0 + (i % 1200) * 0.1,
+							    &lon, &lat);
+		sink += lon + lat;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_coords_ecl_to_eq_ctx (size_t iterations)
+{
+	SCAEpoch	epoch;
+	SCAAngle	ra, dec;
+	double		sink;
+	size_t		i;
+
+	sca_epoch_new (&epoch, SCA_BENCH_JD_BEGIN);
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		sca_coordinates_ecliptic_to_equatorial_ctx (&epoch, (i % 3600) * 0.1, -60.0 + (i % 1200) * 0.1,
+							    &ra, &dec);
+		sink += ra + dec;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_coords_eq_to_local_ctx (size_t iterations)
+{
+	SCAEpoch	epoch;
+	SCAGeoLocation	loc;
+	SCAAngle	A, h;
+	double		sink;
+	size_t		i;
+
+	sca_epoch_new (&epoch, SCA_BENCH_JD_BEGIN);
+
+	loc.longitude	= -37.6;
+	loc.latitude	= 55.75;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		sca_coordinates_equatorial_to_local_ctx (&epoch, &loc, (i % 3600) * 0.1, -60.0 + (i % 1200) * 0.1,
+							 &A, &h);
+		sink += A + h;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_coords_eq_to_local_observer (size_t iterations)
+{
+	SCAEpoch	epoch;
+	SCAGeoLocation	loc;
+	SCAObserver	obs;
+	SCAAngle	A, h;
+	double		sink;
+	size_t		i;
+
+	sca_epoch_new (&epoch, SCA_BENCH_JD_BEGIN);
+
+	loc.longitude	= -37.6;
+	loc.latitude	= 55.75;
+
+	sca_observer_new (&obs, &loc, 150.0);
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		sca_coordinates_equatorial_to_local_observer (&epoch, &obs, (i % 3600) * 0.1, -60.0 + (i % 1200) * 0.1,
+							      &A, &h);
+		sink += A + h;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_coords_eq_to_local_many (size_t iterations)
+{
+	SCAEpoch	epoch;
+	SCAAngle	lons[SCA_BENCH_BATCH], lats[SCA_BENCH_BATCH];
+	SCAAngle	A[SCA_BENCH_BATCH], h[SCA_BENCH_BATCH];
+	double		sink;
+	size_t		i, k, count;
+
+	sca_epoch_new (&epoch, SCA_BENCH_JD_BEGIN);
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; i += count) {
+		count = (iterations - i < SCA_BENCH_BATCH) ? iterations - i : SCA_BENCH_BATCH;
+
+		for (k = 0; k < count; ++k) {
+			lons[k] = -180.0 + ((i + k) % 3600) * 0.1;
+			lats[k] = -60.0 + ((i + k) % 1200) * 0.1;
+		}
+
+		sca_coordinates_equatorial_to_local_many (&epoch, 101.3, -16.7, 0.0, lons, lats, count, A, h);
+
+		for (k = 0; k < count; ++k)
+			sink += A[k] + h[k];
+	}
+
+	return sink;
+}
+
+/* Arguments for the math benchmarks sweep [-2 Pi, 2 Pi) */
+#define SCA_BENCH_MATH_ARG(i)	((double) ((i) % 4096) * (4.0 * SCA_FAST_PI / 4096.0) - 2.0 * SCA_FAST_PI)
+
+static double
+_sca_bench_math_sincos_libm (size_t iterations)
+{
+	double	x, sink;
+	size_t	i;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		x	= SCA_BENCH_MATH_ARG (i);
+		sink	+= sin (x) + cos (x);
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_math_sincos_fast (size_t iterations)
+{
+	double	x, s, c, sink;
+	size_t	i;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		x = SCA_BENCH_MATH_ARG (i);
+		sca_fast_sincos (x, &s, &c);
+		sink += s + c;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_math_atan2_libm (size_t iterations)
+{
+	double	x, sink;
+	size_t	i;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		x	= SCA_BENCH_MATH_ARG (i);
+		sink	+= atan2 (x, 1.5 - x);
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_math_atan2_fast (size_t iterations)
+{
+	double	x, sink;
+	size_t	i;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		x	= SCA_BENCH_MATH_ARG (i);
+		sink	+= sca_fast_atan2 (x, 1.5 - x);
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_math_asin_libm (size_t iterations)
+{
+	double	sink;
+	size_t	i;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i)
+		sink += asin (SCA_BENCH_MATH_ARG (i) / 6.3);
+
+	return sink;
+}
+
+static double
+_sca_bench_math_asin_fast (size_t iterations)
+{
+	double	sink;
+	size_t	i;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i)
+		sink += sca_fast_asin (SCA_BENCH_MATH_ARG (i) / 6.3);
+
+	return sink;
+}
+
+/*
+ * Array versions of the Arctangent and Arcsine benchmarks. The fast kernels
+ * are used only in loops over arrays which are vectorized for the instruction
+ * set selected at runtime (star catalog, batch local coordinates), here the
+ * loop is compiled and dispatched the same way.
+ */
+typedef enum _SCABenchMathFunc {
+	SCA_BENCH_MATH_ATAN2_LIBM,
+	SCA_BENCH_MATH_ATAN2_FAST,
+	SCA_BENCH_MATH_ASIN_LIBM,
+	SCA_BENCH_MATH_ASIN_FAST
+} SCABenchMathFunc;
+
+typedef void (*SCABenchMathKernel) (SCABenchMathFunc func, size_t n, const double *y, const double *x, double *out);
+
+SCA_ALWAYS_INLINE void
+_sca_bench_math_kernel (SCABenchMathFunc		func,
+			size_t				n,
+			const double * SCA_RESTRICT	y,
+			const double * SCA_RESTRICT	x,
+			double * SCA_RESTRICT		out)
+{
+	size_t	k;
+
+	switch (func) {
+	case SCA_BENCH_MATH_ATAN2_LIBM:
+		for (k = 0; k < n; ++k)
+			out[k] = atan2 (y[k], x[k]);
+		break;
+	case SCA_BENCH_MATH_ATAN2_FAST:
+		for (k = 0; k < n; ++k)
+			out[k] = sca_fast_atan2 (y[k], x[k]);
+		break;
+	case SCA_BENCH_MATH_ASIN_LIBM:
+		for (k = 0; k < n; ++k)
+			out[k] = asin (y[k]);
+		break;
+	default:
+		for (k = 0; k < n; ++k)
+			out[k] = sca_fast_asin (y[k]);
+		break;
+	}
+}
+
+static void
+_sca_bench_math_kernel_generic (SCABenchMathFunc func, size_t n, const double *y, const double *x, double *out)
+{
+	_sca_bench_math_kernel (func, n, y, x, out);
+}
+
+#ifdef HAVE_CPU_DISPATCH
+__attribute__ ((target ("avx2,fma"))) static void
+_sca_bench_math_kernel_avx2 (SCABenchMathFunc func, size_t n, const double *y, const double *x, double *out)
+{
+	_sca_bench_math_kernel (func, n, y, x, out);
+}
+
+__attribute__ ((target ("avx512f"))) static void
+_sca_bench_math_kernel_avx512 (SCABenchMathFunc func, size_t n, const double *y, const double *x, double *out)
+{
+	_sca_bench_math_kernel (func, n, y, x, out);
+}
+#endif
+
+static double
+_sca_bench_math_array (size_t iterations, SCABenchMathFunc func)
+{
+	SCABenchMathKernel	kernel;
+	double			y[SCA_BENCH_BATCH], x[SCA_BENCH_BATCH], out[SCA_BENCH_BATCH], sink;
+	size_t			i, k, count;
+
+#ifdef HAVE_CPU_DISPATCH
+	if (__builtin_cpu_supports ("avx512f"))
+		kernel = _sca_bench_math_kernel_avx512;
+	else if (__builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma"))
+		kernel = _sca_bench_math_kernel_avx2;
+	else
+		kernel = _sca_bench_math_kernel_generic;
+#else
+	kernel = _sca_bench_math_kernel_generic;
+#endif
+
+	/* The same arguments as for the scalar benchmarks */
+	for (k = 0; k < SCA_BENCH_BATCH; ++k) {
+		if (func == SCA_BENCH_MATH_ASIN_LIBM || func == SCA_BENCH_MATH_ASIN_FAST)
+			y[k] = SCA_BENCH_MATH_ARG (k * 16) / 6.3;
+		else
+			y[k] = SCA_BENCH_MATH_ARG (k * 16);
+
+		x[k] = 1.5 - y[k];
+	}
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; i += count) {
+		count = (iterations - i < SCA_BENCH_BATCH) ? iterations - i : SCA_BENCH_BATCH;
+
+		kernel (func, count, y, x, out);
+
+		for (k = 0; k < count; ++k)
+			sink += out[k];
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_math_atan2_array_libm (size_t iterations)
+{
+	return _sca_bench_math_array (iterations, SCA_BENCH_MATH_ATAN2_LIBM);
+}
+
+static double
+_sca_bench_math_atan2_array_fast (size_t iterations)
+{
+	return _sca_bench_math_array (iterations, SCA_BENCH_MATH_ATAN2_FAST);
+}
+
+static double
+_sca_bench_math_asin_array_libm (size_t iterations)
+{
+	return _sca_bench_math_array (iterations, SCA_BENCH_MATH_ASIN_LIBM);
+}
+
+static double
+_sca_bench_math_asin_array_fast (size_t iterations)
+{
+	return _sca_bench_math_array (iterations, SCA_BENCH_MATH_ASIN_FAST);
+}
+
+/* Sample ISO 8601 strings covering the supported forms */
+static const char *bench_iso8601[] = {
+	"2000-01-01T12:00:00Z",
+	"1987-04-10T19:21:00.5+03:00",
+	"2024-02-29 23:59:59,125-05:30",
+	"1582-10-04T06:00",
+	"-0500-03-15",
+	"2016-12-31T23:59:60Z",
+	"2100-07-04T00:00:00.000001+0100",
+	"1957-10-04T19:28:34Z"
+};
+
+#define SCA_BENCH_ISO8601_COUNT	(sizeof (bench_iso8601) / sizeof (bench_iso8601[0]))
+
+static double
+_sca_bench_jd_from_iso8601 (size_t iterations)
+{
+	double	jd, sink;
+	size_t	i;
+
+	sink = 0.0;
+
+	for (i = 0; i < iterations; ++i) {
+		sca_jd_from_iso8601 (bench_iso8601[i % SCA_BENCH_ISO8601_COUNT], &jd);
+		sink += jd;
+	}
+
+	return sink;
+}
+
+static double
+_sca_bench_jd_from_iso8601_many (size_t iterations)
+{
+	const char	*strs[SCA_BENCH_BATCH];
+	double		jds[SCA_BENCH_BATCH], sink;
+	size_t		i, k, count;
+
+	sink = 0.0;
+
+	for (k = 0; k < SCA_BENCH_BATCH; ++k)
+		strs[k] = bench_iso8601[k % SCA_BENCH_ISO8601_COUNT];
+
+	for (i = 0; i < iterations; i += count) {
+		count = (iterations - i < SCA_BENCH_BATCH) ? iterations - i : SCA_BENCH_BATCH;
+
+		sca_jd_from_iso8601_many (strs, count, jds);
+
+		for (k = 0; k < count; ++k)
+			sink += jds[k];
+	}
+
+	return sink;
+}
+
+static const SCABench benches[] = {
+	{"planet_earth",		_sca_bench_planet_earth},
+	{"planet_earth_lon",		_sca_bench_planet_earth_lon},
+	{"planet_earth_many",		_sca_bench_planet_earth_many},
+	{"planet_all",			_sca_bench_planet_all},
+	{"time_stepper",		_sca_bench_time_stepper},
+	{"ephemeris_cache_get",		_sca_bench_ephemeris_cache_get},
+	{"moon_local",			_sca_bench_moon_local},
+	{"moon_local_many",		_sca_bench_moon_local_many},
+	{"sun_update_jd",		_sca_bench_sun_update_jd},
+	{"sun_update_series",		_sca_bench_sun_update_series},
+	{"jd_to_calendar",		_sca_bench_jd_to_calendar},
+	{"jd_to_calendar_many",		_sca_bench_jd_to_calendar_many},
+	{"jd_from_iso8601",		_sca_bench_jd_from_iso8601},
+	{"jd_from_iso8601_many",	_sca_bench_jd_from_iso8601_many},
+	{"sun_update_date",		_sca_bench_sun_update_date},
+	{"moon_update_date",		_sca_bench_moon_update_date},
+	{"star_update_date",		_sca_bench_star_update_date},
+	{"star_update_catalog",		_sca_bench_star_update_catalog},
+	{"star_catalog_update",		_sca_bench_star_catalog_update},
+	{"parallel_star_update_catalog",	_sca_bench_parallel_star_update_catalog},
+	{"parallel_star_catalog_update",	_sca_bench_parallel_star_catalog_update},
+	{"parallel_eq_to_local",	_sca_bench_parallel_eq_to_local},
+	{"parallel_sun_update_series",	_sca_bench_parallel_sun_update_series},
+	{"parallel_moon_update_series",	_sca_bench_parallel_moon_update_series},
+	{"earth_nutation",		_sca_bench_earth_nutation},
+	{"earth_parallax",		_sca_bench_earth_parallax},
+	{"sidereal_time",		_sca_bench_sidereal_time},
+	{"coords_eq_to_ecl",		_sca_bench_coords_eq_to_ecl},
+	{"coords_ecl_to_eq",		_sca_bench_coords_ecl_to_eq},
+	{"coords_eq_to_local",		_sca_bench_coords_eq_to_local},
+	{"coords_eq_to_ecl_ctx",	_sca_bench_coords_eq_to_ecl_ctx},
+	{"coords_ecl_to_eq_ctx",	_sca_bench_coords_ecl_to_eq_ctx},
+	{"coords_eq_to_local_ctx",	_sca_bench_coords_eq_to_local_ctx},
+	{"coords_eq_to_local_observer",	_sca_bench_coords_eq_to_local_observer},
+	{"coords_eq_to_local_many",	_sca_bench_coords_eq_to_local_many},
+	{"math_sincos_libm",		_sca_bench_math_sincos_libm},
+	{"math_sincos_fast",		_sca_bench_math_sincos_fast},
+	{"math_atan2_libm",		_sca_bench_math_atan2_libm},
+	{"math_atan2_fast",		_sca_bench_math_atan2_fast},
+	{"math_asin_libm",		_sca_bench_math_asin_libm},
+	{"math_asin_fast",		_sca_bench_math_asin_fast},
+	{"math_atan2_array_libm",	_sca_bench_math_atan2_array_libm},
+	{"math_atan2_array_fast",	_sca_bench_math_atan2_array_fast},
+	{"math_asin_array_libm",	_sca_bench_math_asin_array_libm},
+	{"math_asin_array_fast",	_sca_bench_math_asin_array_fast}
+};
+
+/* Accuracy checks sweep from January 1, 1800 to January 1, 2200 */
+#define SCA_CHECK_JD_BEGIN	2378496.5
+#define SCA_CHECK_JD_END	2524593.5
+#define SCA_CHECK_POINTS	2048
+#define SCA_CHECK_ARCSEC	3600.0
+#define SCA_CHECK_DEG_TO_RAD	(3.14159265358979323846 / 180.0)
+
+typedef struct _SCACheckStats {
+	size_t		count;
+	double		max;		/* Maximum error, in arcseconds			*/
+	double		sum_sq;		/* Sum of the squared errors			*/
+} SCACheckStats;
+
+typedef void (*SCACheckFunc) (SCACheckStats *stats, double param);
+
+typedef struct _SCACheck {
+	const char	*name;
+	SCACheckFunc	func;
+	double		param;		/* Passed to the function, e.g. accuracy tier	*/
+	double		budget;		/* Maximum allowed error, in arcseconds		*/
+} SCACheck;
+
+/* Stars for the reduction checks: J2000 RA, Dec in degrees, RA and Dec proper motions in arcseconds */
+static const double check_stars[][4] = {
+	{37.954561,	89.264109,	 0.19,		-0.012},	/* Polaris */
+	{279.234735,	38.783689,	 0.2005,	 0.2863},	/* Vega */
+	{310.357980,	45.280339,	 0.00199,	 0.00195},	/* Deneb */
+	{101.287155,	-16.716116,	-0.5685,	-1.223},	/* Sirius */
+	{95.987958,	-52.695661,	 0.0331,	 0.0234},	/* Canopus */
+	{317.195,	-88.956,	 0.025,		 0.005},	/* Sigma Octantis */
+	{41.054063,	49.228467,	 0.51375,	-0.0895},	/* Theta Persei */
+	{269.452075,	4.693391,	-0.80132,	 10.32812}	/* Barnard's Star */
+};
+
+#define SCA_CHECK_STARS		(sizeof (check_stars) / sizeof (check_stars[0]))
+
+static double
+_sca_check_get_jd (size_t i)
+{
+	return SCA_CHECK_JD_BEGIN + (SCA_CHECK_JD_END - SCA_CHECK_JD_BEGIN) * i / (SCA_CHECK_POINTS - 1);
+}
+
+static void
+_sca_check_add (SCACheckStats *stats, double err)
+{
+	err = fabs (err);
+
+	if (err > stats->max || err != err)
+		stats->max = err;
+
+	stats->sum_sq += err * err;
+	stats->count++;
+}
+
+/* Adds angular distance between two points on the sphere, coordinates in degrees */
+static void
+_sca_check_add_separation (SCACheckStats *stats, double lon1, double lat1, double lon2, double lat2)
+{
+	double	d_lon, d_lat, a;
+
+	d_lon	= sin ((lon1 - lon2) * SCA_CHECK_DEG_TO_RAD / 2.0);
+	d_lat	= sin ((lat1 - lat2) * SCA_CHECK_DEG_TO_RAD / 2.0);
+	a	= d_lat * d_lat + cos (lat1 * SCA_CHECK_DEG_TO_RAD) * cos (lat2 * SCA_CHECK_DEG_TO_RAD) * d_lon * d_lon;
+
+	_sca_check_add (stats, 2.0 * asin (sqrt (a)) / SCA_CHECK_DEG_TO_RAD * SCA_CHECK_ARCSEC);
+}
+
+static void
+_sca_check_new_star (SCAStar *star, size_t index)
+{
+	const double	*s;
+
+	s = check_stars[index];
+
+	sca_star_new (star, s[0], s[1], s[2] / SCA_CHECK_ARCSEC, s[3] / SCA_CHECK_ARCSEC);
+}
+
+static void
+_sca_check_new_star_cached (SCAStarCached *star, size_t index)
+{
+	const double	*s;
+
+	s = check_stars[index];
+
+	sca_star_cached_new (star, s[0], s[1], s[2] / SCA_CHECK_ARCSEC, s[3] / SCA_CHECK_ARCSEC);
+}
+
+static void
+_sca_check_planet_data_many (SCACheckStats *stats, double param)
+{
+	double		jds[SCA_BENCH_BATCH], dst[SCA_BENCH_BATCH], ref_dst;
+	SCAAngle	lon[SCA_BENCH_BATCH], lat[SCA_BENCH_BATCH], ref_lon, ref_lat;
+	size_t		i, k, count;
+	int		planet;
+
+	(void) param;
+
+	for (planet = SCA_PLANET_MERCURY; planet <= SCA_PLANET_NEPTUNE; ++planet) {
+		for (i = 0; i < SCA_CHECK_POINTS; i += count) {
+			count = (SCA_CHECK_POINTS - i < SCA_BENCH_BATCH) ? SCA_CHECK_POINTS - i : SCA_BENCH_BATCH;
+
+			for (k = 0; k < count; ++k)
+				jds[k] = _sca_check_get_jd (i + k);
+
+			sca_planet_data_get_many ((SCAPlanet) planet, jds, count, lon, lat, dst);
+
+			for (k = 0; k < count; ++k) {
+				sca_planet_data_get ((SCAPlanet) planet, jds[k], &ref_lon, &ref_lat, &ref_dst);
+				_sca_check_add_separation (stats, lon[k], lat[k], ref_lon, ref_lat);
+				/* Distance error is relative, the same as for the accuracy tiers */
+				_sca_check_add (stats, (dst[k] - ref_dst) / ref_dst / SCA_CHECK_DEG_TO_RAD * SCA_CHECK_ARCSEC);
+			}
+		}
+	}
+}
+
+static void
+_sca_check_planet_data_tier (SCACheckStats *stats, double param)
+{
+	SCAAngle	lon, lat, ref_lon, ref_lat;
+	double		dst, ref_dst, jd;
+	size_t		i;
+	int		planet;
+
+	for (planet = SCA_PLANET_MERCURY; planet <= SCA_PLANET_NEPTUNE; ++planet) {
+		for (i = 0; i < SCA_CHECK_POINTS; ++i) {
+			jd = _sca_check_get_jd (i);
+
+			sca_planet_data_get_accuracy ((SCAPlanet) planet, jd, param, &lon, &lat, &dst);
+			sca_planet_data_get ((SCAPlanet) planet, jd, &ref_lon, &ref_lat, &ref_dst);
+
+			/* Longitudes may be on different sides of 0 */
+			_sca_check_add (stats, remainder (lon - ref_lon, 360.0) * SCA_CHECK_ARCSEC);
+			_sca_check_add (stats, (lat - ref_lat) * SCA_CHECK_ARCSEC);
+			_sca_check_add (stats, (dst - ref_dst) / ref_dst / SCA_CHECK_DEG_TO_RAD * SCA_CHECK_ARCSEC);
+		}
+	}
+}
+
+/**
+ * Reference apparent place of the Sun, written independently of scasun.c:
+ * Earth's VSOP87 coordinates with nutation and aberration (Meeus 25.10) are
+ * rotated to the equator as a vector.
+ */
+static void
+_sca_check_get_sun (double jd, SCAAngle *ra, SCAAngle *dec)
+{
+	SCAAngle	L, B, nut, obl;
+	double		R, e, x, y, z;
+
+	sca_planet_data_get (SCA_PLANET_EARTH, jd, &L, &B, &R);
+	sca_earth_get_nutation (jd, &nut, NULL);
+	sca_earth_get_ecliptic_obliquity (jd, &obl);
+
+	L = (L + 180.0 + nut - 20.4898 / SCA_CHECK_ARCSEC / R) * SCA_CHECK_DEG_TO_RAD;
+	B = -B * SCA_CHECK_DEG_TO_RAD;
+	e = obl * SCA_CHECK_DEG_TO_RAD;
+
+	x = cos (B) * cos (L);
+	y = cos (B) * sin (L) * cos (e) - sin (B) * sin (e);
+	z = cos (B) * sin (L) * sin (e) + sin (B) * cos (e);
+
+	*ra	= atan2 (y, x) / SCA_CHECK_DEG_TO_RAD;
+	*dec	= asin (z) / SCA_CHECK_DEG_TO_RAD;
+}
+
+static void
+_sca_check_sun_series (SCACheckStats *stats, double param)
+{
+	SCASun		suns[SCA_BENCH_BATCH], sun;
+	SCADate		date;
+	SCAAngle	ref_ra, ref_dec;
+	double		jds[SCA_BENCH_BATCH];
+	size_t		i, k, count;
+
+	(void) param;
+
+	for (i = 0; i < SCA_CHECK_POINTS; i += count) {
+		count = (SCA_CHECK_POINTS - i < SCA_BENCH_BATCH) ? SCA_CHECK_POINTS - i : SCA_BENCH_BATCH;
+
+		for (k = 0; k < count; ++k)
+			jds[k] = _sca_check_get_jd (i + k);
+
+		sca_sun_update_series (suns, jds, count);
+
+		for (k = 0; k < count; ++k) {
+			_sca_check_get_sun (jds[k], &ref_ra, &ref_dec);
+			_sca_check_add_separation (stats, suns[k].ra, suns[k].dec, ref_ra, ref_dec);
+
+			sca_jd_to_calendar_date (jds[k], &date);
+			sca_sun_update_date (&sun, &date);
+			_sca_check_add_separation (stats, sun.ra, sun.dec, ref_ra, ref_dec);
+		}
+	}
+}
+
+/* Steps over a day every 10 minutes from several starting instances */
+static void
+_sca_check_stepper (SCACheckStats *stats, double param)
+{
+	SCATimeStepper	stepper;
+	SCAEpoch	epoch, ref_epoch;
+	SCASun		sun, ref_sun;
+	SCAMoon		moon, ref_moon;
+	size_t		i, k;
+
+	(void) param;
+
+	for (i = 0; i < SCA_CHECK_POINTS; i += 64) {
+		sca_time_stepper_new (&stepper, _sca_check_get_jd (i), 10.0 / 1440.0);
+		sca_time_stepper_add (&stepper, SCA_EPHEMERIS_SUN);
+		sca_time_stepper_add (&stepper, SCA_EPHEMERIS_MOON);
+		sca_time_stepper_add (&stepper, SCA_EPHEMERIS_NUTATION);
+
+		for (k = 0; k <= 144; ++k, sca_time_stepper_next (&stepper)) {
+			sca_epoch_new_stepper (&epoch, &stepper);
+			sca_epoch_new (&ref_epoch, stepper.jd);
+
+			sca_sun_update_stepper (&sun, &epoch, &stepper);
+			sca_sun_update_ctx (&ref_sun, &ref_epoch);
+			sca_moon_update_stepper (&moon, &epoch, &stepper);
+			sca_moon_update_ctx (&ref_moon, &ref_epoch);
+
+			_sca_check_add_separation (stats, sun.ra, sun.dec, ref_sun.ra, ref_sun.dec);
+			_sca_check_add_separation (stats, moon.ra, moon.dec, ref_moon.ra, ref_moon.dec);
+		}
+
+		sca_time_stepper_free (&stepper);
+	}
+}
+
+static void
+_sca_check_cache (SCACheckStats *stats, double param)
+{
+	SCAEphemerisCache	cache;
+	SCAEpoch		epoch, ref_epoch;
+	SCASun			sun, ref_sun;
+	SCAMoon			moon, ref_moon;
+	double			jd;
+	size_t			i;
+
+	(void) param;
+
+	if (sca_ephemeris_cache_new (&cache, SCA_CHECK_JD_BEGIN, SCA_CHECK_JD_END) != 0)
+		return;
+
+	if (sca_ephemeris_cache_add (&cache, SCA_EPHEMERIS_SUN, 0.0, 0, NULL) != 0 ||
+	    sca_ephemeris_cache_add (&cache, SCA_EPHEMERIS_MOON, 0.0, 0, NULL) != 0 ||
+	    sca_ephemeris_cache_add (&cache, SCA_EPHEMERIS_NUTATION, 0.0, 0, NULL) != 0) {
+		sca_ephemeris_cache_free (&cache);
+		return;
+	}
+
+	/* Shifted off the segment boundaries */
+	for (i = 0; i < SCA_CHECK_POINTS - 1; ++i) {
+		jd = _sca_check_get_jd (i) + 0.37;
+
+		sca_epoch_new_cache (&epoch, jd, &cache);
+		sca_epoch_new (&ref_epoch, jd);
+
+		sca_sun_update_cache (&sun, &epoch, &cache);
+		sca_sun_update_ctx (&ref_sun, &ref_epoch);
+		sca_moon_update_cache (&moon, &epoch, &cache);
+		sca_moon_update_ctx (&ref_moon, &ref_epoch);
+
+		_sca_check_add_separation (stats, sun.ra, sun.dec, ref_sun.ra, ref_sun.dec);
+		_sca_check_add_separation (stats, moon.ra, moon.dec, ref_moon.ra, ref_moon.dec);
+	}
+
+	sca_ephemeris_cache_free (&cache);
+}
+
+static void
+_sca_check_star_catalog (SCACheckStats *stats, double param)
+{
+	SCAStarCatalog	catalog;
+	SCAStar		ref;
+	size_t		i, k;
+
+	(void) param;
+
+	if (sca_star_catalog_new (&catalog, SCA_CHECK_STARS) != 0)
+		return;
+
+	for (k = 0; k < SCA_CHECK_STARS; ++k)
+		sca_star_catalog_set (&catalog, k,
+				      check_stars[k][0], check_stars[k][1],
+				      check_stars[k][2] / SCA_CHECK_ARCSEC, check_stars[k][3] / SCA_CHECK_ARCSEC);
+
+	for (i = 0; i < SCA_CHECK_POINTS; i += 4) {
+		sca_star_catalog_update (&catalog, _sca_check_get_jd (i));
+
+		for (k = 0; k < SCA_CHECK_STARS; ++k) {
+			_sca_check_new_star (&ref, k);
+			sca_star_update_jd (&ref, _sca_check_get_jd (i));
+			_sca_check_add_separation (stats, catalog.ra[k], catalog.dec[k], ref.ra, ref.dec);
+		}
+	}
+
+	sca_star_catalog_free (&catalog);
+}
+
+static void
+_sca_check_star_matrix (SCACheckStats *stats, double param)
+{
+	SCAStarMatrix	matrix;
+	SCAEpoch	epoch;
+	SCAStar		star, ref;
+	size_t		i, k;
+
+	(void) param;
+
+	for (i = 0; i < SCA_CHECK_POINTS; i += 4) {
+		sca_epoch_new (&epoch, _sca_check_get_jd (i));
+		sca_star_matrix_new (&matrix, &epoch);
+
+		for (k = 0; k < SCA_CHECK_STARS; ++k) {
+			_sca_check_new_star (&star, k);
+			_sca_check_new_star (&ref, k);
+			sca_star_update_matrix (&star, &matrix);
+			sca_star_update_ctx (&ref, &epoch);
+			_sca_check_add_separation (stats, star.ra, star.dec, ref.ra, ref.dec);
+		}
+	}
+}
+
+static void
+_sca_check_star_cached (SCACheckStats *stats, double param)
+{
+	SCAStarMatrix	matrix;
+	SCAEpoch	epoch;
+	SCAStarCached	star;
+	SCAStar		ref;
+	size_t		i, k;
+
+	(void) param;
+
+	/* Barnard's Star checks both the cached vectors and the fallback far from J2000 */
+	for (i = 0; i < SCA_CHECK_POINTS; i += 4) {
+		sca_epoch_new (&epoch, _sca_check_get_jd (i));
+		sca_star_matrix_new (&matrix, &epoch);
+
+		for (k = 0; k < SCA_CHECK_STARS; ++k) {
+			_sca_check_new_star_cached (&star, k);
+			_sca_check_new_star (&ref, k);
+			sca_star_cached_update_jd (&star, _sca_check_get_jd (i));
+			sca_star_update_jd (&ref, _sca_check_get_jd (i));
+			_sca_check_add_separation (stats, star.star.ra, star.star.dec, ref.ra, ref.dec);
+
+			sca_star_cached_update_matrix (&star, &matrix);
+			sca_star_update_matrix (&ref, &matrix);
+			_sca_check_add_separation (stats, star.star.ra, star.star.dec, ref.ra, ref.dec);
+		}
+	}
+}
+
+/* Sites along a spiral over the globe */
+static void
+_sca_check_get_site (size_t i, SCAGeoLocation *loc)
+{
+	loc->longitude	= -180.0 + fmod (i * 137.508, 360.0);
+	loc->latitude	= -89.0 + fmod (i * 7.31, 178.0);
+}
+
+static void
+_sca_check_local_many (SCACheckStats *stats, double param)
+{
+	SCAEpoch	epoch;
+	SCAGeoLocation	loc;
+	SCAMoon		moon;
+	SCAAngle	lons[SCA_BENCH_BATCH], lats[SCA_BENCH_BATCH];
+	SCAAngle	A[SCA_BENCH_BATCH], h[SCA_BENCH_BATCH], ref_A, ref_h;
+	size_t		i, k;
+
+	(void) param;
+
+	for (i = 0; i < SCA_CHECK_POINTS; i += 16) {
+		sca_epoch_new (&epoch, _sca_check_get_jd (i));
+		sca_moon_update_ctx (&moon, &epoch);
+
+		for (k = 0; k < SCA_BENCH_BATCH; ++k) {
+			_sca_check_get_site (i + k, &loc);
+			lons[k] = loc.longitude;
+			lats[k] = loc.latitude;
+		}
+
+		/* Stars without parallax, the Moon with it */
+		sca_coordinates_equatorial_to_local_many (&epoch, moon.ra, moon.dec, 0.0, lons, lats, SCA_BENCH_BATCH, A, h);
+
+		for (k = 0; k < SCA_BENCH_BATCH; ++k) {
+			loc.longitude	= lons[k];
+			loc.latitude	= lats[k];
+
+			sca_coordinates_equatorial_to_local_ctx (&epoch, &loc, moon.ra, moon.dec, &ref_A, &ref_h);
+			_sca_check_add_separation (stats, A[k], h[k], ref_A, ref_h);
+		}
+
+		sca_moon_get_local_coordinates_many (&moon, &epoch, lons, lats, SCA_BENCH_BATCH, A, h);
+
+		for (k = 0; k < SCA_BENCH_BATCH; ++k) {
+			loc.longitude	= lons[k];
+			loc.latitude	= lats[k];
+
+			sca_moon_get_local_coordinates_ctx (&moon, &epoch, &loc, &ref_A, &ref_h);
+			_sca_check_add_separation (stats, A[k], h[k], ref_A, ref_h);
+		}
+	}
+}
+
+/**
+ * Reference local coordinates, written independently of scacoordinates.c and
+ * scaearth.c: the object is turned into a vector in the hour angle frame,
+ * the observer's geocentric vector (Meeus 11.2, via the reduced latitude) is
+ * subtracted for the parallax and the result is rotated to the horizon.
+ * Distance @a dst is in AUs, 0 for no parallax. The horizontal parallax is
+ * 8.794" / @a dst, the same as used by the library.
+ */
+static void
+_sca_check_get_local (double jd, const SCAGeoLocation *loc, SCAAngle ra, SCAAngle dec, double dst, SCAAngle *A, SCAAngle *h)
+{
+	SCAAngle	theta0;
+	double		H, d, lat, u, D, x, y, z, xs, zs;
+
+	sca_jd_get_sidereal_time (jd, &theta0);
+
+	H	= (theta0 - loc->longitude - ra) * SCA_CHECK_DEG_TO_RAD;
+	d	= dec * SCA_CHECK_DEG_TO_RAD;
+	lat	= loc->latitude * SCA_CHECK_DEG_TO_RAD;
+
+	x = cos (d) * cos (H);
+	y = cos (d) * sin (H);
+	z = sin (d);
+
+	if (dst > 0.0) {
+		/* Distance in the Earth's equatorial radii */
+		D = 1.0 / sin (8.794 / SCA_CHECK_ARCSEC / dst * SCA_CHECK_DEG_TO_RAD);
+		u = atan (0.99664719 * tan (lat));
+
+		x = D * x - cos (u);
+		y = D * y;
+		z = D * z - 0.99664719 * sin (u);
+	}
+
+	/* South and zenith components, azimuth is measured westward from the south */
+	xs = x * sin (lat) - z * cos (lat);
+	zs = x * cos (lat) + z * sin (lat);
+
+	*A = atan2 (y, xs) / SCA_CHECK_DEG_TO_RAD;
+	*h = atan2 (zs, sqrt (xs * xs + y * y)) / SCA_CHECK_DEG_TO_RAD;
+}
+
+static void
+_sca_check_local_observer (SCACheckStats *stats, double param)
+{
+	SCAEpoch	epoch;
+	SCAGeoLocation	loc;
+	SCAObserver	obs;
+	SCAMoon		moon;
+	SCAAngle	A, h, ref_A, ref_h;
+	size_t		i;
+
+	(void) param;
+
+	for (i = 0; i < SCA_CHECK_POINTS; ++i) {
+		sca_epoch_new (&epoch, _sca_check_get_jd (i));
+		sca_moon_update_ctx (&moon, &epoch);
+
+		_sca_check_get_site (i, &loc);
+		sca_observer_new (&obs, &loc, 0.0);
+
+		_sca_check_get_local (epoch.jd, &loc, moon.ra, moon.dec, moon.dst, &ref_A, &ref_h);
+
+		sca_moon_get_local_coordinates_observer (&moon, &epoch, &obs, &A, &h);
+		_sca_check_add_separation (stats, A, h, ref_A, ref_h);
+
+		sca_moon_get_local_coordinates (&moon, &loc, &A, &h);
+		_sca_check_add_separation (stats, A, h, ref_A, ref_h);
+
+		_sca_check_get_local (epoch.jd, &loc, moon.ra, moon.dec, 0.0, &ref_A, &ref_h);
+
+		sca_coordinates_equatorial_to_local_observer (&epoch, &obs, moon.ra, moon.dec, &A, &h);
+		_sca_check_add_separation (stats, A, h, ref_A, ref_h);
+
+		sca_coordinates_equatorial_to_local (epoch.jd, &loc, moon.ra, moon.dec, &A, &h);
+		_sca_check_add_separation (stats, A, h, ref_A, ref_h);
+	}
+}
+
+/* Calendar checks sweep every day from January 1, -4712 to December 31, 9999 */
+#define SCA_CHECK_CALENDAR_DAYS	5373485
+
+/**
+ * Compares the batch calendar conversions against the scalar ones, and the
+ * day of the year and the week day against round trips. Differences are in
+ * days, the results must match exactly.
+ */
+static void
+_sca_check_jd_calendar (SCACheckStats *stats, double param)
+{
+	double		jds[SCA_BENCH_BATCH], days[SCA_BENCH_BATCH], back[SCA_BENCH_BATCH];
+	int		years[SCA_BENCH_BATCH], nums[SCA_BENCH_BATCH];
+	SCAMonth	months[SCA_BENCH_BATCH];
+	SCAWeekDay	weekdays[SCA_BENCH_BATCH], weekday;
+	SCADate		date;
+	double		midnight;
+	size_t		i, k, count;
+
+	(void) param;
+
+	for (i = 0; i < SCA_CHECK_CALENDAR_DAYS; i += count) {
+		count = (SCA_CHECK_CALENDAR_DAYS - i < SCA_BENCH_BATCH) ? SCA_CHECK_CALENDAR_DAYS - i : SCA_BENCH_BATCH;
+
+		/* Day i starts at JD i - 0.5, JD 0.0 is the noon of January 1, -4712 */
+		for (k = 0; k < count; ++k)
+			jds[k] = (double) (i + k) + 0.125 * ((i + k) % 4);
+
+		sca_jd_to_calendar_date_many (jds, count, years, months, days);
+		sca_jd_from_calendar_date_many (years, months, days, count, back);
+		sca_jd_get_day_of_year_many (jds, count, nums);
+		sca_jd_get_weekday_many (jds, count, weekdays);
+
+		for (k = 0; k < count; ++k) {
+			midnight = (double) (i + k) - 0.5;
+
+			sca_jd_to_calendar_date (jds[k], &date);
+			_sca_check_add (stats, years[k] - date.year);
+			_sca_check_add (stats, (double) months[k] - (double) date.month);
+			_sca_check_add (stats, days[k] - date.day);
+
+			_sca_check_add (stats, back[k] - sca_jd_from_calendar_date (&date));
+			_sca_check_add (stats, back[k] - jds[k]);
+
+			_sca_check_add (stats, nums[k] - sca_jd_get_day_of_year (jds[k]));
+			_sca_check_add (stats, sca_jd_from_day_of_year (years[k], nums[k]) - midnight);
+
+			/* JD 0.0 is Monday */
+			sca_jd_get_weekday (jds[k], &weekday);
+			_sca_check_add (stats, (double) weekdays[k] - (double) weekday);
+			_sca_check_add (stats, (double) weekdays[k] - (double) ((i + k + 1) % 7));
+		}
+	}
+}
+
+/* Meeus, Astronomical Algorithms, 2nd ed., example 12.a */
+static void
+_sca_check_meeus_sidereal (SCACheckStats *stats, double param)
+{
+	SCAAngle	sidereal;
+
+	(void) param;
+
+	sca_jd_get_sidereal_time (2446895.5, &sidereal);
+	_sca_check_add (stats, remainder (sidereal - sca_angle_from_hours (13, 10, 46, 135.1), 360.0) * SCA_CHECK_ARCSEC);
+}
+
+/* Example 13.b: Venus at the U.S. Naval Observatory */
+static void
+_sca_check_meeus_local (SCACheckStats *stats, double param)
+{
+	SCAGeoLocation	loc;
+	SCAAngle	A, h;
+
+	(void) param;
+
+	loc.longitude	= sca_angle_from_degrees (77, 3, 56, 0.0);
+	loc.latitude	= sca_angle_from_degrees (38, 55, 17, 0.0);
+
+	sca_coordinates_equatorial_to_local (2446896.30625, &loc,
+					     sca_angle_from_hours (23, 9, 16, 641.0),
+					     -sca_angle_from_degrees (6, 43, 11, 610.0),
+					     &A, &h);
+	_sca_check_add_separation (stats, A, h, 68.0337, 15.1249);
+}
+
+/* Example 22.a: nutation in longitude and in obliquity */
+static void
+_sca_check_meeus_nutation (SCACheckStats *stats, double param)
+{
+	SCAAngle	nut, obl;
+
+	(void) param;
+
+	sca_earth_get_nutation (2446895.5, &nut, &obl);
+	_sca_check_add (stats, nut * SCA_CHECK_ARCSEC + 3.788);
+	_sca_check_add (stats, obl * SCA_CHECK_ARCSEC - 9.443);
+}
+
+/* Example 23.a: apparent place of Theta Persei */
+static void
+_sca_check_meeus_star (SCACheckStats *stats, double param)
+{
+	SCAStar	star;
+
+	(void) param;
+
+	sca_star_new (&star,
+		      sca_angle_from_hours (2, 44, 11, 986.0),
+		      sca_angle_from_degrees (49, 13, 42, 480.0),
+		      sca_angle_from_degrees (0, 0, 0, 513.75),
+		      -sca_angle_from_degrees (0, 0, 0, 89.5));
+	sca_star_update_jd (&star, 2462088.69);
+	_sca_check_add_separation (stats, star.ra, star.dec,
+				   sca_angle_from_hours (2, 46, 14, 390.0),
+				   sca_angle_from_degrees (49, 21, 7, 450.0));
+}
+
+/* Example 25.b: apparent place of the Sun using VSOP87 */
+static void
+_sca_check_meeus_sun (SCACheckStats *stats, double param)
+{
+	SCASun	sun;
+
+	(void) param;
+
+	sca_sun_update_jd (&sun, 2448908.5);
+	_sca_check_add_separation (stats, sun.ra, sun.dec,
+				   sca_angle_from_hours (13, 13, 30, 749.0),
+				   -sca_angle_from_degrees (7, 47, 1, 740.0));
+}
+
+/* Example 32.a: heliocentric position of Venus */
+static void
+_sca_check_meeus_venus (SCACheckStats *stats, double param)
+{
+	SCAAngle	lon, lat;
+	double		dst;
+
+	(void) param;
+
+	if (sca_planet_data_get (SCA_PLANET_VENUS, 2448976.5, &lon, &lat, &dst) != 0)
+		return;
+
+	_sca_check_add_separation (stats, lon, lat, 26.11428, -2.62070);
+	_sca_check_add (stats, (dst - 0.724603) / 0.724603 / SCA_CHECK_DEG_TO_RAD * SCA_CHECK_ARCSEC);
+}
+
+/*
+ * Example 47.a: geometric position of the Moon, taken from the time stepper
+ * which returns it before nutation
+ */
+static void
+_sca_check_meeus_moon (SCACheckStats *stats, double param)
+{
+	SCATimeStepper	stepper;
+	SCAAngle	lon, lat;
+
+	(void) param;
+
+	sca_time_stepper_new (&stepper, 2448724.5, 1.0);
+	sca_time_stepper_add (&stepper, SCA_EPHEMERIS_MOON);
+	sca_time_stepper_get (&stepper, SCA_EPHEMERIS_MOON, &lon, &lat, NULL);
+	sca_time_stepper_free (&stepper);
+
+	_sca_check_add_separation (stats, lon, lat, 133.162655, -3.229126);
+}
+
+/*
+ * Example 47.a through sca_moon_update_jd(). The Moon's place is referred to
+ * the true equator without the nutation in longitude, so it's turned back to
+ * the ecliptic and compared with the geometric position and the distance.
+ */
+static void
+_sca_check_meeus_moon_jd (SCACheckStats *stats, double param)
+{
+	SCAMoon		moon;
+	SCAAngle	lon, lat;
+	double		dst;
+
+	(void) param;
+
+	sca_moon_update_jd (&moon, 2448724.5);
+	sca_coordinates_equatorial_to_ecliptic (moon.jd, moon.ra, moon.dec, &lon, &lat);
+	_sca_check_add_separation (stats, lon, lat, 133.162655, -3.229126);
+
+	/* Distance error is relative, the same as for the accuracy tiers */
+	dst = moon.dst * SCA_AU;
+	_sca_check_add (stats, (dst - 368409.7) / 368409.7 / SCA_CHECK_DEG_TO_RAD * SCA_CHECK_ARCSEC);
+}
+
+/* Points of the math kernels sweep */
+#define SCA_CHECK_MATH_POINTS	(1 << 20)
+
+/**
+ * Compares the kernels of scafastmath.h against libm, @a param selects the
+ * kernel: 0 for Sine and Cosine, 1 for Arctangent, 2 for Arcsine. Absolute
+ * errors are shown in arcseconds as if they were radians.
+ */
+static void
+_sca_check_math (SCACheckStats *stats, double param)
+{
+	const double	rad_to_arcsec = SCA_CHECK_ARCSEC / SCA_CHECK_DEG_TO_RAD;
+	double		u, x, s, c;
+	size_t		i;
+
+	for (i = 0; i < SCA_CHECK_MATH_POINTS; ++i) {
+		/* Uniform within [-1, 1] */
+		u = 2.0 * i / (SCA_CHECK_MATH_POINTS - 1) - 1.0;
+
+		switch ((int) param) {
+		case 0:
+			/* Both the full range and the range of reduced angles */
+			x = (i & 1) ? u * SCA_FAST_MAX_ARG : u * 2.0 * SCA_FAST_PI;
+			sca_fast_sincos (x, &s, &c);
+			_sca_check_add (stats, (s - sin (x)) * rad_to_arcsec);
+			_sca_check_add (stats, (c - cos (x)) * rad_to_arcsec);
+			break;
+		case 1:
+			x = u * SCA_FAST_PI;
+			s = sin (x) * (1.0 + (i % 7));
+			c = cos (x) * (1.0 + (i % 7));
+			_sca_check_add (stats, (sca_fast_atan2 (s, c) - atan2 (s, c)) * rad_to_arcsec);
+			break;
+		default:
+			_sca_check_add (stats, (sca_fast_asin (u) - asin (u)) * rad_to_arcsec);
+			break;
+		}
+	}
+}
+
+/* Budgets follow the accuracy documented for each routine */
+static const SCACheck checks[] = {
+	{"planet_data_many",		_sca_check_planet_data_many,	0.0,	0.001},
+	{"planet_data_tier_0.1",	_sca_check_planet_data_tier,	0.1,	0.1},
+	{"planet_data_tier_1",		_sca_check_planet_data_tier,	1.0,	1.0},
+	{"planet_data_tier_10",		_sca_check_planet_data_tier,	10.0,	10.0},
+	{"planet_data_tier_60",		_sca_check_planet_data_tier,	60.0,	60.0},
+	{"sun_series",			_sca_check_sun_series,		0.0,	0.001},
+	{"time_stepper",		_sca_check_stepper,		0.0,	0.001},
+	{"ephemeris_cache",		_sca_check_cache,		0.0,	0.001},
+	{"star_catalog",		_sca_check_star_catalog,	0.0,	0.001},
+	{"star_matrix",			_sca_check_star_matrix,		0.0,	1.0},
+	{"star_cached",			_sca_check_star_cached,		0.0,	0.001},
+	{"local_many",			_sca_check_local_many,		0.0,	1e-9 * SCA_CHECK_ARCSEC},
+	{"local_observer",		_sca_check_local_observer,	0.0,	0.001},
+	{"jd_calendar_many",		_sca_check_jd_calendar,		0.0,	0.0},
+	{"meeus_12a_sidereal",		_sca_check_meeus_sidereal,	0.0,	1.0},
+	{"meeus_13b_local",		_sca_check_meeus_local,		0.0,	1.0},
+	{"meeus_22a_nutation",		_sca_check_meeus_nutation,	0.0,	1.0},
+	{"meeus_23a_star",		_sca_check_meeus_star,		0.0,	1.0},
+	{"meeus_25b_sun",		_sca_check_meeus_sun,		0.0,	1.0},
+	{"meeus_32a_venus",		_sca_check_meeus_venus,		0.0,	1.0},
+	{"meeus_47a_moon",		_sca_check_meeus_moon,		0.0,	1.0},
+	{"meeus_47a_moon_jd",		_sca_check_meeus_moon_jd,	0.0,	1.0},
+	{"math_sincos",			_sca_check_math,		0.0,	3e-16 * SCA_CHECK_ARCSEC / SCA_CHECK_DEG_TO_RAD},
+	{"math_atan2",			_sca_check_math,		1.0,	1e-14 * SCA_CHECK_ARCSEC / SCA_CHECK_DEG_TO_RAD},
+	{"math_asin",			_sca_check_math,		2.0,	1e-14 * SCA_CHECK_ARCSEC / SCA_CHECK_DEG_TO_RAD}
+};
+
+static void
+_sca_bench_run_samples (void *data, size_t begin, size_t end)
+{
+	SCABenchJob	*job;
+	double		start;
+	size_t		k;
+
+	job = (SCABenchJob *) data;
+
+	for (k = begin; k < end; ++k) {
+		start		= _sca_bench_get_time ();
+		job->sinks[k]	= job->func (job->iterations);
+		job->times[k]	= (_sca_bench_get_time () - start) * 1e9 / job->iterations;
+	}
+}
+
+static int
+_sca_bench_compare (const void *a, const void *b)
+{
+	double	x, y;
+
+	x = *(const double *) a;
+	y = *(const double *) b;
+
+	return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of the sorted values */
+static double
+_sca_bench_get_percentile (const double *values, size_t n, double p)
+{
+	size_t	rank;
+
+	rank = (size_t) (p / 100.0 * n + 0.999999);
+
+	return values[(rank > 0 ? rank : 1) - 1];
+}
+
+/**
+ * Runs @a samples samples of the benchmark in every thread of the pool.
+ * Returns 0 in case of success, -1 otherwise.
+ */
+static int
+_sca_bench_run (const SCABench	*bench,
+		SCAThreadPool	*pool,
+		size_t		samples,
+		size_t		iterations,
+		SCABenchResult	*result)
+{
+	SCABenchJob	job;
+	double		start, elapsed, sum;
+	size_t		n, k;
+
+	result->threads	= sca_thread_pool_get_threads (pool);
+	n		= samples * (size_t) result->threads;
+
+	job.func	= bench->func;
+	job.iterations	= iterations;
+	job.times	= malloc (n * sizeof (double));
+	job.sinks	= malloc (n * sizeof (double));
+
+	if (job.times == NULL || job.sinks == NULL) {
+		free (job.times);
+		free (job.sinks);
+		return -1;
+	}
+
+	/* Warm up caches and lazily initialized kernels */
+	bench_sink += bench->func (iterations);
+
+	start	= _sca_bench_get_time ();
+	sca_thread_pool_run (pool, n, 1, _sca_bench_run_samples, &job);
+	elapsed	= _sca_bench_get_time () - start;
+
+	for (k = 0, sum = 0.0; k < n; ++k) {
+		bench_sink	+= job.sinks[k];
+		sum		+= job.times[k];
+	}
+
+	qsort (job.times, n, sizeof (double), _sca_bench_compare);
+
+	result->mean	= sum / n;
+	result->ops	= (double) n * iterations / elapsed;
+	result->p50	= _sca_bench_get_percentile (job.times, n, 50.0);
+	result->p90	= _sca_bench_get_percentile (job.times, n, 90.0);
+	result->p99	= _sca_bench_get_percentile (job.times, n, 99.0);
+
+	free (job.times);
+	free (job.sinks);
+
+	return 0;
+}
+
+/**
+ * Runs the accuracy check and prints its result.
+ * Returns 0 if the error is within the budget, -1 otherwise.
+ */
+static int
+_sca_check_run (const SCACheck *check, int json, int first)
+{
+	SCACheckStats	stats;
+	double		rms;
+	int		passed;
+
+	memset (&stats, 0, sizeof (stats));
+
+	check->func (&stats, check->param);
+
+	rms	= (stats.count > 0) ? sqrt (stats.sum_sq / stats.count) : 0.0;
+	passed	= (stats.count > 0 && stats.max <= check->budget);
+
+	if (json)
+		printf ("%s\n    {\"name\": \"%s\", \"samples\": %lu, \"max_arcsec\": %.3e, \"rms_arcsec\": %.3e, "
+			"\"budget_arcsec\": %.3e, \"passed\": %s}",
+			first ? "" : ",", check->name, (unsigned long) stats.count, stats.max, rms,
+			check->budget, passed ? "true" : "false");
+	else
+		printf ("%-28s %8lu %12.3e %12.3e %12.3e  %s\n",
+			check->name, (unsigned long) stats.count, stats.max, rms,
+			check->budget, passed ? "ok" : "FAILED");
+
+	return passed ? 0 : -1;
+}
+
+/**
+ * Prints counters of the stages which were used, as a JSON object member or
+ * as indented lines after the benchmark result.
+ */
+static void
+_sca_bench_print_stats (const SCAStats *stats, int json)
+{
+	const SCAStatsCounter	*counter;
+	double			per_call, hit_rate;
+	int			i, first;
+
+	if (json)
+		printf (", \"stages\": {");
+
+	for (i = 0, first = 1; i < SCA_STATS_STAGES; ++i) {
+		counter = &stats->stages[i];
+
+		if (counter->calls == 0 && counter->misses == 0)
+			continue;
+
+		per_call = (counter->calls > 0) ? (double) counter->cycles / counter->calls : 0.0;
+		hit_rate = (counter->hits + counter->misses > 0) ?
+			   100.0 * counter->hits / (counter->hits + counter->misses) : -1.0;
+
+		if (json) {
+			printf ("%s\"%s\": {\"calls\": %.0f, \"cycles_per_call\": %.1f",
+				first ? "" : ", ", sca_stats_get_stage_name ((SCAStatsStage) i),
+				(double) counter->calls, per_call);
+
+			if (hit_rate >= 0.0)
+				printf (", \"hit_rate\": %.2f", hit_rate);
+
+			printf ("}");
+		} else {
+			printf ("    %-26s %14.0f calls %10.1f cycles/call",
+				sca_stats_get_stage_name ((SCAStatsStage) i), (double) counter->calls, per_call);
+
+			if (hit_rate >= 0.0)
+				printf (" %6.2f%% hits", hit_rate);
+
+			printf ("\n");
+		}
+
+		first = 0;
+	}
+
+	if (json)
+		printf ("}");
+}
+
+static void
+_sca_bench_print (const char *name, const SCABenchResult *result, const SCAStats *stats, int json, int first)
+{
+	if (json) {
+		printf ("%s\n    {\"name\": \"%s\", \"threads\": %d, \"ns_per_op\": %.2f, \"ops_per_sec\": %.0f, "
+			"\"p50_ns\": %.2f, \"p90_ns\": %.2f, \"p99_ns\": %.2f",
+			first ? "" : ",", name, result->threads, result->mean, result->ops,
+			result->p50, result->p90, result->p99);
+
+		if (stats != NULL)
+			_sca_bench_print_stats (stats, json);
+
+		printf ("}");
+	} else {
+		printf ("%-28s %7d %10.1f %14.0f %10.1f %10.1f %10.1f\n",
+			name, result->threads, result->mean, result->ops,
+			result->p50, result->p90, result->p99);
+
+		if (stats != NULL)
+			_sca_bench_print_stats (stats, json);
+	}
+}
+
+static int
+_sca_bench_parse_count (const char *str, size_t *value)
+{
+	char	*end;
+	long	val;
+
+	val = strtol (str, &end, 10);
+
+	if (*str == '\0' || *end != '\0' || val < 1)
+		return -1;
+
+	*value = (size_t) val;
+
+	return 0;
+}
+
+static int
+_sca_bench_is_selected (int argc, char *argv[], int first_name, const char *name)
+{
+	int	i;
+
+	if (first_name >= argc)
+		return 1;
+
+	for (i = first_name; i < argc; ++i)
+		if (strcmp (argv[i], name) == 0)
+			return 1;
+
+	return 0;
+}
+
+int
+main (int argc, char *argv[])
+{
+	SCAThreadPool	*pools[2];
+	SCABenchResult	result;
+	SCAStats	stats;
+	size_t		samples, iterations, threads, i;
+	int		json, check, use_stats, failed, first, n_pools, p, arg;
+
+	samples		= SCA_BENCH_SAMPLES;
+	iterations	= SCA_BENCH_ITERATIONS;
+	threads		= 1;
+	json		= 0;
+	check		= 0;
+	use_stats	= 0;
+
+	for (arg = 1; arg < argc && strncmp (argv[arg], "--", 2) == 0; ++arg) {
+		if (strcmp (argv[arg], "--json") == 0)
+			json = 1;
+		else if (strcmp (argv[arg], "--check") == 0)
+			check = 1;
+		else if (strcmp (argv[arg], "--stats") == 0)
+			use_stats = 1;
+		else if (strcmp (argv[arg], "--threads") == 0 && arg + 1 < argc &&
+			 _sca_bench_parse_count (argv[arg + 1], &threads) == 0)
+			++arg;
+		else if (strcmp (argv[arg], "--samples") == 0 && arg + 1 < argc &&
+			 _sca_bench_parse_count (argv[arg + 1], &samples) == 0)
+			++arg;
+		else if (strcmp (argv[arg], "--iterations") == 0 && arg + 1 < argc &&
+			 _sca_bench_parse_count (argv[arg + 1], &iterations) == 0)
+			++arg;
+		else {
+			fprintf (stderr, "Usage: %s [--check] [--stats] [--threads N] [--samples N] [--iterations N] [--json] [NAME...]\n",
+				 argv[0]);
+			return 1;
+		}
+	}
+
+	if (check) {
+		if (json)
+			printf ("{\n  \"jd_begin\": %.1f,\n  \"jd_end\": %.1f,\n  \"results\": [",
+				SCA_CHECK_JD_BEGIN, SCA_CHECK_JD_END);
+		else
+			printf ("%-28s %8s %12s %12s %12s\n", "name", "samples", "max\"", "rms\"", "budget\"");
+
+		failed	= 0;
+		first	= 1;
+
+		for (i = 0; i < sizeof (checks) / sizeof (checks[0]); ++i) {
+			if (!_sca_bench_is_selected (argc, argv, arg, checks[i].name))
+				continue;
+
+			if (_sca_check_run (&checks[i], json, first) != 0)
+				failed = 1;
+
+			first = 0;
+		}
+
+		if (json)
+			printf ("\n  ]\n}\n");
+
+		return failed ? 1 : 0;
+	}
+
+	if (use_stats && !sca_stats_is_enabled ()) {
+		fprintf (stderr, "Library is built without SCA_ENABLE_STATS\n");
+		return 1;
+	}
+
+	/* Single-threaded run always goes first, so the results are comparable */
+	n_pools		= (threads > 1) ? 2 : 1;
+	pools[0]	= sca_thread_pool_new (1);
+	pools[1]	= (threads > 1) ? sca_thread_pool_new ((int) threads) : NULL;
+
+	if (pools[0] == NULL || (threads > 1 && pools[1] == NULL)) {
+		fprintf (stderr, "Failed to create thread pool\n");
+		sca_thread_pool_free (pools[0]);
+		sca_thread_pool_free (pools[1]);
+		return 1;
+	}
+
+	if (json)
+		printf ("{\n  \"samples\": %lu,\n  \"iterations\": %lu,\n  \"results\": [",
+			(unsigned long) samples, (unsigned long) iterations);
+	else
+		printf ("%-28s %7s %10s %14s %10s %10s %10s\n",
+			"name", "threads", "ns/op", "ops/s", "p50", "p90", "p99");
+
+	first = 1;
+
+	for (i = 0; i < sizeof (benches) / sizeof (benches[0]); ++i) {
+		if (!_sca_bench_is_selected (argc, argv, arg, benches[i].name))
+			continue;
+
+		for (p = 0; p < n_pools; ++p) {
+			if (use_stats)
+				sca_stats_reset ();
+
+			if (_sca_bench_run (&benches[i], pools[p], samples, iterations, &result) != 0) {
+				fprintf (stderr, "Failed to run %s\n", benches[i].name);
+				continue;
+			}
+
+			if (use_stats)
+				sca_stats_snapshot (&stats);
+
+			_sca_bench_print (benches[i].name, &result, use_stats ? &stats : NULL, json, first);
+			first = 0;
+		}
+	}
+
+	if (json)
+		printf ("\n  ]\n}\n");
+
+	sca_thread_pool_free (pools[0]);
+	sca_thread_pool_free (pools[1]);
+
+	return 0;
+}
@@ -25,6 +25,7 @@
 
 #include "scaangle.h"
 #include "scamisc.h"
+#include "scafastmath.h"
 
 void
 sca_angle_reduce (SCAAngle *angle)
@@ -222,7 +223,7 @@ sca_angle_get_sin (SCAAngle angle)
 {
 	sca_angle_reduce (&angle);
 
-	return sin (sca_angle_to_radians (angle));
+	return sca_math_sin (sca_angle_to_radians (angle));
 }
 
 double
@@ -230,7 +231,7 @@ sca_angle_get_cos (SCAAngle angle)
 {
 	sca_angle_reduce (&angle);
 
-	return cos (sca_angle_to_radians (angle));
+	return sca_math_cos (sca_angle_to_radians (angle));
 }
 
 void
@@ -238,16 +239,16 @@ sca_angle_get_sincos (SCAAngle		angle,
 		      double		*sin_out,
 		      double		*cos_out)
 {
-	double rads;
+	double	s, c;
 
 	sca_angle_reduce (&angle);
-	rads = sca_angle_to_radians (angle);
+	sca_math_sincos (sca_angle_to_radians (angle), &s, &c);
 
 	if (sin_out != NULL)
-		*sin_out = sin (rads);
+		*sin_out = s;
 
 	if (cos_out != NULL)
-		*cos_out = cos (rads);
+		*cos_out = c;
 }
 
 SCAAngle
@@ -18,6 +18,214 @@
 
 #include "scacoordinates.h"
 #include "scajulianday.h"
+#include "scafastmath.h"
+#include "scaprivate.h"
+
+/* Number of the sites processed at once when some of the outputs are not needed */
+#define SCA_COORDINATES_BLOCK		256
+/* Earth's flattering: 1/298.257, squared ratio of the polar and equatorial radii */
+#define SCA_COORDINATES_FLAT_RATIO2	((1.0 - 1.0 / 298.257) * (1.0 - 1.0 / 298.257))
+
+/** Values which depend only on the epoch and the object. */
+typedef struct _SCACoordinatesLocalTerms {
+	SCAAngle	theta;		/**< Sidereal time minus right ascension.	*/
+	double		sin_dec;	/**< Sine of the declination.			*/
+	double		cos_dec;	/**< Cosine of the declination.			*/
+	double		sin_pi;		/**< Sine of the horizontal parallax.		*/
+} SCACoordinatesLocalTerms;
+
+typedef void (*SCACoordinatesLocalKernel) (const SCACoordinatesLocalTerms	*terms,
+					   size_t				count,
+					   const SCAAngle			*longitudes,
+					   const SCAAngle			*latitudes,
+					   SCAAngle				*A,
+					   SCAAngle				*h);
+
+static void
+_sca_coordinates_equatorial_to_ecliptic (double sin_obl, double cos_obl, SCAAngle ra, SCAAngle dec, SCAAngle *lon, SCAAngle *lat)
+{
+	if (lon != NULL)
+		*lon = (atan2 (sca_angle_get_sin (ra) * cos_obl
+				+ tan (sca_angle_to_radians (dec)) * sin_obl,
+				sca_angle_get_cos (ra))) * SCA_ANGLE_RAD_TO_DEG;
+
+	if (lat != NULL)
+		*lat = (asin (sca_angle_get_sin (dec) * cos_obl
+			      - sca_angle_get_cos (dec) * sin_obl
+			      * sca_angle_get_sin (ra))) * SCA_ANGLE_RAD_TO_DEG;
+}
+
+static void
+_sca_coordinates_ecliptic_to_equatorial (double sin_obl, double cos_obl, SCAAngle lon, SCAAngle lat, SCAAngle *ra, SCAAngle *dec)
+{
+	if (ra != NULL)
+		*ra = (atan2 (sca_angle_get_sin (lon) * cos_obl
+			     - tan (sca_angle_to_radians (lat)) * sin_obl,
+			     sca_angle_get_cos (lon))) * SCA_ANGLE_RAD_TO_DEG;
+
+	if (dec != NULL)
+		*dec = (asin (sca_angle_get_sin (lat) * cos_obl
+			     + sca_angle_get_cos (lat) * sin_obl
+			     * sca_angle_get_sin (lon))) * SCA_ANGLE_RAD_TO_DEG;
+}
+
+static void
+_sca_coordinates_equatorial_to_local (SCAAngle	theta0,
+				      SCAAngle	longitude,
+				      double	sin_lat,
+				      double	cos_lat,
+				      SCAAngle	ra,
+				      SCAAngle	dec,
+				      SCAAngle	*A,
+				      SCAAngle	*h)
+{
+	SCAAngle	H;
+
+	H = theta0 - longitude - ra;
+
+	if (A != NULL)
+		*A = atan2 (sca_angle_get_sin (H),
+			    sca_angle_get_cos (H) * sin_lat
+			    - tan (sca_angle_to_radians (dec))
+			    * cos_lat) * SCA_ANGLE_RAD_TO_DEG;
+
+	if (h != NULL)
+		*h = asin (sin_lat * sca_angle_get_sin (dec)
+			   + cos_lat * sca_angle_get_cos (dec)
+			   * sca_angle_get_cos (H)) * SCA_ANGLE_RAD_TO_DEG;
+}
+
+/**
+ * @brief Calculates local coordinates of the object for the array of sites.
+ * @param terms Epoch and object dependent terms.
+ * @param count Number of the sites.
+ * @param longitudes Longitudes of the sites.
+ * @param latitudes Latitudes of the sites.
+ * @param[out] A Output azimuths.
+ * @param[out] h Output altitudes.
+ * @since 0.0.2
+ *
+ * This is the same parallax correction as in scaearth.c followed by the
+ * transformation above, but written without calls and branches. Geocentric
+ * location of the site is obtained from the Sine and Cosine of the latitude,
+ * and the corrected hour angle and declination are never turned into angles:
+ * their Sines and Cosines follow from the parallax vectors directly.
+ */
+SCA_ALWAYS_INLINE void
+_sca_coordinates_local_kernel (const SCACoordinatesLocalTerms	*terms,
+			       size_t				count,
+			       const SCAAngle	* SCA_RESTRICT	longitudes,
+			       const SCAAngle	* SCA_RESTRICT	latitudes,
+			       SCAAngle		* SCA_RESTRICT	A,
+			       SCAAngle		* SCA_RESTRICT	h)
+{
+	double	theta, sin_dec, cos_dec, sin_pi;
+	size_t	i;
+
+	theta	= terms->theta;
+	sin_dec	= terms->sin_dec;
+	cos_dec	= terms->cos_dec;
+	sin_pi	= terms->sin_pi;
+
+	for (i = 0; i < count; ++i) {
+		double	sin_lat, cos_lat, sin_H, cos_H, cos_2lat;
+		double	p, ys, inv, rho_sin, rho_cos;
+		double	x, y, r, sin_dra, cos_dra, yd, sin_d, cos_d;
+		double	sin_Ht, cos_Ht, z;
+
+		sca_fast_sincos (latitudes[i] * SCA_ANGLE_DEG_TO_RAD, &sin_lat, &cos_lat);
+		sca_fast_sincos ((theta - longitudes[i]) * SCA_ANGLE_DEG_TO_RAD, &sin_H, &cos_H);
+
+		/* 1. Geocentric location, Cos (4 * lat) = 2 * Cos^2 (2 * lat) - 1 */
+		cos_2lat = 1.0 - 2.0 * sin_lat * sin_lat;
+		p = 0.9983271 + 0.0016764 * cos_2lat
+			      - 0.0000035 * (2.0 * cos_2lat * cos_2lat - 1.0);
+
+		ys	= SCA_COORDINATES_FLAT_RATIO2 * sin_lat;
+		inv	= p / sqrt (ys * ys + cos_lat * cos_lat);
+		rho_sin	= ys * inv;
+		rho_cos	= cos_lat * inv;
+
+		/* 2. Parallax: x is positive unless the object is at the pole */
+		x	= cos_dec - rho_cos * sin_pi * cos_H;
+		y	= (-rho_cos) * sin_pi * sin_H;
+		r	= 1.0 / sqrt (x * x + y * y);
+		sin_dra	= y * r;
+		cos_dra	= x * r;
+
+		yd	= (sin_dec - rho_sin * sin_pi) * cos_dra;
+		r	= 1.0 / sqrt (x * x + yd * yd);
+		sin_d	= yd * r;
+		cos_d	= x * r;
+
+		/* Right ascension grows by the parallax, the hour angle decreases */
+		sin_Ht	= sin_H * cos_dra - cos_H * sin_dra;
+		cos_Ht	= cos_H * cos_dra + sin_H * sin_dra;
+
+		/* 3. Local coordinates, azimuth arguments are multiplied by Cos (dec) */
+		z = sin_lat * sin_d + cos_lat * cos_d * cos_Ht;
+		z = (z > 1.0) ? 1.0 : ((z < -1.0) ? -1.0 : z);
+
+		A[i] = sca_fast_atan2 (sin_Ht * cos_d, cos_Ht * sin_lat * cos_d - sin_d * cos_lat) * SCA_ANGLE_RAD_TO_DEG;
+		h[i] = sca_fast_asin (z) * SCA_ANGLE_RAD_TO_DEG;
+	}
+}
+
+static void
+_sca_coordinates_local_kernel_generic (const SCACoordinatesLocalTerms	*terms,
+				       size_t				count,
+				       const SCAAngle			*longitudes,
+				       const SCAAngle			*latitudes,
+				       SCAAngle				*A,
+				       SCAAngle				*h)
+{
+	_sca_coordinates_local_kernel (terms, count, longitudes, latitudes, A, h);
+}
+
+#ifdef HAVE_CPU_DISPATCH
+__attribute__ ((target ("avx2,fma"))) static void
+_sca_coordinates_local_kernel_avx2 (const SCACoordinatesLocalTerms	*terms,
+				    size_t				count,
+				    const SCAAngle			*longitudes,
+				    const SCAAngle			*latitudes,
+				    SCAAngle				*A,
+				    SCAAngle				*h)
+{
+	_sca_coordinates_local_kernel (terms, count, longitudes, latitudes, A, h);
+}
+
+__attribute__ ((target ("avx512f"))) static void
+_sca_coordinates_local_kernel_avx512 (const SCACoordinatesLocalTerms	*terms,
+				      size_t				count,
+				      const SCAAngle			*longitudes,
+				      const SCAAngle			*latitudes,
+				      SCAAngle				*A,
+				      SCAAngle				*h)
+{
+	_sca_coordinates_local_kernel (terms, count, longitudes, latitudes, A, h);
+}
+#endif
+
+/**
+ * @brief Selects the best kernel for the current CPU.
+ * @return Kernel to use.
+ * @since 0.0.2
+ *
+ * The choice is not cached: __builtin_cpu_supports() only reads the CPU
+ * model filled in by the runtime at startup, so concurrent calls don't race.
+ */
+static SCACoordinatesLocalKernel
+_sca_coordinates_local_get_kernel (void)
+{
+#ifdef HAVE_CPU_DISPATCH
+	if (__builtin_cpu_supports ("avx512f"))
+		return _sca_coordinates_local_kernel_avx512;
+	else if (__builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma"))
+		return _sca_coordinates_local_kernel_avx2;
+#endif
+
+	return _sca_coordinates_local_kernel_generic;
+}
 
 int
 sca_coordinates_equatorial_to_ecliptic (double jd, SCAAngle ra, SCAAngle dec, SCAAngle *lon, SCAAngle *lat)
@@ -31,15 +239,18 @@ sca_coordinates_equatorial_to_ecliptic (double jd, SCAAngle ra, SCAAngle dec, SC
 	sca_earth_get_ecliptic_obliquity (jd, &obl);
 	sca_angle_get_sincos (obl, &sin_obl, &cos_obl);
 
-	if (lon != NULL)
-		*lon = (atan2 (sca_angle_get_sin (ra) * cos_obl
-				+ tan (sca_angle_to_radians (dec)) * sin_obl,
-				sca_angle_get_cos (ra))) * SCA_ANGLE_RAD_TO_DEG;
+	_sca_coordinates_equatorial_to_ecliptic (sin_obl, cos_obl, ra, dec, lon, lat);
 
-	if (lat != NULL)
-		*lat = (asin (sca_angle_get_sin (dec) * cos_obl
-			      - sca_angle_get_cos (dec) * sin_obl
-			      * sca_angle_get_sin (ra))) * SCA_ANGLE_RAD_TO_DEG;
+	return 0;
+}
+
+int
+sca_coordinates_equatorial_to_ecliptic_ctx (const SCAEpoch *epoch, SCAAngle ra, SCAAngle dec, SCAAngle *lon, SCAAngle *lat)
+{
+	if (epoch == NULL)
+		return -1;
+
+	_sca_coordinates_equatorial_to_ecliptic (epoch->sin_obl, epoch->cos_obl, ra, dec, lon, lat);
 
 	return 0;
 }
@@ -49,48 +260,124 @@ sca_coordinates_ecliptic_to_equatorial (double jd, SCAAngle lon, SCAAngle lat, S
 {
 	SCAAngle obl;
 	double	sin_obl, cos_obl;
+	SCA_STATS_DECLARE (ticks)
 
 	if (jd < 0)
 		return -1;
 
+	SCA_STATS_BEGIN (ticks);
+
 	sca_earth_get_ecliptic_obliquity (jd, &obl);
 	sca_angle_get_sincos (obl, &sin_obl, &cos_obl);
 
-	if (ra != NULL)
-		*ra = (atan2 (sca_angle_get_sin (lon) * cos_obl
-			     - tan (sca_angle_to_radians (lat)) * sin_obl,
-			     sca_angle_get_cos (lon))) * SCA_ANGLE_RAD_TO_DEG;
+	_sca_coordinates_ecliptic_to_equatorial (sin_obl, cos_obl, lon, lat, ra, dec);
 
-	if (dec != NULL)
-		*dec = (asin (sca_angle_get_sin (lat) * cos_obl
-			     + sca_angle_get_cos (lat) * sin_obl
-			     * sca_angle_get_sin (lon))) * SCA_ANGLE_RAD_TO_DEG;
+	SCA_STATS_END (SCA_STATS_ECLIPTIC_TO_EQUATORIAL, ticks);
 
 	return 0;
 }
 
 int
-sca_coordinates_equatorial_to_local (double jd, SCAGeoLocation *loc, SCAAngle ra, SCAAngle dec, SCAAngle *A, SCAAngle *h)
+sca_coordinates_ecliptic_to_equatorial_ctx (const SCAEpoch *epoch, SCAAngle lon, SCAAngle lat, SCAAngle *ra, SCAAngle *dec)
+{
+	if (epoch == NULL)
+		return -1;
+
+	_sca_coordinates_ecliptic_to_equatorial (epoch->sin_obl, epoch->cos_obl, lon, lat, ra, dec);
+
+	return 0;
+}
+
+int
+sca_coordinates_equatorial_to_local (double jd, const SCAGeoLocation *loc, SCAAngle ra, SCAAngle dec, SCAAngle *A, SCAAngle *h)
 {
 	SCAAngle	theta0;
-	SCAAngle	H;
 
 	if (jd < 0 || loc == NULL)
 		return -1;
 	
 	sca_jd_get_sidereal_time (jd, &theta0);
-	H = theta0 - loc->longitude - ra;
+	_sca_coordinates_equatorial_to_local (theta0,
+					      loc->longitude,
+					      sca_angle_get_sin (loc->latitude),
+					      sca_angle_get_cos (loc->latitude),
+					      ra, dec, A, h);
 
-	if (A != NULL)
-		*A = atan2 (sca_angle_get_sin (H),
-			    sca_angle_get_cos (H) * sca_angle_get_sin (loc->latitude)
-			    - tan (sca_angle_to_radians (dec))
-			    * sca_angle_get_cos (loc->latitude)) * SCA_ANGLE_RAD_TO_DEG;
+	return 0;
+}
 
-	if (h != NULL)
-		*h = asin (sca_angle_get_sin (loc->latitude) * sca_angle_get_sin (dec)
-			   + sca_angle_get_cos (loc->latitude) * sca_angle_get_cos (dec)
-			   * sca_angle_get_cos (H)) * SCA_ANGLE_RAD_TO_DEG;
+int
+sca_coordinates_equatorial_to_local_ctx (const SCAEpoch *epoch, const SCAGeoLocation *loc, SCAAngle ra, SCAAngle dec, SCAAngle *A, SCAAngle *h)
+{
+	if (epoch == NULL || loc == NULL)
+		return -1;
+
+	_sca_coordinates_equatorial_to_local (epoch->sidereal,
+					      loc->longitude,
+					      sca_angle_get_sin (loc->latitude),
+					      sca_angle_get_cos (loc->latitude),
+					      ra, dec, A, h);
+
+	return 0;
+}
+
+int
+sca_coordinates_equatorial_to_local_observer (const SCAEpoch *epoch, const SCAObserver *obs, SCAAngle ra, SCAAngle dec, SCAAngle *A, SCAAngle *h)
+{
+	if (epoch == NULL || obs == NULL)
+		return -1;
+
+	_sca_coordinates_equatorial_to_local (epoch->sidereal, obs->longitude, obs->sin_lat, obs->cos_lat, ra, dec, A, h);
+
+	return 0;
+}
+
+int
+sca_coordinates_equatorial_to_local_many (const SCAEpoch	*epoch,
+					  SCAAngle		ra,
+					  SCAAngle		dec,
+					  double		dst,
+					  const SCAAngle	*longitudes,
+					  const SCAAngle	*latitudes,
+					  size_t		n,
+					  SCAAngle		*A,
+					  SCAAngle		*h)
+{
+	SCACoordinatesLocalKernel	kernel;
+	SCACoordinatesLocalTerms	terms;
+	SCAAngle			A_buf[SCA_COORDINATES_BLOCK];
+	SCAAngle			h_buf[SCA_COORDINATES_BLOCK];
+	size_t				i, count;
+
+	if (epoch == NULL || ((longitudes == NULL || latitudes == NULL) && n > 0))
+		return -1;
+
+	terms.theta	= epoch->sidereal - ra;
+	terms.sin_pi	= 0.0;
+
+	sca_angle_get_sincos (dec, &terms.sin_dec, &terms.cos_dec);
+
+	/* Equatorial horizontal parallax, the same as in scaearth.c */
+	if (dst > 0.0)
+		terms.sin_pi = sca_angle_get_sin (sca_angle_from_degrees (0, 0, 8, 794) / dst);
+
+	kernel = _sca_coordinates_local_get_kernel ();
+
+	if (A != NULL && h != NULL) {
+		kernel (&terms, n, longitudes, latitudes, A, h);
+		return 0;
+	}
+
+	for (i = 0; i < n; i += count) {
+		count = (n - i < SCA_COORDINATES_BLOCK) ? n - i : SCA_COORDINATES_BLOCK;
+
+		kernel (&terms,
+			count,
+			longitudes + i,
+			latitudes + i,
+			A != NULL ? A + i : A_buf,
+			h != NULL ? h + i : h_buf);
+	}
 
 	return 0;
 }
@@ -55,10 +55,12 @@
 #define __SCACOORDINATES_H__
 
 #include <math.h>
+#include <stddef.h>
 
 #include <scamacros.h>
 #include <scaangle.h>
 #include <scaearth.h>
+#include <scaepoch.h>
 
 SCA_BEGIN_DECLS
 
@@ -138,7 +140,177 @@ int sca_coordinates_ecliptic_to_equatorial	(double jd, SCAAngle lon, SCAAngle la
  * @since 0.0.1
  */
 #endif
-int sca_coordinates_equatorial_to_local		(double jd, SCAGeoLocation *loc, SCAAngle ra, SCAAngle dec, SCAAngle *A, SCAAngle *h);
+int sca_coordinates_equatorial_to_local		(double jd, const SCAGeoLocation *loc, SCAAngle ra, SCAAngle dec, SCAAngle *A, SCAAngle *h);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Преобразует экваториальные координаты в эклиптические, используя
+ * контекст расчётов.
+ * @param epoch Контекст расчётов на момент преобразования.
+ * @param ra Прямое восхождение в экваториальных координатах.
+ * @param dec Склонение в экваториальных координатах.
+ * @param[out] lon Эклиптическая долгота (от точки весеннего равноденствия) может быть NULL.
+ * @param[out] lat Эклиптическая широта (положительная на север от эклиптики, отрицательная на юг),
+ * может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Transforms equatorial coordinates to ecliptical using calculation
+ * context.
+ * @param epoch Calculation context for the transformation instance.
+ * @param ra Right ascension in equatorial coordinates.
+ * @param dec Declination in equatorial coordinates.
+ * @param[out] lon Ecliptical longitude (measured from vernal equinox), may be NULL.
+ * @param[out] lat Ecliptical latitude (positive north of ecliptic, negative south), may be NULL.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ */
+#endif
+int sca_coordinates_equatorial_to_ecliptic_ctx	(const SCAEpoch *epoch, SCAAngle ra, SCAAngle dec, SCAAngle *lon, SCAAngle *lat);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Преобразует эклиптические координаты в экваториальные, используя
+ * контекст расчётов.
+ * @param epoch Контекст расчётов на момент преобразования.
+ * @param lon Эклиптическая долгота (от точки весеннего равноденствия).
+ * @param lat Эклиптическая широта (положительная на север от эклиптики, отрицательная на юг).
+ * @param[out] ra Прямое восхождение в экваториальных координатах, может быть NULL.
+ * @param[out] dec Склонение в экваториальных координатах, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Transforms ecliptical coordinates to equatorial using calculation
+ * context.
+ * @param epoch Calculation context for the transformation instance.
+ * @param lon Ecliptical longitude (measured from vernal equinox).
+ * @param lat Ecliptical latitude (positive north of ecliptic, negative south).
+ * @param[out] ra Right ascension in equatorial coordinates, may be NULL.
+ * @param[out] dec Declination in equatorial coordinates, may be NULL.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ */
+#endif
+int sca_coordinates_ecliptic_to_equatorial_ctx	(const SCAEpoch *epoch, SCAAngle lon, SCAAngle lat, SCAAngle *ra, SCAAngle *dec);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Преобразует экваториальные координаты в местные (азимут и высота), используя
+ * контекст расчётов.
+ * @param epoch Контекст расчётов на момент преобразования.
+ * @param loc Положение наблюдателя.
+ * @param ra Прямое восхождение в экваториальных координатах.
+ * @param dec Склонение в экваториальных координатах.
+ * @param[out] A Азимут (положительный на запад от юга), может быть NULL.
+ * @param[out] h Высота над горизонтом, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Transforms equatorial coordinates to local (azimuth and altitude) using
+ * calculation context.
+ * @param epoch Calculation context for the transformation instance.
+ * @param loc Location of the observer.
+ * @param ra Right ascension in equatorial coordinates.
+ * @param dec Declination in equatorial coordinates.
+ * @param[out] A Azimuth (positive westwards from south), may be NULL.
+ * @param[out] h Altitude above horizon, may be NULL.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ */
+#endif
+int sca_coordinates_equatorial_to_local_ctx	(const SCAEpoch *epoch, const SCAGeoLocation *loc, SCAAngle ra, SCAAngle dec, SCAAngle *A, SCAAngle *h);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Преобразует экваториальные координаты в местные (азимут и высота) для
+ * наблюдателя, используя контекст расчётов.
+ * @param epoch Контекст расчётов на момент преобразования.
+ * @param obs Наблюдатель.
+ * @param ra Прямое восхождение в экваториальных координатах.
+ * @param dec Склонение в экваториальных координатах.
+ * @param[out] A Азимут (положительный на запад от юга), может быть NULL.
+ * @param[out] h Высота над горизонтом, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Transforms equatorial coordinates to local (azimuth and altitude) for
+ * the observer using calculation context.
+ * @param epoch Calculation context for the transformation instance.
+ * @param obs Observer.
+ * @param ra Right ascension in equatorial coordinates.
+ * @param dec Declination in equatorial coordinates.
+ * @param[out] A Azimuth (positive westwards from south), may be NULL.
+ * @param[out] h Altitude above horizon, may be NULL.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ */
+#endif
+int sca_coordinates_equatorial_to_local_observer	(const SCAEpoch *epoch, const SCAObserver *obs, SCAAngle ra, SCAAngle dec, SCAAngle *A, SCAAngle *h);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Преобразует экваториальные координаты объекта в местные для
+ * нескольких мест наблюдения, используя контекст расчётов.
+ * @param epoch Контекст расчётов на момент преобразования.
+ * @param ra Прямое восхождение в экваториальных координатах.
+ * @param dec Склонение в экваториальных координатах.
+ * @param dst Расстояние до объекта в АЕ для учёта параллакса, 0 для звёзд.
+ * @param longitudes Массив долгот мест наблюдения.
+ * @param latitudes Массив широт мест наблюдения.
+ * @param n Количество мест наблюдения.
+ * @param[out] A Массив азимутов (положительных на запад от юга), может быть NULL.
+ * @param[out] h Массив высот над горизонтом, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Звёздное время, синус и косинус склонения и параллакс рассчитываются один
+ * раз, а расчёт для мест наблюдения не содержит вызовов и ветвлений и
+ * векторизуется компилятором. Параллакс учитывается так же, как в
+ * sca_earth_get_parallax_equatorial_ctx() для наблюдателя на уровне моря.
+ * Результаты отличаются от результатов sca_coordinates_equatorial_to_local_ctx()
+ * не более чем на 1e-9 градуса.
+ */
+#else
+/**
+ * @brief Transforms equatorial coordinates of the object to local ones for
+ * several sites using calculation context.
+ * @param epoch Calculation context for the transformation instance.
+ * @param ra Right ascension in equatorial coordinates.
+ * @param dec Declination in equatorial coordinates.
+ * @param dst Distance to the object in AUs for the parallax, 0 for the stars.
+ * @param longitudes Array of the site longitudes.
+ * @param latitudes Array of the site latitudes.
+ * @param n Number of the sites.
+ * @param[out] A Array of azimuths (positive westwards from south), may be NULL.
+ * @param[out] h Array of altitudes above horizon, may be NULL.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Sidereal time, Sine and Cosine of the declination and the parallax are
+ * calculated once, and calculations for the sites contain no calls and
+ * branches, so they are vectorized by the compiler. Parallax is taken into
+ * account the same way as in sca_earth_get_parallax_equatorial_ctx() for the
+ * observer at sea level. Results differ from the ones of
+ * sca_coordinates_equatorial_to_local_ctx() by no more than 1e-9 degrees.
+ */
+#endif
+int sca_coordinates_equatorial_to_local_many	(const SCAEpoch		*epoch,
+						 SCAAngle		ra,
+						 SCAAngle		dec,
+						 double			dst,
+						 const SCAAngle		*longitudes,
+						 const SCAAngle		*latitudes,
+						 size_t			n,
+						 SCAAngle		*A,
+						 SCAAngle		*h);
 
 SCA_END_DECLS
 
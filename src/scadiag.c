@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+ */
+
+/**
+ * All the per-thread state lives in thread-local variables. The handler, its
+ * data and the rate limit are read together under a lock, so a report never
+ * pairs a new handler with the data of the old one. The clock is read only
+ * when a diagnostic is reported with a handler and a rate limit set.
+ */
+
+#ifndef _WIN32
+#  include <pthread.h>
+#endif
+#include <time.h>
+
+#include "scadiag.h"
+#include "scaprivate.h"
+
+#ifndef _WIN32
+static pthread_mutex_t	diag_lock	= PTHREAD_MUTEX_INITIALIZER;
+#endif
+static SCADiagHandler	diag_handler	= NULL;
+static void		*diag_user_data	= NULL;
+static unsigned int	diag_rate_limit	= 0;
+
+static SCA_THREAD_LOCAL SCADiagCode	diag_last_code	= SCA_DIAG_NONE;
+static SCA_THREAD_LOCAL time_t	diag_window	= 0;	/* Second of the current rate limit window	*/
+static SCA_THREAD_LOCAL unsigned int	diag_count	= 0;	/* Handler calls in the current window		*/
+static SCA_THREAD_LOCAL size_t	diag_suppressed	= 0;	/* Messages suppressed since the last call	*/
+
+void
+sca_diag_set_handler (SCADiagHandler handler, void *user_data)
+{
+#ifndef _WIN32
+	pthread_mutex_lock (&diag_lock);
+#endif
+
+	diag_handler	= handler;
+	diag_user_data	= user_data;
+
+#ifndef _WIN32
+	pthread_mutex_unlock (&diag_lock);
+#endif
+}
+
+void
+sca_diag_set_rate_limit (unsigned int max_per_second)
+{
+#ifndef _WIN32
+	pthread_mutex_lock (&diag_lock);
+#endif
+
+	diag_rate_limit = max_per_second;
+
+#ifndef _WIN32
+	pthread_mutex_unlock (&diag_lock);
+#endif
+}
+
+SCADiagCode
+sca_diag_get_last_code (void)
+{
+	return diag_last_code;
+}
+
+void
+sca_diag_clear_last_code (void)
+{
+	diag_last_code = SCA_DIAG_NONE;
+}
+
+void
+sca_diag_report (SCADiagCode code, const char *module, const char *message)
+{
+	SCADiagHandler	handler;
+	SCADiagInfo	info;
+	void		*user_data;
+	unsigned int	rate_limit;
+	time_t		now;
+
+	diag_last_code = code;
+
+#ifndef _WIN32
+	pthread_mutex_lock (&diag_lock);
+#endif
+
+	handler		= diag_handler;
+	user_data	= diag_user_data;
+	rate_limit	= diag_rate_limit;
+
+#ifndef _WIN32
+	pthread_mutex_unlock (&diag_lock);
+#endif
+
+	if (handler == NULL)
+		return;
+
+	if (rate_limit > 0) {
+		now = time (NULL);
+
+		if (now != diag_window) {
+			diag_window	= now;
+			diag_count	= 0;
+		}
+
+		if (diag_count >= rate_limit) {
+			++diag_suppressed;
+			return;
+		}
+
+		++diag_count;
+	}
+
+	info.code	= code;
+	info.module	= module;
+	info.message	= message;
+	info.suppressed	= diag_suppressed;
+
+	diag_suppressed = 0;
+
+	handler (&info, user_data);
+}
@@ -0,0 +1,298 @@
+/*
+ * Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+ */
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @file scadiag.h
+ * @brief Диагностика
+ * @author Александр Сапрыкин
+ *
+ * Некоторые функции сообщают о некорректных аргументах и о возможной потере
+ * точности, например, sca_misc_interpolate_three() при выходе значения за
+ * пределы таблицы. Библиотека ничего не выводит сама: код последней
+ * диагностики сохраняется отдельно для каждого потока, а сообщение передаётся
+ * обработчику, установленному функцией sca_diag_set_handler():
+ * @code
+ * static void
+ * log_diag (const SCADiagInfo *info, void *user_data)
+ * {
+ *	fprintf ((FILE *) user_data, "%s: %s (%lu suppressed)\n",
+ *		 info->module, info->message, (unsigned long) info->suppressed);
+ * }
+ *
+ * sca_diag_set_handler (log_diag, stderr);
+ * sca_diag_set_rate_limit (10);
+ * @endcode
+ * Ограничение частоты действует в каждом потоке отдельно: обработчик
+ * вызывается не более заданного количества раз в секунду, остальные сообщения
+ * только подсчитываются. Если библиотека собрана с опцией
+ * SCA_ENABLE_DIAGNOSTICS=OFF, диагностика полностью исключается из кода,
+ * обработчик никогда не вызывается, а код последней диагностики всегда равен
+ * #SCA_DIAG_NONE.
+ */
+#else
+/**
+ * @file scadiag.h
+ * @brief Diagnostics
+ * @author Alexander Saprykin
+ *
+ * Some routines report invalid arguments and possible loss of accuracy, e.g.
+ * sca_misc_interpolate_three() when the value is out of the table. The
+ * library never prints anything itself: the code of the last diagnostic is
+ * kept per thread, and the message is passed to the handler set with
+ * sca_diag_set_handler():
+ * @code
+ * static void
+ * log_diag (const SCADiagInfo *info, void *user_data)
+ * {
+ *	fprintf ((FILE *) user_data, "%s: %s (%lu suppressed)\n",
+ *		 info->module, info->message, (unsigned long) info->suppressed);
+ * }
+ *
+ * sca_diag_set_handler (log_diag, stderr);
+ * sca_diag_set_rate_limit (10);
+ * @endcode
+ * The rate limit applies to every thread separately: the handler is called no
+ * more than the given number of times per second, other messages are only
+ * counted. If the library is built with SCA_ENABLE_DIAGNOSTICS=OFF,
+ * diagnostics are compiled out completely, the handler is never called and
+ * the last diagnostic code is always #SCA_DIAG_NONE.
+ */
+#endif
+
+#if !defined (__SCALIB_H_INSIDE__) && !defined (SCALIB_COMPILATION)
+#  error "Header files shouldn't be included directly, consider using <scalib.h> instead."
+#endif
+
+#ifndef __SCADIAG_H__
+#define __SCADIAG_H__
+
+#include <stddef.h>
+
+#include <scamacros.h>
+
+SCA_BEGIN_DECLS
+
+#ifdef DOXYGEN_RUSSIAN
+/** Коды диагностики. */
+#else
+/** Diagnostic codes. */
+#endif
+typedef enum _SCADiagCode {
+#ifdef DOXYGEN_RUSSIAN
+	/** Диагностики не было.				*/
+#else
+	/** No diagnostic.					*/
+#endif
+	SCA_DIAG_NONE		= 0,
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Аргумент вне допустимого диапазона.		*/
+#else
+	/** Argument is out of the valid range.		*/
+#endif
+	SCA_DIAG_OUT_OF_RANGE	= 1,
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Результат может иметь низкую точность.	*/
+#else
+	/** Result may have low accuracy.		*/
+#endif
+	SCA_DIAG_LOW_ACCURACY	= 2,
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Предупреждение из #SCA_WARNING.			*/
+#else
+	/** Warning from #SCA_WARNING.				*/
+#endif
+	SCA_DIAG_WARNING	= 3
+} SCADiagCode;
+
+#ifdef DOXYGEN_RUSSIAN
+/** Определение типа для сообщения диагностики. */
+#else
+/** Typedef for the diagnostic message. */
+#endif
+typedef struct _SCADiagInfo {
+#ifdef DOXYGEN_RUSSIAN
+	/** Код диагностики.						*/
+#else
+	/** Diagnostic code.						*/
+#endif
+	SCADiagCode	code;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Модуль библиотеки, например, "SCAMisc".			*/
+#else
+	/** Library module, e.g. "SCAMisc".				*/
+#endif
+	const char	*module;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Текст сообщения.						*/
+#else
+	/** Message text.						*/
+#endif
+	const char	*message;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Количество сообщений, пропущенных в этом потоке из-за
+	 * ограничения частоты после предыдущего вызова обработчика.	*/
+#else
+	/** Number of the messages suppressed in this thread by the rate
+	 * limit since the previous call of the handler.		*/
+#endif
+	size_t		suppressed;
+} SCADiagInfo;
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Обработчик диагностики.
+ * @param info Сообщение диагностики, действительно только во время вызова.
+ * @param user_data Данные, переданные в sca_diag_set_handler().
+ * @since 0.0.2
+ *
+ * Обработчик вызывается в потоке, который сообщил о диагностике, и может
+ * вызываться из нескольких потоков одновременно.
+ */
+#else
+/**
+ * @brief Diagnostics handler.
+ * @param info Diagnostic message, valid only during the call.
+ * @param user_data Data passed to sca_diag_set_handler().
+ * @since 0.0.2
+ *
+ * The handler is called in the thread which has reported the diagnostic and
+ * may be called from several threads at the same time.
+ */
+#endif
+typedef void (*SCADiagHandler) (const SCADiagInfo *info, void *user_data);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Устанавливает обработчик диагностики.
+ * @param handler Обработчик, NULL для отключения.
+ * @param user_data Данные для обработчика.
+ * @since 0.0.2
+ *
+ * По умолчанию обработчик не установлен. Функцию можно вызывать во время
+ * расчётов в других потоках: каждая диагностика передаётся либо старому
+ * обработчику со старыми данными, либо новому с новыми. На Windows функцию
+ * следует вызывать до начала расчётов в других потоках.
+ */
+#else
+/**
+ * @brief Sets the diagnostics handler.
+ * @param handler Handler, NULL to disable.
+ * @param user_data Data for the handler.
+ * @since 0.0.2
+ *
+ * No handler is set by default. The routine may be called while the
+ * calculations are running in other threads: each diagnostic goes either to
+ * the old handler with the old data or to the new one with the new data. On
+ * Windows the routine should be called before the calculations are started
+ * in other threads.
+ */
+#endif
+void		sca_diag_set_handler		(SCADiagHandler handler, void *user_data);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Устанавливает ограничение частоты вызовов обработчика.
+ * @param max_per_second Максимальное количество вызовов обработчика в секунду
+ * в каждом потоке, 0 - без ограничения.
+ * @since 0.0.2
+ *
+ * По умолчанию ограничения нет.
+ */
+#else
+/**
+ * @brief Sets the rate limit for the handler calls.
+ * @param max_per_second Maximum number of the handler calls per second in
+ * every thread, 0 for no limit.
+ * @since 0.0.2
+ *
+ * There is no limit by default.
+ */
+#endif
+void		sca_diag_set_rate_limit		(unsigned int max_per_second);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Возвращает код последней диагностики в текущем потоке.
+ * @return Код последней диагностики, #SCA_DIAG_NONE, если её не было после
+ * вызова sca_diag_clear_last_code().
+ * @since 0.0.2
+ *
+ * Код сохраняется независимо от обработчика и ограничения частоты.
+ */
+#else
+/**
+ * @brief Gets the code of the last diagnostic in the current thread.
+ * @return Code of the last diagnostic, #SCA_DIAG_NONE if there was none since
+ * the call of sca_diag_clear_last_code().
+ * @since 0.0.2
+ *
+ * The code is stored regardless of the handler and the rate limit.
+ */
+#endif
+SCADiagCode	sca_diag_get_last_code		(void);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Сбрасывает код последней диагностики в текущем потоке.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Clears the code of the last diagnostic in the current thread.
+ * @since 0.0.2
+ */
+#endif
+void		sca_diag_clear_last_code	(void);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Сообщает о диагностике обработчику, установленному функцией
+ * sca_diag_set_handler().
+ * @param code Код диагностики.
+ * @param module Модуль.
+ * @param message Текст сообщения.
+ * @since 0.0.2
+ *
+ * Сохраняет код последней диагностики в текущем потоке и учитывает
+ * ограничение частоты.
+ */
+#else
+/**
+ * @brief Reports the diagnostic to the handler set with
+ * sca_diag_set_handler().
+ * @param code Diagnostic code.
+ * @param module Module.
+ * @param message Message text.
+ * @since 0.0.2
+ *
+ * Stores the last diagnostic code of the current thread and applies the rate
+ * limit.
+ */
+#endif
+void		sca_diag_report			(SCADiagCode code, const char *module, const char *message);
+
+SCA_END_DECLS
+
+#endif /* __SCADIAG_H__ */
@@ -20,6 +20,7 @@
 #include "scajulianday.h"
 #include "scasun.h"
 #include "scamoon.h"
+#include "scaprivate.h"
 
 #define SCA_EARTH_NUT_MAX_COEFS 63
 
@@ -90,15 +91,26 @@ static double nutation_data[SCA_EARTH_NUT_MAX_COEFS][9] = {
 	{ 2.0,	-1.0,	 0.0,	 2.0,	2.0,	-0.00030,	 0.00000,	 0.0001,	 0.00000}
 };
 
+const double *
+sca_earth_get_nutation_terms (unsigned int *count)
+{
+	*count = SCA_EARTH_NUT_MAX_COEFS;
+
+	return nutation_data[0];
+}
+
 int
 sca_earth_get_ecliptic_obliquity (double jd, SCAAngle *obl)
 {
 	double		t;
 	SCAAngle	obl0, d_obl;
+	SCA_STATS_DECLARE (ticks)
 
 	if (jd < 0 || obl == NULL)
 		return -1;
 
+	SCA_STATS_BEGIN (ticks);
+
 	t	= sca_jd_get_centuries_2000 (jd);
 
 	if (fabs (t) < 100) {
@@ -126,6 +138,8 @@ sca_earth_get_ecliptic_obliquity (double jd, SCAAngle *obl)
 	obl0	= sca_angle_from_degrees (23, 26, 21, 448.0);
 	*obl	= obl0 + d_obl;
 
+	SCA_STATS_END (SCA_STATS_OBLIQUITY, ticks);
+
 	return 0;
 }
 
@@ -134,12 +148,15 @@ sca_earth_get_nutation (double jd, SCAAngle *nut, SCAAngle *obl)
 {
 	int		i;
 	double		t;
-	double		d_nut, d_obl;
+	double		d_nut, d_obl, sin_arg, cos_arg;
 	SCAAngle	D, M, dM, F, Asc;
+	SCA_STATS_DECLARE (ticks)
 
 	if (jd < 0)
 		return -1;
 
+	SCA_STATS_BEGIN (ticks);
+
 	t = sca_jd_get_centuries_2000 (jd);
 
 	sca_moon_get_mean_elongation_from_sun (jd, &D);
@@ -150,19 +167,16 @@ sca_earth_get_nutation (double jd, SCAAngle *nut, SCAAngle *obl)
 
 	d_nut = d_obl = 0.0;
 	for (i = 0; i < SCA_EARTH_NUT_MAX_COEFS; ++i) {
-		d_nut += (nutation_data[i][5] + nutation_data[i][6] * t)
-			 * sin (nutation_data[i][0] * D
-			      + nutation_data[i][1] * M
-			      + nutation_data[i][2] * dM
-			      + nutation_data[i][3] * F
-			      + nutation_data[i][4] * Asc);
-
-		d_obl += (nutation_data[i][7] + nutation_data[i][8] * t)
-			 * cos (nutation_data[i][0] * D
-			      + nutation_data[i][1] * M
-			      + nutation_data[i][2] * dM
-			      + nutation_data[i][3] * F
-			      + nutation_data[i][4] * Asc);
+		/* Both parts share the argument */
+		sca_angle_get_sincos (nutation_data[i][0] * D
+				      + nutation_data[i][1] * M
+				      + nutation_data[i][2] * dM
+				      + nutation_data[i][3] * F
+				      + nutation_data[i][4] * Asc,
+				      &sin_arg, &cos_arg);
+
+		d_nut += (nutation_data[i][5] + nutation_data[i][6] * t) * sin_arg;
+		d_obl += (nutation_data[i][7] + nutation_data[i][8] * t) * cos_arg;
 	}
 
 
@@ -172,6 +186,8 @@ sca_earth_get_nutation (double jd, SCAAngle *nut, SCAAngle *obl)
 	if (obl != NULL)
 		*obl = sca_angle_from_decimal_degrees (d_obl / 3600.0);
 
+	SCA_STATS_END (SCA_STATS_NUTATION, ticks);
+
 	return 0;
 }
 
@@ -184,51 +200,66 @@ sca_earth_get_refraction (SCAAngle h)
 									       / 60.0);
 }
 
-int
-sca_earth_get_parallax_equatorial (double		jd,
-				   double		dst,
-				   SCAGeoLocation	*loc,
-				   SCAAngle		ra,
-				   SCAAngle		dec,
-				   SCAAngle		*d_ra,
-				   SCAAngle		*d_dec)
+/**
+ * @brief Calculates geocentric coordinates of the observer at sea level.
+ * @param latitude Observer's latitude.
+ * @param[out] rho_sin Distance to the equator plane in equatorial radii.
+ * @param[out] rho_cos Distance to the Earth's axis in equatorial radii.
+ * @since 0.0.2
+ */
+static void
+_sca_earth_get_geocentric_location (SCAAngle latitude, double *rho_sin, double *rho_cos)
 {
-	SCAAngle	H, sa, pi, dlat;
-	SCAAngle	dra, ddec, new_dec;
+	SCAAngle	dlat;
 	double		p, f_ratio;
 	double		sin_dlat, cos_dlat;
-	double		sin_pi, cos_pi, sin_H, cos_H;
-	double		sin_ra, cos_ra, sin_dec, cos_dec;
-
-	if (jd < 0 || loc == NULL)
-		return -1;
-
-	sca_jd_get_sidereal_time (jd, &sa);
-	H = sa - loc->longitude - ra;
 
 	/* Geocentric radius-vector */
-	p = 0.9983271 + 0.0016764 * sca_angle_get_cos (2.0 * loc->latitude)
-		      - 0.0000035 * sca_angle_get_cos (4.0 * loc->latitude);
+	p = 0.9983271 + 0.0016764 * sca_angle_get_cos (2.0 * latitude)
+		      - 0.0000035 * sca_angle_get_cos (4.0 * latitude);
 
 	/* Earth's flattering: 1/298.257 */
 	f_ratio	= 1 - 1/298.257;
-	dlat		= atan2 (f_ratio * f_ratio * sca_angle_get_sin (loc->latitude),
-				 sca_angle_get_cos (loc->latitude)) * SCA_ANGLE_RAD_TO_DEG;
+	dlat		= atan2 (f_ratio * f_ratio * sca_angle_get_sin (latitude),
+				 sca_angle_get_cos (latitude)) * SCA_ANGLE_RAD_TO_DEG;
+
+	sca_angle_get_sincos (dlat, &sin_dlat, &cos_dlat);
+
+	*rho_sin = p * sin_dlat;
+	*rho_cos = p * cos_dlat;
+}
+
+static void
+_sca_earth_get_parallax_equatorial (SCAAngle		sa,
+				    double		dst,
+				    SCAAngle		longitude,
+				    double		rho_sin,
+				    double		rho_cos,
+				    SCAAngle		ra,
+				    SCAAngle		dec,
+				    SCAAngle		*d_ra,
+				    SCAAngle		*d_dec)
+{
+	SCAAngle	H, pi;
+	SCAAngle	dra, ddec, new_dec;
+	double		sin_pi, cos_pi, sin_H, cos_H;
+	double		sin_ra, cos_ra, sin_dec, cos_dec;
+
+	H = sa - longitude - ra;
 
 	/* Equatorial horiazontal parallax */
 	pi = sca_angle_from_degrees (0, 0, 8, 794) / dst;
 
-	sca_angle_get_sincos (dlat, &sin_dlat, &cos_dlat);
 	sca_angle_get_sincos (pi, &sin_pi, &cos_pi);
 	sca_angle_get_sincos (H, &sin_H, &cos_H);
 	sca_angle_get_sincos (ra, &sin_ra, &cos_ra);
 	sca_angle_get_sincos (dec, &sin_dec, &cos_dec);
 
-	dra	= atan2 ((-p) * cos_dlat * sin_pi * sin_H,
-			 cos_dec - p * cos_dlat * sin_pi * cos_H) * SCA_ANGLE_RAD_TO_DEG;
+	dra	= atan2 ((-rho_cos) * sin_pi * sin_H,
+			 cos_dec - rho_cos * sin_pi * cos_H) * SCA_ANGLE_RAD_TO_DEG;
 
-	new_dec	= atan2 ((sin_dec - p * sin_dlat * sin_pi) * sca_angle_get_cos (dra),
-			 cos_dec - p * cos_dlat * sin_pi * cos_H) * SCA_ANGLE_RAD_TO_DEG;
+	new_dec	= atan2 ((sin_dec - rho_sin * sin_pi) * sca_angle_get_cos (dra),
+			 cos_dec - rho_cos * sin_pi * cos_H) * SCA_ANGLE_RAD_TO_DEG;
 	ddec	= new_dec - dec;
 
 	if (d_ra != NULL)
@@ -236,6 +267,86 @@ sca_earth_get_parallax_equatorial (double		jd,
 
 	if (d_dec != NULL)
 		*d_dec = ddec;
+}
+
+int
+sca_earth_get_parallax_equatorial (double		jd,
+				   double		dst,
+				   const SCAGeoLocation	*loc,
+				   SCAAngle		ra,
+				   SCAAngle		dec,
+				   SCAAngle		*d_ra,
+				   SCAAngle		*d_dec)
+{
+	SCAAngle	sa;
+	double		rho_sin, rho_cos;
+
+	if (jd < 0 || loc == NULL)
+		return -1;
+
+	sca_jd_get_sidereal_time (jd, &sa);
+	_sca_earth_get_geocentric_location (loc->latitude, &rho_sin, &rho_cos);
+	_sca_earth_get_parallax_equatorial (sa, dst, loc->longitude, rho_sin, rho_cos, ra, dec, d_ra, d_dec);
+
+	return 0;
+}
+
+int
+sca_earth_get_parallax_equatorial_ctx (const SCAEpoch		*epoch,
+				       double			dst,
+				       const SCAGeoLocation	*loc,
+				       SCAAngle			ra,
+				       SCAAngle			dec,
+				       SCAAngle			*d_ra,
+				       SCAAngle			*d_dec)
+{
+	double	rho_sin, rho_cos;
+
+	if (epoch == NULL || loc == NULL)
+		return -1;
+
+	_sca_earth_get_geocentric_location (loc->latitude, &rho_sin, &rho_cos);
+	_sca_earth_get_parallax_equatorial (epoch->sidereal, dst, loc->longitude, rho_sin, rho_cos, ra, dec, d_ra, d_dec);
+
+	return 0;
+}
+
+int
+sca_observer_new (SCAObserver *obs, const SCAGeoLocation *loc, double height)
+{
+	if (obs == NULL || loc == NULL)
+		return -1;
+
+	obs->longitude	= loc->longitude;
+	obs->latitude	= loc->latitude;
+	obs->height	= height;
+
+	sca_angle_get_sincos (loc->latitude, &obs->sin_lat, &obs->cos_lat);
+	_sca_earth_get_geocentric_location (loc->latitude, &obs->rho_sin, &obs->rho_cos);
+
+	/* Height correction, in equatorial radii of 6378140 m */
+	if (height != 0.0) {
+		obs->rho_sin += height / 6378140.0 * obs->sin_lat;
+		obs->rho_cos += height / 6378140.0 * obs->cos_lat;
+	}
+
+	return 0;
+}
+
+int
+sca_earth_get_parallax_equatorial_observer (const SCAEpoch	*epoch,
+					    double		dst,
+					    const SCAObserver	*obs,
+					    SCAAngle		ra,
+					    SCAAngle		dec,
+					    SCAAngle		*d_ra,
+					    SCAAngle		*d_dec)
+{
+	if (epoch == NULL || obs == NULL)
+		return -1;
+
+	_sca_earth_get_parallax_equatorial (epoch->sidereal, dst, obs->longitude, obs->rho_sin, obs->rho_cos,
+					    ra, dec, d_ra, d_dec);
 
 	return 0;
 }
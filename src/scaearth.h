@@ -41,6 +41,7 @@
 
 #include <scamacros.h>
 #include <scaangle.h>
+#include <scaepoch.h>
 
 SCA_BEGIN_DECLS
 
@@ -65,6 +66,71 @@ typedef struct _SCAGeoLocation {
 	SCAAngle	latitude;
 } SCAGeoLocation;
 
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * Определение типа для наблюдателя. Хранит положение наблюдателя и значения,
+ * которые зависят только от него: синус и косинус широты и геоцентрические
+ * координаты наблюдателя для расчёта параллакса. Инициализируется функцией
+ * sca_observer_new().
+ */
+#else
+/**
+ * Typedef for observer. Holds observer's location and the values which depend
+ * only on it: sine and cosine of the latitude and observer's geocentric
+ * coordinates for parallax calculation. Initialized with sca_observer_new().
+ */
+#endif
+typedef struct _SCAObserver {
+#ifdef DOXYGEN_RUSSIAN
+	/** Долгота, положительная на запад от Гринвича.		*/
+#else
+	/** Longitude, positive westward from Greenwich.		*/
+#endif
+	SCAAngle	longitude;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Широта, положительная к северу от экватора.			*/
+#else
+	/** Latitude, positive north from equator.			*/
+#endif
+	SCAAngle	latitude;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Высота над эллипсоидом в метрах.				*/
+#else
+	/** Height above the ellipsoid in meters.			*/
+#endif
+	double		height;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Синус широты.						*/
+#else
+	/** Sine of the latitude.					*/
+#endif
+	double		sin_lat;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Косинус широты.						*/
+#else
+	/** Cosine of the latitude.					*/
+#endif
+	double		cos_lat;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Расстояние до оси Земли в экваториальных радиусах, rho * cos (phi').	*/
+#else
+	/** Distance to the Earth's axis in equatorial radii, rho * cos (phi').	*/
+#endif
+	double		rho_cos;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Расстояние до плоскости экватора в экваториальных радиусах, rho * sin (phi').	*/
+#else
+	/** Distance to the equator plane in equatorial radii, rho * sin (phi').		*/
+#endif
+	double		rho_sin;
+} SCAObserver;
+
 #ifdef DOXYGEN_RUSSIAN
 /**
  * @brief Рассчитывает угол наклона эклиптики.
@@ -152,13 +218,122 @@ SCAAngle	sca_earth_get_refraction		(SCAAngle h);
  * @since 0.0.1
  */
 #endif
-int		sca_earth_get_parallax_equatorial	(double		jd,
-							 double		dst,
-							 SCAGeoLocation	*loc,
-							 SCAAngle	ra,
-							 SCAAngle	dec,
-							 SCAAngle	*d_ra,
-							 SCAAngle	*d_dec);
+int		sca_earth_get_parallax_equatorial	(double			jd,
+							 double			dst,
+							 const SCAGeoLocation	*loc,
+							 SCAAngle		ra,
+							 SCAAngle		dec,
+							 SCAAngle		*d_ra,
+							 SCAAngle		*d_dec);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает параллакс в экваториальных координатах для наблюдателя на Земле,
+ * используя контекст расчётов. Возвращаемые значения добавляются к соответствующим
+ * координатам небесного тела.
+ * @param epoch Контекст расчётов.
+ * @param dst Геоцентрическое расстояние до объекта в АЕ.
+ * @param loc Положение наблюдателя.
+ * @param ra Прямое восхождение объекта.
+ * @param dec Склонение объекта.
+ * @param[out] d_ra Параллакс прямого восхождения, может быть NULL.
+ * @param[out] d_dec Параллакс склонения, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Calculates parallax in equatorial coordinates for observer on the Earth
+ * using calculation context. Add output values respectively to coordinates of the
+ * sky object.
+ * @param epoch Calculation context.
+ * @param dst Geocentric distance of the object in AU.
+ * @param loc Location of the observer.
+ * @param ra Object's right ascension.
+ * @param dec Object's declination.
+ * @param[out] d_ra Right ascension parallax, may be NULL.
+ * @param[out] d_dec Declination parallax, may be NULL.
+ * @return 0 in case if success, -1 otherwise.
+ * @since 0.0.2
+ */
+#endif
+int		sca_earth_get_parallax_equatorial_ctx	(const SCAEpoch		*epoch,
+							 double			dst,
+							 const SCAGeoLocation	*loc,
+							 SCAAngle		ra,
+							 SCAAngle		dec,
+							 SCAAngle		*d_ra,
+							 SCAAngle		*d_dec);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Инициализирует наблюдателя.
+ * @param[out] obs Структура #SCAObserver для инициализации.
+ * @param loc Положение наблюдателя.
+ * @param height Высота над эллипсоидом в метрах.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Геоцентрические координаты наблюдателя рассчитываются так же, как в
+ * sca_earth_get_parallax_equatorial(), с поправкой на высоту. При нулевой
+ * высоте результаты функций для наблюдателя совпадают с результатами функций
+ * для #SCAGeoLocation.
+ */
+#else
+/**
+ * @brief Initializes the observer.
+ * @param[out] obs #SCAObserver structure to initialize.
+ * @param loc Location of the observer.
+ * @param height Height above the ellipsoid in meters.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Geocentric coordinates of the observer are calculated the same way as in
+ * sca_earth_get_parallax_equatorial(), corrected for the height. With zero
+ * height the results of the functions for the observer are the same as of
+ * the functions for #SCAGeoLocation.
+ */
+#endif
+int		sca_observer_new			(SCAObserver *obs, const SCAGeoLocation *loc, double height);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает параллакс в экваториальных координатах для наблюдателя,
+ * используя контекст расчётов. Возвращаемые значения добавляются к
+ * соответствующим координатам небесного тела.
+ * @param epoch Контекст расчётов.
+ * @param dst Геоцентрическое расстояние до объекта в АЕ.
+ * @param obs Наблюдатель.
+ * @param ra Прямое восхождение объекта.
+ * @param dec Склонение объекта.
+ * @param[out] d_ra Параллакс прямого восхождения, может быть NULL.
+ * @param[out] d_dec Параллакс склонения, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Calculates parallax in equatorial coordinates for the observer using
+ * calculation context. Add output values respectively to coordinates of the
+ * sky object.
+ * @param epoch Calculation context.
+ * @param dst Geocentric distance of the object in AU.
+ * @param obs Observer.
+ * @param ra Object's right ascension.
+ * @param dec Object's declination.
+ * @param[out] d_ra Right ascension parallax, may be NULL.
+ * @param[out] d_dec Declination parallax, may be NULL.
+ * @return 0 in case if success, -1 otherwise.
+ * @since 0.0.2
+ */
+#endif
+int		sca_earth_get_parallax_equatorial_observer	(const SCAEpoch		*epoch,
+								 double			dst,
+								 const SCAObserver	*obs,
+								 SCAAngle		ra,
+								 SCAAngle		dec,
+								 SCAAngle		*d_ra,
+								 SCAAngle		*d_dec);
 
 #ifdef DOXYGEN_RUSSIAN
 /**
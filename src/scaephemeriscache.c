@@ -0,0 +1,623 @@
+/*
+ * Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+ */
+
+/**
+ * Every segment of a body stores three sets of Chebyshev coefficients (for
+ * longitude, latitude and distance) one after another. Longitude is unwrapped
+ * within the segment before fitting, so the polynomial doesn't have to follow
+ * the jump from 360 to 0 degrees. Nutation is stored in place of longitude and
+ * latitude with a constant unit distance.
+ *
+ * The file format is the in-memory layout written as is:
+ *  - header (magic, version, byte order mark, number of bodies, interval);
+ *  - one entry per body (segment, order, count, offset, max error), count of
+ *    zero means the body is absent;
+ *  - coefficients of every body starting at a 64-byte aligned offset.
+ * Bodies beyond the known ones are ignored, so a file with the same version
+ * may be extended with new bodies.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+#include "scaephemeriscache.h"
+#include "scaearth.h"
+#include "scaplanetdata.h"
+#include "scafastmath.h"
+#include "scaprivate.h"
+
+/* Number of the verification points per coefficient */
+#define SCA_EPHEMERIS_CHECKS		2
+
+#define SCA_EPHEMERIS_FILE_MAGIC	"SCAEPHEM"
+#define SCA_EPHEMERIS_FILE_BYTE_ORDER	0x01020304
+#define SCA_EPHEMERIS_FILE_ALIGN	64
+
+typedef struct _SCAEphemerisFileHeader {
+	char		magic[8];
+	uint32_t	version;
+	uint32_t	byte_order;
+	uint32_t	bodies;
+	uint32_t	reserved;
+	double		jd_begin;
+	double		jd_end;
+} SCAEphemerisFileHeader;
+
+typedef struct _SCAEphemerisFileEntry {
+	double		segment;
+	uint32_t	order;
+	uint32_t	reserved;
+	uint64_t	count;
+	uint64_t	offset;
+	double		max_error;
+} SCAEphemerisFileEntry;
+
+/* Default segment length (in days) and order for every body */
+static const struct {
+	double		segment;
+	unsigned int	order;
+} ephemeris_defaults[SCA_EPHEMERIS_BODIES] = {
+	{32.0,	14},	/* Sun		*/
+	{8.0,	14},	/* Moon		*/
+	{16.0,	14},	/* Mercury	*/
+	{32.0,	14},	/* Venus	*/
+	{32.0,	14},	/* Earth	*/
+	{32.0,	14},	/* Mars		*/
+	{64.0,	12},	/* Jupiter	*/
+	{64.0,	12},	/* Saturn	*/
+	{64.0,	12},	/* Uranus	*/
+	{64.0,	12},	/* Neptune	*/
+	{16.0,	14}	/* Nutation	*/
+};
+
+/**
+ * @brief Calculates body position using the analytical series.
+ * @param body Body to calculate.
+ * @param jd Julian Day.
+ * @param[out] val Longitude, latitude and distance.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ */
+static int
+_sca_ephemeris_cache_sample (SCAEphemerisBody body, double jd, double val[3])
+{
+	switch (body) {
+	case SCA_EPHEMERIS_SUN:
+		if (sca_planet_data_get (SCA_PLANET_EARTH, jd, &val[0], &val[1], &val[2]) != 0)
+			return -1;
+
+		val[0] += 180.0;
+		val[1]	= -val[1];
+
+		return 0;
+	case SCA_EPHEMERIS_MOON:
+		sca_moon_get_ecliptic (jd, &val[0], &val[1], &val[2]);
+		return 0;
+	case SCA_EPHEMERIS_NUTATION:
+		val[2] = 1.0;
+		return sca_earth_get_nutation (jd, &val[0], &val[1]);
+	default:
+		return sca_planet_data_get ((SCAPlanet) (body - 1), jd, &val[0], &val[1], &val[2]);
+	}
+}
+
+/**
+ * @brief Evaluates Chebyshev series using Clenshaw's recurrence.
+ * @param c Coefficients.
+ * @param order Number of the coefficients.
+ * @param x Argument within [-1, 1].
+ * @return Value of the series.
+ * @since 0.0.2
+ */
+static double
+_sca_ephemeris_cache_clenshaw (const double *c, unsigned int order, double x)
+{
+	double		b0, b1, b2;
+	unsigned int	i;
+
+	b1 = b2 = 0.0;
+
+	for (i = order - 1; i > 0; --i) {
+		b0 = 2.0 * x * b1 - b2 + c[i];
+		b2 = b1;
+		b1 = b0;
+	}
+
+	return x * b1 - b2 + c[0];
+}
+
+/**
+ * @brief Fits single segment and verifies it against the series.
+ * @param body Body to fit.
+ * @param jd Julian Day of the segment start.
+ * @param segment Length of the segment in days.
+ * @param order Number of the coefficients.
+ * @param[out] c Coefficients for longitude, latitude and distance.
+ * @param[out] err Maximum error of the segment in arcseconds.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ */
+static int
+_sca_ephemeris_cache_fit (SCAEphemerisBody	body,
+			  double		jd,
+			  double		segment,
+			  unsigned int		order,
+			  double		*c,
+			  double		*err)
+{
+	double		f[SCA_EPHEMERIS_MAX_ORDER][3];
+	double		val[3], x, d, fit;
+	unsigned int	i, j, k, checks;
+
+	for (k = 0; k < order; ++k) {
+		x = cos (SCA_FAST_PI * (k + 0.5) / order);
+
+		if (_sca_ephemeris_cache_sample (body, jd + (x + 1.0) * 0.5 * segment, f[k]) != 0)
+			return -1;
+
+		/* Unwrap longitude relative to the previous node */
+		if (k > 0)
+			f[k][0] -= 360.0 * floor ((f[k][0] - f[k - 1][0]) / 360.0 + 0.5);
+	}
+
+	for (i = 0; i < 3; ++i)
+		for (j = 0; j < order; ++j) {
+			c[i * order + j] = 0.0;
+
+			for (k = 0; k < order; ++k)
+				c[i * order + j] += f[k][i] * cos (SCA_FAST_PI * j * (k + 0.5) / order);
+
+			c[i * order + j] *= (j == 0 ? 1.0 : 2.0) / order;
+		}
+
+	checks	= order * SCA_EPHEMERIS_CHECKS;
+	*err	= 0.0;
+
+	for (k = 0; k <= checks; ++k) {
+		x = 2.0 * k / checks - 1.0;
+
+		if (_sca_ephemeris_cache_sample (body, jd + (x + 1.0) * 0.5 * segment, val) != 0)
+			return -1;
+
+		fit	= _sca_ephemeris_cache_clenshaw (c, order, x);
+		d	= val[0] - fit;
+		d	= fabs (d - 360.0 * floor (d / 360.0 + 0.5)) * 3600.0;
+		*err = fmax (*err, d);
+
+		d = fabs (_sca_ephemeris_cache_clenshaw (c + order, order, x) - val[1]) * 3600.0;
+		*err = fmax (*err, d);
+
+		d = fabs (_sca_ephemeris_cache_clenshaw (c + 2 * order, order, x) - val[2]) / val[2];
+		*err = fmax (*err, d * SCA_ANGLE_RAD_TO_DEG * 3600.0);
+	}
+
+	return 0;
+}
+
+int
+sca_ephemeris_cache_new (SCAEphemerisCache *cache, double jd_begin, double jd_end)
+{
+	if (cache == NULL || jd_begin < 0 || !(jd_end > jd_begin))
+		return -1;
+
+	memset (cache, 0, sizeof (SCAEphemerisCache));
+
+	cache->jd_begin	= jd_begin;
+	cache->jd_end	= jd_end;
+
+	return 0;
+}
+
+void
+sca_ephemeris_cache_free (SCAEphemerisCache *cache)
+{
+	int	i;
+
+	if (cache == NULL)
+		return;
+
+	if (cache->map != NULL) {
+#ifdef _WIN32
+		UnmapViewOfFile (cache->map);
+#else
+		munmap ((void *) cache->map, cache->map_size);
+#endif
+	} else {
+		for (i = 0; i < SCA_EPHEMERIS_BODIES; ++i)
+			free ((double *) cache->series[i].coefs);
+	}
+
+	memset (cache, 0, sizeof (SCAEphemerisCache));
+}
+
+int
+sca_ephemeris_cache_add (SCAEphemerisCache	*cache,
+			 SCAEphemerisBody	body,
+			 double			segment,
+			 unsigned int		order,
+			 double			*max_error)
+{
+	SCAEphemerisSeries	*series;
+	double			*coefs;
+	double			span, err, max_err;
+	size_t			count, i;
+
+	if (cache == NULL || body < 0 || body >= SCA_EPHEMERIS_BODIES || segment < 0 ||
+	    order > SCA_EPHEMERIS_MAX_ORDER || !(cache->jd_end > cache->jd_begin))
+		return -1;
+
+	/* Mapped file is read-only */
+	if (cache->map != NULL)
+		return -1;
+
+	if (body >= SCA_EPHEMERIS_MERCURY && body <= SCA_EPHEMERIS_NEPTUNE &&
+	    !sca_planet_data_is_available ((SCAPlanet) (body - 1)))
+		return -1;
+
+	if (body == SCA_EPHEMERIS_SUN && !sca_planet_data_is_available (SCA_PLANET_EARTH))
+		return -1;
+
+	if (segment == 0)
+		segment = ephemeris_defaults[body].segment;
+
+	if (order == 0)
+		order = ephemeris_defaults[body].order;
+
+	if (order < 2)
+		return -1;
+
+	span = cache->jd_end - cache->jd_begin;
+
+	if (span / segment > (double) (((size_t) -1) / (3 * order * sizeof (double)) - 1))
+		return -1;
+
+	count = (size_t) ceil (span / segment);
+
+	if (count == 0)
+		count = 1;
+
+	if ((coefs = malloc (count * 3 * order * sizeof (double))) == NULL)
+		return -1;
+
+	max_err = 0.0;
+
+	for (i = 0; i < count; ++i) {
+		if (_sca_ephemeris_cache_fit (body,
+					      cache->jd_begin + i * segment,
+					      segment,
+					      order,
+					      coefs + i * 3 * order,
+					      &err) != 0) {
+			free (coefs);
+			return -1;
+		}
+
+		max_err = fmax (max_err, err);
+	}
+
+	series = &cache->series[body];
+
+	free ((double *) series->coefs);
+
+	series->segment		= segment;
+	series->order		= order;
+	series->count		= count;
+	series->max_error	= max_err;
+	series->coefs		= coefs;
+
+	if (max_error != NULL)
+		*max_error = max_err;
+
+	return 0;
+}
+
+int
+sca_ephemeris_cache_has_body (const SCAEphemerisCache *cache, SCAEphemerisBody body)
+{
+	if (cache == NULL || body < 0 || body >= SCA_EPHEMERIS_BODIES)
+		return FALSE;
+
+	return cache->series[body].coefs != NULL ? TRUE : FALSE;
+}
+
+int
+sca_ephemeris_cache_get (const SCAEphemerisCache	*cache,
+			 SCAEphemerisBody		body,
+			 double				jd,
+			 SCAAngle			*lon,
+			 SCAAngle			*lat,
+			 double				*dst)
+{
+	const SCAEphemerisSeries	*series;
+	const double			*c;
+	double				t, x;
+	size_t				i;
+	SCA_STATS_DECLARE (ticks)
+
+	if (cache == NULL || body < 0 || body >= SCA_EPHEMERIS_BODIES)
+		return -1;
+
+	series = &cache->series[body];
+
+	if (series->coefs == NULL || jd < cache->jd_begin || jd > cache->jd_end) {
+		SCA_STATS_CACHE (SCA_STATS_EPHEMERIS_CACHE, FALSE);
+		return -1;
+	}
+
+	SCA_STATS_BEGIN (ticks);
+
+	t = (jd - cache->jd_begin) / series->segment;
+	i = (size_t) t;
+
+	/* The interval end belongs to the last segment */
+	if (i >= series->count)
+		i = series->count - 1;
+
+	x = 2.0 * (t - (double) i) - 1.0;
+	c = series->coefs + i * 3 * series->order;
+
+	if (lon != NULL) {
+		*lon = _sca_ephemeris_cache_clenshaw (c, series->order, x);
+		sca_angle_reduce (lon);
+	}
+
+	if (lat != NULL)
+		*lat = _sca_ephemeris_cache_clenshaw (c + series->order, series->order, x);
+
+	if (dst != NULL)
+		*dst = _sca_ephemeris_cache_clenshaw (c + 2 * series->order, series->order, x);
+
+	SCA_STATS_CACHE (SCA_STATS_EPHEMERIS_CACHE, TRUE);
+	SCA_STATS_END (SCA_STATS_EPHEMERIS_CACHE, ticks);
+
+	return 0;
+}
+
+int
+sca_ephemeris_cache_save (const SCAEphemerisCache *cache, const char *path)
+{
+	SCAEphemerisFileHeader	header;
+	SCAEphemerisFileEntry	entries[SCA_EPHEMERIS_BODIES];
+	char			pad[SCA_EPHEMERIS_FILE_ALIGN];
+	FILE			*file;
+	uint64_t		offset;
+	size_t			size, written;
+	int			i, ret;
+
+	if (cache == NULL || path == NULL || !(cache->jd_end > cache->jd_begin))
+		return -1;
+
+	memset (&header, 0, sizeof (header));
+	memset (entries, 0, sizeof (entries));
+	memset (pad, 0, sizeof (pad));
+
+	memcpy (header.magic, SCA_EPHEMERIS_FILE_MAGIC, sizeof (header.magic));
+	header.version		= SCA_EPHEMERIS_FILE_VERSION;
+	header.byte_order	= SCA_EPHEMERIS_FILE_BYTE_ORDER;
+	header.bodies		= SCA_EPHEMERIS_BODIES;
+	header.jd_begin		= cache->jd_begin;
+	header.jd_end		= cache->jd_end;
+
+	offset = sizeof (header) + sizeof (entries);
+
+	for (i = 0; i < SCA_EPHEMERIS_BODIES; ++i) {
+		if (cache->series[i].coefs == NULL)
+			continue;
+
+		offset = (offset + SCA_EPHEMERIS_FILE_ALIGN - 1) / SCA_EPHEMERIS_FILE_ALIGN * SCA_EPHEMERIS_FILE_ALIGN;
+
+		entries[i].segment	= cache->series[i].segment;
+		entries[i].order	= cache->series[i].order;
+		entries[i].count	= cache->series[i].count;
+		entries[i].offset	= offset;
+		entries[i].max_error	= cache->series[i].max_error;
+
+		offset += (uint64_t) cache->series[i].count * 3 * cache->series[i].order * sizeof (double);
+	}
+
+	if ((file = fopen (path, "wb")) == NULL)
+		return -1;
+
+	ret	= 0;
+	offset	= sizeof (header) + sizeof (entries);
+
+	if (fwrite (&header, sizeof (header), 1, file) != 1 ||
+	    fwrite (entries, sizeof (entries), 1, file) != 1)
+		ret = -1;
+
+	for (i = 0; ret == 0 && i < SCA_EPHEMERIS_BODIES; ++i) {
+		if (entries[i].count == 0)
+			continue;
+
+		if (entries[i].offset > offset &&
+		    fwrite (pad, (size_t) (entries[i].offset - offset), 1, file) != 1) {
+			ret = -1;
+			break;
+		}
+
+		size	= (size_t) entries[i].count * 3 * entries[i].order;
+		written	= fwrite (cache->series[i].coefs, sizeof (double), size, file);
+
+		if (written != size)
+			ret = -1;
+
+		offset = entries[i].offset + size * sizeof (double);
+	}
+
+	if (fclose (file) != 0)
+		ret = -1;
+
+	if (ret != 0)
+		remove (path);
+
+	return ret;
+}
+
+/**
+ * @brief Checks the mapped file and fills in the cache.
+ * @param[out] cache Cache to fill in.
+ * @param map Mapped file.
+ * @param size Size of the file in bytes.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ */
+static int
+_sca_ephemeris_cache_load (SCAEphemerisCache *cache, const void *map, size_t size)
+{
+	const SCAEphemerisFileHeader	*header;
+	const SCAEphemerisFileEntry	*entry;
+	SCAEphemerisSeries		*series;
+	SCAEphemerisCache		tmp;
+	uint64_t			bytes;
+	uint32_t			i;
+
+	header = (const SCAEphemerisFileHeader *) map;
+
+	if (size < sizeof (SCAEphemerisFileHeader) ||
+	    memcmp (header->magic, SCA_EPHEMERIS_FILE_MAGIC, sizeof (header->magic)) != 0 ||
+	    header->version != SCA_EPHEMERIS_FILE_VERSION ||
+	    header->byte_order != SCA_EPHEMERIS_FILE_BYTE_ORDER ||
+	    header->jd_begin < 0 || !(header->jd_end > header->jd_begin) ||
+	    header->bodies > (size - sizeof (SCAEphemerisFileHeader)) / sizeof (SCAEphemerisFileEntry))
+		return -1;
+
+	memset (&tmp, 0, sizeof (SCAEphemerisCache));
+
+	tmp.jd_begin	= header->jd_begin;
+	tmp.jd_end	= header->jd_end;
+
+	entry = (const SCAEphemerisFileEntry *) (header + 1);
+
+	for (i = 0; i < header->bodies && i < SCA_EPHEMERIS_BODIES; ++i, ++entry) {
+		if (entry->count == 0)
+			continue;
+
+		if (entry->order < 2 || entry->order > SCA_EPHEMERIS_MAX_ORDER ||
+		    !(entry->segment > 0) ||
+		    entry->count * entry->segment < header->jd_end - header->jd_begin ||
+		    entry->offset % sizeof (double) != 0 || entry->offset > size)
+			return -1;
+
+		bytes = (size - entry->offset) / (3 * entry->order * sizeof (double));
+
+		if (entry->count > bytes)
+			return -1;
+
+		series = &tmp.series[i];
+
+		series->segment		= entry->segment;
+		series->order		= entry->order;
+		series->count		= (size_t) entry->count;
+		series->max_error	= entry->max_error;
+		series->coefs		= (const double *) ((const char *) map + entry->offset);
+	}
+
+	tmp.map		= map;
+	tmp.map_size	= size;
+
+	*cache = tmp;
+
+	return 0;
+}
+
+int
+sca_ephemeris_cache_open (SCAEphemerisCache *cache, const char *path)
+{
+	void		*map;
+	size_t		size;
+#ifdef _WIN32
+	HANDLE		file, mapping;
+	LARGE_INTEGER	file_size;
+#else
+	struct stat	st;
+	int		fd;
+#endif
+
+	if (cache == NULL || path == NULL)
+		return -1;
+
+#ifdef _WIN32
+	file = CreateFileA (path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+	if (file == INVALID_HANDLE_VALUE)
+		return -1;
+
+	if (!GetFileSizeEx (file, &file_size) || file_size.QuadPart <= 0 ||
+	    (unsigned long long) file_size.QuadPart > (size_t) -1) {
+		CloseHandle (file);
+		return -1;
+	}
+
+	size	= (size_t) file_size.QuadPart;
+	mapping	= CreateFileMappingA (file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+	CloseHandle (file);
+
+	if (mapping == NULL)
+		return -1;
+
+	map = MapViewOfFile (mapping, FILE_MAP_READ, 0, 0, 0);
+
+	/* The view keeps the mapping alive */
+	CloseHandle (mapping);
+
+	if (map == NULL)
+		return -1;
+
+	if (_sca_ephemeris_cache_load (cache, map, size) != 0) {
+		UnmapViewOfFile (map);
+		return -1;
+	}
+#else
+	if ((fd = open (path, O_RDONLY)) < 0)
+		return -1;
+
+	if (fstat (fd, &st) != 0 || st.st_size <= 0 || (unsigned long long) st.st_size > (size_t) -1) {
+		close (fd);
+		return -1;
+	}
+
+	size	= (size_t) st.st_size;
+	map	= mmap (NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+
+	/* The mapping keeps the file open */
+	close (fd);
+
+	if (map == MAP_FAILED)
+		return -1;
+
+	if (_sca_ephemeris_cache_load (cache, map, size) != 0) {
+		munmap (map, size);
+		return -1;
+	}
+#endif
+
+	return 0;
+}
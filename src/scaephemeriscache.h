@@ -0,0 +1,483 @@
+/*
+ * Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+ */
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @file scaephemeriscache.h
+ * @brief Кэш эфемерид
+ * @author Александр Сапрыкин
+ *
+ * #SCAEphemerisCache хранит эклиптические координаты Солнца, Луны и планет в
+ * заданном интервале времени в виде кусочных полиномов Чебышёва. Интервал
+ * делится на сегменты одинаковой длины, для каждого сегмента коэффициенты
+ * рассчитываются по аналитическим рядам библиотеки. Запрос положения из кэша
+ * требует только выбора сегмента и нескольких умножений и сложений.
+ * @code
+ * SCAEphemerisCache	cache;
+ * SCAEpoch		epoch;
+ * SCAMoon		moon;
+ * double		err;
+ *
+ * sca_ephemeris_cache_new (&cache, jd_begin, jd_end);
+ * sca_ephemeris_cache_add (&cache, SCA_EPHEMERIS_MOON, 0.0, 0, &err);
+ *
+ * sca_epoch_new (&epoch, jd);
+ * sca_moon_update_cache (&moon, &epoch, &cache);
+ *
+ * sca_ephemeris_cache_free (&cache);
+ * @endcode
+ * После построения кэш не изменяется и может одновременно использоваться из
+ * нескольких потоков.
+ */
+#else
+/**
+ * @file scaephemeriscache.h
+ * @brief Cache of the ephemerides
+ * @author Alexander Saprykin
+ *
+ * #SCAEphemerisCache stores ecliptical coordinates of the Sun, the Moon and
+ * the planets within given time interval as piecewise Chebyshev polynomials.
+ * The interval is split into the segments of the same length, coefficients
+ * for every segment are calculated from the analytical series of the library.
+ * Position query from the cache requires only segment lookup and a few
+ * multiply-adds.
+ * @code
+ * SCAEphemerisCache	cache;
+ * SCAEpoch		epoch;
+ * SCAMoon		moon;
+ * double		err;
+ *
+ * sca_ephemeris_cache_new (&cache, jd_begin, jd_end);
+ * sca_ephemeris_cache_add (&cache, SCA_EPHEMERIS_MOON, 0.0, 0, &err);
+ *
+ * sca_epoch_new (&epoch, jd);
+ * sca_moon_update_cache (&moon, &epoch, &cache);
+ *
+ * sca_ephemeris_cache_free (&cache);
+ * @endcode
+ * Once built, the cache is not modified and may be used from several threads
+ * at the same time.
+ */
+#endif
+
+#if !defined (__SCALIB_H_INSIDE__) && !defined (SCALIB_COMPILATION)
+#  error "Header files shouldn't be included directly, consider using <scalib.h> instead."
+#endif
+
+#ifndef __SCAEPHEMERISCACHE_H__
+#define __SCAEPHEMERISCACHE_H__
+
+#include <stddef.h>
+
+#include <scamacros.h>
+#include <scaangle.h>
+
+SCA_BEGIN_DECLS
+
+#ifdef DOXYGEN_RUSSIAN
+/** Количество тел, которые могут храниться в кэше. */
+#else
+/** Number of the bodies which can be stored in the cache. */
+#endif
+#define SCA_EPHEMERIS_BODIES	11
+
+#ifdef DOXYGEN_RUSSIAN
+/** Максимальное количество коэффициентов Чебышёва в сегменте. */
+#else
+/** Maximum number of Chebyshev coefficients in a segment. */
+#endif
+#define SCA_EPHEMERIS_MAX_ORDER	32
+
+#ifdef DOXYGEN_RUSSIAN
+/** Версия формата файла эфемерид. */
+#else
+/** Version of the ephemerides file format. */
+#endif
+#define SCA_EPHEMERIS_FILE_VERSION	1
+
+#ifdef DOXYGEN_RUSSIAN
+/** Перечисление тел для кэша эфемерид. */
+#else
+/** Enum with bodies for the cache of the ephemerides. */
+#endif
+typedef enum _SCAEphemerisBody {
+#ifdef DOXYGEN_RUSSIAN
+	/** Геоцентрическое геометрическое положение Солнца.	*/
+#else
+	/** Geocentric geometric position of the Sun.		*/
+#endif
+	SCA_EPHEMERIS_SUN	= 0,
+#ifdef DOXYGEN_RUSSIAN
+	/** Геоцентрическое положение Луны.			*/
+#else
+	/** Geocentric position of the Moon.			*/
+#endif
+	SCA_EPHEMERIS_MOON	= 1,
+#ifdef DOXYGEN_RUSSIAN
+	/** Гелиоцентрическое положение Меркурия.		*/
+#else
+	/** Heliocentric position of the Mercury.		*/
+#endif
+	SCA_EPHEMERIS_MERCURY	= 2,
+#ifdef DOXYGEN_RUSSIAN
+	/** Гелиоцентрическое положение Венеры.			*/
+#else
+	/** Heliocentric position of the Venus.			*/
+#endif
+	SCA_EPHEMERIS_VENUS	= 3,
+#ifdef DOXYGEN_RUSSIAN
+	/** Гелиоцентрическое положение Земли.			*/
+#else
+	/** Heliocentric position of the Earth.			*/
+#endif
+	SCA_EPHEMERIS_EARTH	= 4,
+#ifdef DOXYGEN_RUSSIAN
+	/** Гелиоцентрическое положение Марса.			*/
+#else
+	/** Heliocentric position of the Mars.			*/
+#endif
+	SCA_EPHEMERIS_MARS	= 5,
+#ifdef DOXYGEN_RUSSIAN
+	/** Гелиоцентрическое положение Юпитера.		*/
+#else
+	/** Heliocentric position of the Jupiter.		*/
+#endif
+	SCA_EPHEMERIS_JUPITER	= 6,
+#ifdef DOXYGEN_RUSSIAN
+	/** Гелиоцентрическое положение Сатурна.		*/
+#else
+	/** Heliocentric position of the Saturn.		*/
+#endif
+	SCA_EPHEMERIS_SATURN	= 7,
+#ifdef DOXYGEN_RUSSIAN
+	/** Гелиоцентрическое положение Урана.			*/
+#else
+	/** Heliocentric position of the Uranus.		*/
+#endif
+	SCA_EPHEMERIS_URANUS	= 8,
+#ifdef DOXYGEN_RUSSIAN
+	/** Гелиоцентрическое положение Нептуна.		*/
+#else
+	/** Heliocentric position of the Neptune.		*/
+#endif
+	SCA_EPHEMERIS_NEPTUNE	= 9,
+#ifdef DOXYGEN_RUSSIAN
+	/** Нутация в долготе и наклоне.			*/
+#else
+	/** Nutation in longitude and obliquity.		*/
+#endif
+	SCA_EPHEMERIS_NUTATION	= 10
+} SCAEphemerisBody;
+
+#ifdef DOXYGEN_RUSSIAN
+/** Определение типа для полиномов одного тела. */
+#else
+/** Typedef for polynomials of a single body. */
+#endif
+typedef struct _SCAEphemerisSeries {
+#ifdef DOXYGEN_RUSSIAN
+	/** Длина сегмента в днях.					*/
+#else
+	/** Length of the segment in days.				*/
+#endif
+	double		segment;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Количество коэффициентов для каждой координаты.		*/
+#else
+	/** Number of the coefficients for every coordinate.		*/
+#endif
+	unsigned int	order;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Количество сегментов.					*/
+#else
+	/** Number of the segments.					*/
+#endif
+	size_t		count;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Максимальная проверенная ошибка в секундах дуги.		*/
+#else
+	/** Maximum verified error in arcseconds.			*/
+#endif
+	double		max_error;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Коэффициенты долготы, широты и расстояния для сегментов.	*/
+#else
+	/** Longitude, latitude and distance coefficients of segments.	*/
+#endif
+	const double	*coefs;
+} SCAEphemerisSeries;
+
+#ifdef DOXYGEN_RUSSIAN
+/** Определение типа для кэша эфемерид. */
+#else
+/** Typedef for cache of the ephemerides. */
+#endif
+typedef struct _SCAEphemerisCache {
+#ifdef DOXYGEN_RUSSIAN
+	/** Юлианский день начала интервала.	*/
+#else
+	/** Julian Day of the interval start.	*/
+#endif
+	double			jd_begin;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Юлианский день конца интервала.	*/
+#else
+	/** Julian Day of the interval end.	*/
+#endif
+	double			jd_end;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Полиномы для каждого тела.		*/
+#else
+	/** Polynomials for every body.		*/
+#endif
+	SCAEphemerisSeries	series[SCA_EPHEMERIS_BODIES];
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Отображённый в память файл, NULL для кэша в памяти.	*/
+#else
+	/** Memory-mapped file, NULL for the in-memory cache.	*/
+#endif
+	const void		*map;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Размер отображённого файла в байтах.		*/
+#else
+	/** Size of the mapped file in bytes.			*/
+#endif
+	size_t			map_size;
+} SCAEphemerisCache;
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Создаёт пустой кэш эфемерид для заданного интервала.
+ * @param[out] cache Структура #SCAEphemerisCache для инициализации.
+ * @param jd_begin Юлианский день начала интервала.
+ * @param jd_end Юлианский день конца интервала.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Тела добавляются в кэш функцией sca_ephemeris_cache_add(). Память, выделенная
+ * для кэша, должна быть освобождена функцией sca_ephemeris_cache_free().
+ */
+#else
+/**
+ * @brief Creates empty cache of the ephemerides for given interval.
+ * @param[out] cache #SCAEphemerisCache structure to initialize.
+ * @param jd_begin Julian Day of the interval start.
+ * @param jd_end Julian Day of the interval end.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Bodies are added into the cache with sca_ephemeris_cache_add(). Memory
+ * allocated for the cache must be freed with sca_ephemeris_cache_free().
+ */
+#endif
+int		sca_ephemeris_cache_new		(SCAEphemerisCache *cache, double jd_begin, double jd_end);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Освобождает память, выделенную для кэша эфемерид.
+ * @param cache Кэш для освобождения.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Frees memory allocated for the cache of the ephemerides.
+ * @param cache Cache to free.
+ * @since 0.0.2
+ */
+#endif
+void		sca_ephemeris_cache_free	(SCAEphemerisCache *cache);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает полиномы для тела и добавляет их в кэш.
+ * @param cache Кэш эфемерид.
+ * @param body Тело для добавления.
+ * @param segment Длина сегмента в днях, 0 - значение по умолчанию для тела.
+ * @param order Количество коэффициентов для каждой координаты (не больше
+ * #SCA_EPHEMERIS_MAX_ORDER), 0 - значение по умолчанию для тела.
+ * @param[out] max_error Максимальная ошибка в секундах дуги, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Ошибка проверяется сравнением с аналитическими рядами в нескольких точках
+ * между узлами Чебышёва каждого сегмента. Ошибка расстояния учитывается
+ * относительно самого расстояния, то есть 1 секунда дуги соответствует
+ * примерно 5e-6 расстояния. Значения по умолчанию подбираются для каждого тела:
+ * например, сегменты длиной 8 дней для Луны и 32 дня для Солнца, ошибка при этом
+ * не превышает 0.001 секунды дуги. Если тело уже есть в кэше, его полиномы
+ * рассчитываются заново. Для планет без данных VSOP87 и для кэша, открытого
+ * функцией sca_ephemeris_cache_open(), функция возвращает ошибку.
+ */
+#else
+/**
+ * @brief Calculates polynomials for the body and adds them into the cache.
+ * @param cache Cache of the ephemerides.
+ * @param body Body to add.
+ * @param segment Length of the segment in days, 0 for the body default.
+ * @param order Number of the coefficients for every coordinate (not greater
+ * than #SCA_EPHEMERIS_MAX_ORDER), 0 for the body default.
+ * @param[out] max_error Maximum error in arcseconds, may be NULL.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * The error is verified against the analytical series at several points
+ * between the Chebyshev nodes of every segment. Error of the distance is
+ * relative to the distance itself, i.e. 1 arcsecond corresponds to about
+ * 5e-6 of the distance. Default values are selected per body: e.g. segments
+ * of 8 days for the Moon and of 32 days for the Sun, the error doesn't exceed
+ * 0.001 arcseconds in such case. If the body is already in the cache its polynomials are
+ * calculated again. Fails for the planets without VSOP87 data and for the
+ * cache opened with sca_ephemeris_cache_open().
+ */
+#endif
+int		sca_ephemeris_cache_add		(SCAEphemerisCache	*cache,
+						 SCAEphemerisBody	body,
+						 double			segment,
+						 unsigned int		order,
+						 double			*max_error);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Проверяет, есть ли тело в кэше.
+ * @param cache Кэш эфемерид.
+ * @param body Тело для проверки.
+ * @return TRUE, если тело есть в кэше, иначе FALSE.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Checks whether the body is in the cache.
+ * @param cache Cache of the ephemerides.
+ * @param body Body to check.
+ * @return TRUE if the body is in the cache, FALSE otherwise.
+ * @since 0.0.2
+ */
+#endif
+int		sca_ephemeris_cache_has_body	(const SCAEphemerisCache *cache, SCAEphemerisBody body);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Возвращает эклиптические координаты тела из кэша.
+ * @param cache Кэш эфемерид.
+ * @param body Тело.
+ * @param jd Юлианский день внутри интервала кэша.
+ * @param[out] lon Эклиптическая долгота, может быть NULL.
+ * @param[out] lat Эклиптическая широта, может быть NULL.
+ * @param[out] dst Расстояние в АЕ, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Координаты соответствуют sca_planet_data_get() для планет и положению
+ * до учёта нутации и аберрации для Солнца и Луны. Для #SCA_EPHEMERIS_NUTATION
+ * возвращаются нутация в долготе (@a lon) и в наклоне (@a lat).
+ */
+#else
+/**
+ * @brief Gets ecliptical coordinates of the body from the cache.
+ * @param cache Cache of the ephemerides.
+ * @param body Body.
+ * @param jd Julian Day within the cache interval.
+ * @param[out] lon Ecliptical longitude, may be NULL.
+ * @param[out] lat Ecliptical latitude, may be NULL.
+ * @param[out] dst Distance in AUs, may be NULL.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Coordinates correspond to sca_planet_data_get() for the planets and to the
+ * position before nutation and aberration for the Sun and the Moon. Nutation
+ * in longitude (@a lon) and in obliquity (@a lat) is returned for
+ * #SCA_EPHEMERIS_NUTATION.
+ */
+#endif
+int		sca_ephemeris_cache_get		(const SCAEphemerisCache	*cache,
+						 SCAEphemerisBody		body,
+						 double				jd,
+						 SCAAngle			*lon,
+						 SCAAngle			*lat,
+						 double				*dst);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Сохраняет кэш эфемерид в файл.
+ * @param cache Кэш эфемерид.
+ * @param path Путь к файлу.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Файл содержит заголовок, таблицу тел и коэффициенты в формате текущей
+ * платформы, выровненные по 64 байтам. Файл может быть загружен функцией
+ * sca_ephemeris_cache_open() на платформе с тем же порядком байтов.
+ */
+#else
+/**
+ * @brief Saves cache of the ephemerides into the file.
+ * @param cache Cache of the ephemerides.
+ * @param path Path to the file.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * The file contains header, table of the bodies and coefficients in the
+ * native format of the platform aligned to 64 bytes. The file can be loaded
+ * with sca_ephemeris_cache_open() on a platform with the same byte order.
+ */
+#endif
+int		sca_ephemeris_cache_save	(const SCAEphemerisCache *cache, const char *path);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Открывает файл эфемерид, отображая его в память.
+ * @param[out] cache Структура #SCAEphemerisCache для инициализации.
+ * @param path Путь к файлу, созданному sca_ephemeris_cache_save().
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Файл не копируется и не разбирается: коэффициенты читаются напрямую из
+ * отображённых страниц, поэтому несколько процессов используют одну копию
+ * файла в страничном кэше. Проверяются только заголовок и границы таблиц.
+ * Функция не выделяет память в куче. Файл должен быть закрыт функцией
+ * sca_ephemeris_cache_free(), добавлять в такой кэш новые тела нельзя.
+ */
+#else
+/**
+ * @brief Opens the ephemerides file mapping it into the memory.
+ * @param[out] cache #SCAEphemerisCache structure to initialize.
+ * @param path Path to the file created by sca_ephemeris_cache_save().
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * The file is neither copied nor parsed: coefficients are read directly
+ * from the mapped pages, so several processes share a single copy of the
+ * file in the page cache. Only the header and bounds of the tables are
+ * verified. The routine doesn't allocate heap memory. The file must be
+ * closed with sca_ephemeris_cache_free(), no bodies can be added into such
+ * cache.
+ */
+#endif
+int		sca_ephemeris_cache_open	(SCAEphemerisCache *cache, const char *path);
+
+SCA_END_DECLS
+
+#endif /* __SCAEPHEMERISCACHE_H__ */
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+ */
+
+#include "scaepoch.h"
+#include "scaearth.h"
+#include "scajulianday.h"
+#include "scasun.h"
+#include "scaprivate.h"
+
+static void
+_sca_epoch_init (SCAEpoch *epoch, double jd)
+{
+	epoch->jd = jd;
+
+	sca_earth_get_ecliptic_obliquity (jd, &epoch->obl);
+	sca_angle_get_sincos (epoch->obl, &epoch->sin_obl, &epoch->cos_obl);
+
+	epoch->true_obl = epoch->obl + epoch->nut_obl;
+
+	/* The same correction as in sca_jd_get_sidereal_time() */
+	epoch->sidereal = sca_jd_get_mean_sidereal_time (jd)
+			+ sca_angle_from_degrees (0, 0, 0, epoch->nut_lon * 3600.0 * epoch->cos_obl * 1000.0);
+	sca_angle_reduce (&epoch->sidereal);
+
+	sca_sun_get_true_longitude (jd, &epoch->sun_lon);
+	sca_earth_get_orbit_eccentricity (jd, &epoch->eccentricity);
+	sca_earth_get_perihelion_longitude (jd, &epoch->perihelion);
+}
+
+int
+sca_epoch_new (SCAEpoch *epoch, double jd)
+{
+	/* NaN must fail too, so the comparison is inverted */
+	if (epoch == NULL || !(jd >= 0))
+		return -1;
+
+	sca_earth_get_nutation (jd, &epoch->nut_lon, &epoch->nut_obl);
+	_sca_epoch_init (epoch, jd);
+
+	return 0;
+}
+
+int
+sca_epoch_new_cache (SCAEpoch *epoch, double jd, const SCAEphemerisCache *cache)
+{
+	/* NaN must fail too, so the comparison is inverted */
+	if (epoch == NULL || !(jd >= 0))
+		return -1;
+
+	if (sca_ephemeris_cache_get (cache, SCA_EPHEMERIS_NUTATION, jd, &epoch->nut_lon, &epoch->nut_obl, NULL) != 0)
+		return -1;
+
+	_sca_epoch_init (epoch, jd);
+
+	return 0;
+}
+
+int
+sca_epoch_new_stepper (SCAEpoch *epoch, const SCATimeStepper *stepper)
+{
+	if (epoch == NULL || stepper == NULL)
+		return -1;
+
+	if (sca_time_stepper_get (stepper, SCA_EPHEMERIS_NUTATION, &epoch->nut_lon, &epoch->nut_obl, NULL) != 0)
+		return -1;
+
+	_sca_epoch_init (epoch, stepper->jd);
+
+	return 0;
+}
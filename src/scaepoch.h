@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+ */
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @file scaepoch.h
+ * @brief Контекст расчётов на заданный момент времени
+ * @author Александр Сапрыкин
+ *
+ * #SCAEpoch хранит величины, которые зависят только от момента времени: нутацию,
+ * наклон эклиптики, звёздное время и параметры орбиты Земли. Если нужно рассчитать
+ * положение многих объектов на один и тот же момент времени, то лучше один раз
+ * проинициализировать #SCAEpoch и передавать его в функции с суффиксом _ctx:
+ * @code
+ * SCAEpoch	epoch;
+ * SCADate	date;
+ * SCASun	sun;
+ * SCAStar	stars[100];
+ * int		i;
+ *
+ * sca_epoch_new (&epoch, sca_jd_from_calendar_date (&date));
+ *
+ * sca_sun_update_ctx (&sun, &epoch);
+ *
+ * for (i = 0; i < 100; ++i)
+ *	sca_star_update_ctx (&stars[i], &epoch);
+ * @endcode
+ * Результаты функций с суффиксом _ctx совпадают с результатами соответствующих
+ * функций без него.
+ */
+#else
+/**
+ * @file scaepoch.h
+ * @brief Calculation context for given instance of time
+ * @author Alexander Saprykin
+ *
+ * #SCAEpoch holds values which depend only on the instance of time: nutation,
+ * obliquity of the ecliptic, sidereal time and the Earth's orbit elements.
+ * If you need to calculate positions of many objects for the same instance
+ * of time, initialize #SCAEpoch once and pass it to the routines with _ctx
+ * suffix:
+ * @code
+ * SCAEpoch	epoch;
+ * SCADate	date;
+ * SCASun	sun;
+ * SCAStar	stars[100];
+ * int		i;
+ *
+ * sca_epoch_new (&epoch, sca_jd_from_calendar_date (&date));
+ *
+ * sca_sun_update_ctx (&sun, &epoch);
+ *
+ * for (i = 0; i < 100; ++i)
+ *	sca_star_update_ctx (&stars[i], &epoch);
+ * @endcode
+ * Results of the _ctx routines are the same as for corresponding routines
+ * without suffix.
+ */
+#endif
+
+#if !defined (__SCALIB_H_INSIDE__) && !defined (SCALIB_COMPILATION)
+#  error "Header files shouldn't be included directly, consider using <scalib.h> instead."
+#endif
+
+#ifndef __SCAEPOCH_H__
+#define __SCAEPOCH_H__
+
+#include <scamacros.h>
+#include <scaangle.h>
+#include <scaephemeriscache.h>
+#include <scatimestepper.h>
+
+SCA_BEGIN_DECLS
+
+#ifdef DOXYGEN_RUSSIAN
+/** Определение типа для контекста расчётов. */
+#else
+/** Typedef for calculation context. */
+#endif
+typedef struct _SCAEpoch {
+#ifdef DOXYGEN_RUSSIAN
+	/** Юлианский день контекста.				*/
+#else
+	/** Julian Day of the context.				*/
+#endif
+	double		jd;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Нутация по долготе.					*/
+#else
+	/** Nutation in longitude.				*/
+#endif
+	SCAAngle	nut_lon;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Нутация по наклону эклиптики.			*/
+#else
+	/** Nutation in obliquity.				*/
+#endif
+	SCAAngle	nut_obl;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Средний наклон эклиптики.				*/
+#else
+	/** Mean obliquity of the ecliptic.			*/
+#endif
+	SCAAngle	obl;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Истинный наклон эклиптики (с учётом нутации).	*/
+#else
+	/** True obliquity of the ecliptic (with nutation).	*/
+#endif
+	SCAAngle	true_obl;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Синус среднего наклона эклиптики.			*/
+#else
+	/** Sine of the mean obliquity.				*/
+#endif
+	double		sin_obl;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Косинус среднего наклона эклиптики.			*/
+#else
+	/** Cosine of the mean obliquity.			*/
+#endif
+	double		cos_obl;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Гринвичское истинное звёздное время.		*/
+#else
+	/** Apparent sidereal time at Greenwich.		*/
+#endif
+	SCAAngle	sidereal;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Геометрическая истинная долгота Солнца.		*/
+#else
+	/** Geometric true longitude of the Sun.		*/
+#endif
+	SCAAngle	sun_lon;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Эксцентриситет орбиты Земли.			*/
+#else
+	/** Earth's orbit eccentricity.				*/
+#endif
+	double		eccentricity;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Долгота перигелия орбиты Земли.			*/
+#else
+	/** Earth's orbit perihelion longitude.			*/
+#endif
+	SCAAngle	perihelion;
+} SCAEpoch;
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Инициализирует контекст расчётов для заданного момента времени.
+ * @param[out] epoch Структура #SCAEpoch для инициализации.
+ * @param jd Юлианский день, соответствующий времени расчёта.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Initializes calculation context for given instance of time.
+ * @param[out] epoch #SCAEpoch structure to initialize.
+ * @param jd Julian Day corresponding to calculation instance.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ */
+#endif
+int		sca_epoch_new			(SCAEpoch *epoch, double jd);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Инициализирует контекст расчётов, используя нутацию из кэша эфемерид.
+ * @param[out] epoch Структура #SCAEpoch для инициализации.
+ * @param jd Юлианский день, соответствующий времени расчёта.
+ * @param cache Кэш эфемерид, содержащий #SCA_EPHEMERIS_NUTATION.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Возвращает ошибку, если момент времени находится вне интервала кэша.
+ */
+#else
+/**
+ * @brief Initializes calculation context using nutation from the cache of the
+ * ephemerides.
+ * @param[out] epoch #SCAEpoch structure to initialize.
+ * @param jd Julian Day corresponding to calculation instance.
+ * @param cache Cache of the ephemerides containing #SCA_EPHEMERIS_NUTATION.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Fails if the instance of time is outside of the cache interval.
+ */
+#endif
+int		sca_epoch_new_cache		(SCAEpoch *epoch, double jd, const SCAEphemerisCache *cache);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Инициализирует контекст расчётов для текущего шага расчёта с
+ * постоянным шагом.
+ * @param[out] epoch Структура #SCAEpoch для инициализации.
+ * @param stepper Расчёт с постоянным шагом, содержащий #SCA_EPHEMERIS_NUTATION.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Initializes calculation context for the current step of the
+ * calculations with a fixed time step.
+ * @param[out] epoch #SCAEpoch structure to initialize.
+ * @param stepper Calculations with a fixed time step containing
+ * #SCA_EPHEMERIS_NUTATION.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ */
+#endif
+int		sca_epoch_new_stepper		(SCAEpoch *epoch, const SCATimeStepper *stepper);
+
+SCA_END_DECLS
+
+#endif /* __SCAEPOCH_H__ */
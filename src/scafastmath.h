@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+ */
+
+/**
+ * Private branch-free trigonometric kernels. All the routines are inline and
+ * contain no calls and no data dependent branches, so the compiler is able to
+ * vectorize loops which use them. Arguments are in radians.
+ *
+ * Sine and Cosine use Cody-Waite reduction by Pi/2 and minimax polynomials on
+ * [-Pi/4, Pi/4], Arctangent is reduced to [-tan (Pi/8), tan (Pi/8)] and
+ * summed as a series. Vector versions are obtained by the compiler from loops
+ * over arrays in the kernels which are compiled for several instruction sets
+ * (see _sca_planet_data_kernel()), so there are no separate SIMD routines.
+ *
+ * Maximum error (measured against libm, sca_bench --check math_*):
+ * 	sin, cos	- 3e-16 absolute for |x| <= #SCA_FAST_MAX_ARG;
+ * 	atan2		- 1e-14 radians;
+ * 	asin		- 1e-14 radians.
+ *
+ * This is far below the 1 arcsecond (5e-6 radians) the library aims at, but
+ * polynomials of lower degree would save only a couple of multiplications,
+ * while the gain over libm comes from inlining and vectorization.
+ *
+ * Scalar code calls sca_math_*() routines for Sine and Cosine, which
+ * are libm by default and the fast kernels if the library is built with
+ * SCA_ENABLE_FAST_MATH=ON. The option changes the results of the public
+ * routines in the last bits, so it is off unless requested. Scalar code
+ * always uses libm tan(), atan2() and asin(): a Tangent from the Sine and
+ * Cosine kernel is not faster than libm, Arctangent and Arcsine are faster
+ * only when the loop is vectorized. They are used in the star catalog and
+ * batch local coordinates kernels, where with AVX2 or AVX-512 they are about
+ * 4.5 (atan2) and 2 (asin) times faster than libm, see sca_bench
+ * math_*_array_*. With SSE2 only Arctangent is still faster.
+ */
+
+#ifndef __SCAFASTMATH_H__
+#define __SCAFASTMATH_H__
+
+#include <math.h>
+
+#if defined (_MSC_VER)
+#  define SCA_INLINE		static __inline
+#  define SCA_RESTRICT		__restrict
+#else
+#  define SCA_INLINE		static inline
+#  define SCA_RESTRICT		__restrict__
+#endif
+
+/* Kernels are inlined into the wrappers compiled for different instruction sets */
+#if defined (__GNUC__)
+#  define SCA_ALWAYS_INLINE	SCA_INLINE __attribute__ ((always_inline))
+#else
+#  define SCA_ALWAYS_INLINE	SCA_INLINE
+#endif
+
+/*
+ * Maximum argument of Sine and Cosine: up to 2^20 * Pi/2 the product of the
+ * quotient and SCA_FAST_PIO2_HI (33 significant bits) is exact, beyond it
+ * reduction by Pi/2 loses accuracy
+ */
+#define SCA_FAST_MAX_ARG	1.6e6
+
+/* M_PI is not a part of the C standard */
+#define SCA_FAST_PI		3.14159265358979323846
+
+/* Two parts of Pi/2 for Cody-Waite argument reduction */
+#define SCA_FAST_PIO2_HI	1.57079632673412561417e+00
+#define SCA_FAST_PIO2_LO	6.07710050650619224932e-11
+#define SCA_FAST_2_OVER_PI	6.36619772367581382433e-01
+/* Adding and substracting 1.5 * 2^52 rounds to the nearest integer */
+#define SCA_FAST_ROUND_MAGIC	6755399441055744.0
+
+/**
+ * @brief Calculates both Sine and Cosine of the argument.
+ * @param x Argument in radians.
+ * @param sin_out Output Sine value.
+ * @param cos_out Output Cosine value.
+ * @since 0.0.2
+ */
+SCA_INLINE void
+sca_fast_sincos (double x, double *sin_out, double *cos_out)
+{
+	double	k, r, z, s, c;
+	int	q;
+
+	k = (x * SCA_FAST_2_OVER_PI + SCA_FAST_ROUND_MAGIC) - SCA_FAST_ROUND_MAGIC;
+	q = (int) k;
+	r = (x - k * SCA_FAST_PIO2_HI) - k * SCA_FAST_PIO2_LO;
+	z = r * r;
+
+	/* Minimax polynomials on [-Pi/4, Pi/4] from fdlibm */
+	s = r + r * z * (-1.66666666666666324348e-01
+		+ z * (8.33333333332248946124e-03
+		+ z * (-1.98412698298579493134e-04
+		+ z * (2.75573137070700676789e-06
+		+ z * (-2.50507602534068634195e-08
+		+ z * 1.58969099521155010221e-10)))));
+
+	c = 1.0 - 0.5 * z + z * z * (4.16666666666666019037e-02
+		+ z * (-1.38888888888741095749e-03
+		+ z * (2.48015872894767294178e-05
+		+ z * (-2.75573143513906633035e-07
+		+ z * (2.08757232129817482790e-09
+		+ z * -1.13596475577881948265e-11)))));
+
+	/* Select quadrant */
+	*sin_out = (q & 1) ? c : s;
+	*cos_out = (q & 1) ? s : c;
+
+	*sin_out = (q & 2) ? -(*sin_out) : *sin_out;
+	*cos_out = ((q + 1) & 2) ? -(*cos_out) : *cos_out;
+}
+
+/**
+ * @brief Calculates Arctangent for the argument within [0, 1].
+ * @param a Argument.
+ * @return Arctangent of @a a.
+ * @since 0.0.2
+ */
+SCA_INLINE double
+sca_fast_atan_unit (double a)
+{
+	double	r, z, p, big;
+
+	/* Reduce to |r| <= tan (Pi/8) using atan (a) = Pi/4 + atan ((a - 1) / (a + 1)) */
+	big = (a > 0.41421356237309504880) ? 1.0 : 0.0;
+	r = (a - big) / (1.0 + big * a);
+	z = r * r;
+
+	/* Taylor series, the first dropped term is below 1e-14 */
+	p = 1.0 / 31.0;
+	p = 1.0 / 29.0 - z * p;
+	p = 1.0 / 27.0 - z * p;
+	p = 1.0 / 25.0 - z * p;
+	p = 1.0 / 23.0 - z * p;
+	p = 1.0 / 21.0 - z * p;
+	p = 1.0 / 19.0 - z * p;
+	p = 1.0 / 17.0 - z * p;
+	p = 1.0 / 15.0 - z * p;
+	p = 1.0 / 13.0 - z * p;
+	p = 1.0 / 11.0 - z * p;
+	p = 1.0 / 9.0 - z * p;
+	p = 1.0 / 7.0 - z * p;
+	p = 1.0 / 5.0 - z * p;
+	p = 1.0 / 3.0 - z * p;
+	p = 1.0 - z * p;
+
+	return big * (SCA_FAST_PI / 4.0) + r * p;
+}
+
+/**
+ * @brief Calculates Arctangent of @a y / @a x using signs of both
+ * arguments to determine the quadrant.
+ * @param y Ordinate.
+ * @param x Abscissa.
+ * @return Angle in radians within [-Pi, Pi].
+ * @since 0.0.2
+ */
+SCA_INLINE double
+sca_fast_atan2 (double y, double x)
+{
+	double	ax, ay, mx, mn, t;
+
+	ax = fabs (x);
+	ay = fabs (y);
+	mx = (ax > ay) ? ax : ay;
+	mn = (ax > ay) ? ay : ax;
+
+	/* Division is not conditional, otherwise the loop can't be vectorized */
+	t = sca_fast_atan_unit (mn / ((mx > 0.0) ? mx : 1.0));
+	t = (ay > ax) ? (SCA_FAST_PI / 2.0) - t : t;
+	t = (x < 0.0) ? SCA_FAST_PI - t : t;
+
+	return (y < 0.0) ? -t : t;
+}
+
+/**
+ * @brief Calculates Arcsine of the argument.
+ * @param x Argument within [-1, 1].
+ * @return Angle in radians within [-Pi/2, Pi/2].
+ * @since 0.0.2
+ */
+SCA_INLINE double
+sca_fast_asin (double x)
+{
+	return sca_fast_atan2 (x, sqrt ((1.0 - x) * (1.0 + x)));
+}
+
+/**
+ * @brief Calculates Sine of the argument for scalar code.
+ * @param x Argument in radians, |x| <= #SCA_FAST_MAX_ARG.
+ * @return Sine of @a x.
+ * @since 0.0.2
+ */
+SCA_INLINE double
+sca_math_sin (double x)
+{
+#ifdef SCA_ENABLE_FAST_MATH
+	double	s, c;
+
+	sca_fast_sincos (x, &s, &c);
+
+	return s;
+#else
+	return sin (x);
+#endif
+}
+
+/**
+ * @brief Calculates Cosine of the argument for scalar code.
+ * @param x Argument in radians, |x| <= #SCA_FAST_MAX_ARG.
+ * @return Cosine of @a x.
+ * @since 0.0.2
+ */
+SCA_INLINE double
+sca_math_cos (double x)
+{
+#ifdef SCA_ENABLE_FAST_MATH
+	double	s, c;
+
+	sca_fast_sincos (x, &s, &c);
+
+	return c;
+#else
+	return cos (x);
+#endif
+}
+
+/**
+ * @brief Calculates both Sine and Cosine of the argument for scalar code.
+ * @param x Argument in radians, |x| <= #SCA_FAST_MAX_ARG.
+ * @param sin_out Output Sine value.
+ * @param cos_out Output Cosine value.
+ * @since 0.0.2
+ */
+SCA_INLINE void
+sca_math_sincos (double x, double *sin_out, double *cos_out)
+{
+#ifdef SCA_ENABLE_FAST_MATH
+	sca_fast_sincos (x, sin_out, cos_out);
+#else
+	*sin_out = sin (x);
+	*cos_out = cos (x);
+#endif
+}
+
+#endif /* __SCAFASTMATH_H__ */
@@ -16,103 +16,478 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
  */
 
-#ifndef HAVE_TRUNC_DECL
-  extern double trunc (double x);
-#endif
-
 #include <math.h>
 #include <stdlib.h>
 
 #include <scajulianday.h>
 #include <scaearth.h>
 #include <scamisc.h>
+#include <scaprivate.h>
+#include <scafastmath.h>
+
+/* Number of the instances processed at once when some of the outputs are not needed */
+#define SCA_JD_BLOCK			256
+
+typedef void (*SCAJDToCalendarKernel) (const double	*jds,
+				       size_t		count,
+				       int		*years,
+				       SCAMonth		*months,
+				       double		*days);
+
+typedef void (*SCAJDFromCalendarKernel) (const int	*years,
+					 const SCAMonth	*months,
+					 const double	*days,
+					 size_t		count,
+					 double		*jds);
+
+/**
+ * @brief Checks whether the date belongs to the Gregorian calendar.
+ * @param year Calendar year.
+ * @param month Calendar month.
+ * @param day Calendar day.
+ * @return 1 for the Gregorian calendar (since October 15, 1582), 0 otherwise.
+ * @since 0.0.2
+ */
+SCA_ALWAYS_INLINE int
+_sca_jd_is_gregorian_date (int year, int month, double day)
+{
+	return (year > 1582) | ((year == 1582) & ((month > SCA_MONTH_OCTOBER) |
+						  ((month == SCA_MONTH_OCTOBER) & (day >= 15.0))));
+}
+
+/**
+ * @brief Checks whether the year is a leap one.
+ * @param year Calendar year.
+ * @return 1 for a leap year, 0 otherwise.
+ * @since 0.0.2
+ *
+ * Julian calendar leap years are used before 1583, the same as in
+ * sca_jd_from_calendar_date().
+ */
+SCA_ALWAYS_INLINE int
+_sca_jd_is_leap_year (int year)
+{
+	return (year % 4 == 0) & ((year < 1583) | (year % 100 != 0) | (year % 400 == 0));
+}
+
+/**
+ * @brief Calculates Julian Day from calendar date.
+ * @param year Calendar year.
+ * @param month Calendar month.
+ * @param day Calendar day.
+ * @return Julian Day, 0 for the years before -4712.
+ * @since 0.0.2
+ *
+ * Integer form of Meeus' formula (7.1): trunc (365.25 * x) is (1461 * x) / 4
+ * for x >= 0, and trunc (30.6001 * x) is (306001 * x) / 10000. Whole parts
+ * are added in the same order as in the floating point form, so the result
+ * is bit-identical to it.
+ */
+SCA_ALWAYS_INLINE double
+_sca_jd_from_calendar (int year, int month, double day)
+{
+	int	Y, M, A, B, days;
+
+	Y = (month <= SCA_MONTH_FEBRUARY) ? year - 1 : year;
+	M = (month <= SCA_MONTH_FEBRUARY) ? month + 12 : month;
+	A = Y / 100;
+	B = _sca_jd_is_gregorian_date (year, month, day) ? 2 - A + (A / 4) : 0;
+
+	days = (1461 * (Y + 4716)) / 4 + (306001 * (M + 1)) / 10000;
+
+	return (year < -4712) ? 0.0 : (double) days + day + B - 1524.5;
+}
+
+/**
+ * @brief Converts a whole Julian Day number to calendar date.
+ * @param Z Julian Day number, i.e. Julian Day + 0.5 rounded down.
+ * @param[out] year Calendar year.
+ * @param[out] month Calendar month.
+ * @param[out] day Calendar day without the time.
+ * @since 0.0.2
+ *
+ * Integer form of Meeus' algorithm (chapter 7), every floating point division
+ * is replaced by the exact integer one. Intermediate values fit 32 bits for
+ * the years up to 200000.
+ */
+SCA_ALWAYS_INLINE void
+_sca_jd_to_calendar (int Z, int *year, int *month, int *day)
+{
+	int	alpha, A, B, C, D, E;
+
+	alpha	= (4 * Z - 7468865) / 146097;
+	A	= (Z < 2299161) ? Z : Z + 1 + alpha - alpha / 4;
+	B	= A + 1524;
+	C	= (20 * B - 2442) / 7305;
+	D	= (1461 * C) / 4;
+	E	= (10000 * (B - D)) / 306001;
+
+	*day	= B - D - (306001 * E) / 10000;
+	*month	= (E < 14) ? E - 1 : E - 13;
+	*year	= (*month > SCA_MONTH_FEBRUARY) ? C - 4716 : C - 4715;
+}
+
+/**
+ * @brief Calculates the number of the day in the year.
+ * @param year Calendar year.
+ * @param month Calendar month.
+ * @param day Calendar day (including time).
+ * @return Number of the day in the year.
+ * @since 0.0.2
+
+ */
+SCA_ALWAYS_INLINE int
+_sca_jd_get_day_of_year (int year, int month, double day)
+{
+	int	K;
+
+	K = 2 - _sca_jd_is_leap_year (year);
+
+	return (int) ((double) ((275 * month) / 9 - K * ((month + 9) / 12)) + day - 30.0);
+}
+
+SCA_ALWAYS_INLINE void
+_sca_jd_to_calendar_kernel (const double	* SCA_RESTRICT	jds,
+			    size_t			count,
+			    int		* SCA_RESTRICT	years,
+			    SCAMonth	* SCA_RESTRICT	months,
+			    double	* SCA_RESTRICT	days)
+{
+	size_t	i;
 
+	for (i = 0; i < count; ++i) {
+		double	jd;
+		int	Z, year, month, day;
+
+		jd = jds[i] + 0.5;
+		Z  = (int) jd;
+
+		_sca_jd_to_calendar (Z, &year, &month, &day);
+
+		years[i]	= year;
+		months[i]	= (SCAMonth) month;
+		days[i]		= (double) day + (jd - Z);
+	}
+}
+
+SCA_ALWAYS_INLINE void
+_sca_jd_from_calendar_kernel (const int		* SCA_RESTRICT	years,
+			      const SCAMonth	* SCA_RESTRICT	months,
+			      const double	* SCA_RESTRICT	days,
+			      size_t				count,
+			      double		* SCA_RESTRICT	jds)
+{
+	size_t	i;
+
+	for (i = 0; i < count; ++i)
+		jds[i] = _sca_jd_from_calendar (years[i], (int) months[i], days[i]);
+}
+
+static void
+_sca_jd_to_calendar_kernel_generic (const double	*jds,
+				    size_t		count,
+				    int			*years,
+				    SCAMonth		*months,
+				    double		*days)
+{
+	_sca_jd_to_calendar_kernel (jds, count, years, months, days);
+}
+
+static void
+_sca_jd_from_calendar_kernel_generic (const int		*years,
+				      const SCAMonth	*months,
+				      const double	*days,
+				      size_t		count,
+				      double		*jds)
+{
+	_sca_jd_from_calendar_kernel (years, months, days, count, jds);
+}
+
+#ifdef HAVE_CPU_DISPATCH
+__attribute__ ((target ("avx2,fma"))) static void
+_sca_jd_to_calendar_kernel_avx2 (const double	*jds,
+				 size_t		count,
+				 int		*years,
+				 SCAMonth	*months,
+				 double		*days)
+{
+	_sca_jd_to_calendar_kernel (jds, count, years, months, days);
+}
+
+__attribute__ ((target ("avx2,fma"))) static void
+_sca_jd_from_calendar_kernel_avx2 (const int		*years,
+				   const SCAMonth	*months,
+				   const double		*days,
+				   size_t		count,
+				   double		*jds)
+{
+	_sca_jd_from_calendar_kernel (years, months, days, count, jds);
+}
+
+__attribute__ ((target ("avx512f"))) static void
+_sca_jd_to_calendar_kernel_avx512 (const double	*jds,
+				   size_t		count,
+				   int			*years,
+				   SCAMonth		*months,
+				   double		*days)
+{
+	_sca_jd_to_calendar_kernel (jds, count, years, months, days);
+}
+
+__attribute__ ((target ("avx512f"))) static void
+_sca_jd_from_calendar_kernel_avx512 (const int		*years,
+				     const SCAMonth	*months,
+				     const double	*days,
+				     size_t		count,
+				     double		*jds)
+{
+	_sca_jd_from_calendar_kernel (years, months, days, count, jds);
+}
+#endif
+
+/**
+ * @brief Selects the best kernel of conversion to calendar dates for the
+ * current CPU.
+ * @return Kernel to use.
+ * @since 0.0.2
+ *
+ * The choice is not cached: __builtin_cpu_supports() only reads the CPU
+ * model filled in by the runtime at startup, so concurrent calls don't race.
+ */
+static SCAJDToCalendarKernel
+_sca_jd_get_to_calendar_kernel (void)
+{
+#ifdef HAVE_CPU_DISPATCH
+	if (__builtin_cpu_supports ("avx512f"))
+		return _sca_jd_to_calendar_kernel_avx512;
+	else if (__builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma"))
+		return _sca_jd_to_calendar_kernel_avx2;
+#endif
+
+	return _sca_jd_to_calendar_kernel_generic;
+}
+
+/**
+ * @brief Selects the best kernel of conversion from calendar dates for the
+ * current CPU.
+ * @return Kernel to use.
+ * @since 0.0.2
+ */
+static SCAJDFromCalendarKernel
+_sca_jd_get_from_calendar_kernel (void)
+{
+#ifdef HAVE_CPU_DISPATCH
+	if (__builtin_cpu_supports ("avx512f"))
+		return _sca_jd_from_calendar_kernel_avx512;
+	else if (__builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma"))
+		return _sca_jd_from_calendar_kernel_avx2;
+#endif
+
+	return _sca_jd_from_calendar_kernel_generic;
+}
+
+/**
+ * @brief Checks the array of Julian Days for negative values.
+ * @param jds Array of Julian Days.
+ * @param n Number of the Julian Days.
+ * @return 0 if all the Julian Days are not negative, -1 otherwise.
+ * @since 0.0.2
+ */
 static int
-_sca_jd_is_gregorian_date (const SCADate *date)
+_sca_jd_check_many (const double *jds, size_t n)
 {
-	if (date->year > 1582)
-		return 1;
-	else if (date->year < 1582)
-		return 0;
-	else if (date->month > SCA_MONTH_OCTOBER)
-		return 1;
-	else if (date->month < SCA_MONTH_OCTOBER)
-		return 0;
-	else if (date->day >= 15.0)
-		return 1;
-	else
-		return 0;
+	size_t	i;
+	int	negative;
+
+	negative = 0;
+
+	for (i = 0; i < n; ++i)
+		negative |= (jds[i] < 0);
+
+	return negative ? -1 : 0;
 }
 
-double
-sca_jd_from_calendar_date (const SCADate *date)
+/**
+ * @brief Reads a fixed number of decimal digits.
+ * @param str String to read from.
+ * @param count Number of the digits.
+ * @param[out] value Resulting value.
+ * @return 0 in case of success, -1 if any of the characters is not a digit.
+ * @since 0.0.2
+ */
+static int
+_sca_jd_parse_digits (const char *str, int count, int *value)
 {
-	int	Y, M;
-	int	A, B;
-	double	D;
+	unsigned int	digit;
+	int		i;
 
-	if (date == NULL)
-		return -1;
+	*value = 0;
 
-	if (date->year < -4712)
-		return 0;
+	for (i = 0; i < count; ++i) {
+		digit = (unsigned int) ((unsigned char) str[i] - '0');
 
-	D = date->day;
+		if (digit > 9)
+			return -1;
 
-	if (date->month <= SCA_MONTH_FEBRUARY) {
-		Y = date->year - 1;
-		M = date->month + 12;
-	} else {
-		Y = date->year;
-		M = date->month;
+		*value = *value * 10 + (int) digit;
 	}
 
-	B = 0;
-	if (_sca_jd_is_gregorian_date (date)) {
-		A = Y / 100;
-		B = 2 - A + (A / 4);
+	return 0;
+}
+
+/**
+ * @brief Calculates number of the days in the month.
+ * @param year Calendar year.
+ * @param month Calendar month.
+ * @return Number of the days in the month.
+ * @since 0.0.2
+ */
+static int
+_sca_jd_get_days_in_month (int year, int month)
+{
+	static const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+	return days[month - 1] + (month == SCA_MONTH_FEBRUARY && _sca_jd_is_leap_year (year));
+}
+
+/**
+ * @brief Parses ISO 8601 date and time in UTC.
+ * @param str String to parse.
+ * @param[out] year Calendar year.
+ * @param[out] month Calendar month.
+ * @param[out] day Calendar day including time, may be out of the month after
+ * the time zone correction.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Accepts extended format: [+-]YYYY-MM-DD[(T| )hh:mm[:ss[(.|,)f...]][Z|(+|-)hh[[:]mm]]],
+ * year may have up to 6 digits.
+ */
+static int
+_sca_jd_parse_iso8601 (const char *str, int *year, int *month, double *day)
+{
+	const char	*p;
+	double		secs, scale;
+	int		negative, digits, d, h, m, sec, off_h, off_m, off;
+
+	p		= str;
+	negative	= 0;
+	h = m = sec	= 0;
+	off		= 0;
+	secs		= 0.0;
+
+	if (*p == '+' || *p == '-')
+		negative = (*p++ == '-');
+
+	/* Year: 4 to 6 digits */
+	for (digits = 0; digits < 6 && (unsigned int) ((unsigned char) p[digits] - '0') <= 9; ++digits)
+		;
+
+	if (digits < 4 || _sca_jd_parse_digits (p, digits, year) != 0)
+		return -1;
+
+	p += digits;
+
+	if (negative)
+		*year = -(*year);
+
+	if (p[0] != '-' || _sca_jd_parse_digits (p + 1, 2, month) != 0 ||
+	    p[3] != '-' || _sca_jd_parse_digits (p + 4, 2, &d) != 0)
+		return -1;
+
+	p += 6;
+
+	if (*p == 'T' || *p == 't' || *p == ' ') {
+		if (_sca_jd_parse_digits (p + 1, 2, &h) != 0 ||
+		    p[3] != ':' || _sca_jd_parse_digits (p + 4, 2, &m) != 0)
+			return -1;
+
+		p += 6;
+
+		if (*p == ':') {
+			if (_sca_jd_parse_digits (p + 1, 2, &sec) != 0)
+				return -1;
+
+			p += 3;
+
+			if (*p == '.' || *p == ',') {
+				/* Digits beyond the double precision are skipped */
+				for (++p, scale = 0.1, digits = 0; (unsigned int) ((unsigned char) *p - '0') <= 9; ++p, ++digits) {
+					secs	+= (*p - '0') * scale;
+					scale	*= 0.1;
+				}
+
+				if (digits == 0)
+					return -1;
+			}
+		}
+
+		if (*p == 'Z' || *p == 'z')
+			++p;
+		else if (*p == '+' || *p == '-') {
+			negative = (*p == '-');
+
+			if (_sca_jd_parse_digits (p + 1, 2, &off_h) != 0)
+				return -1;
+
+			p	+= 3;
+			off_m	= 0;
+
+			if (*p == ':')
+				++p;
+
+			if (*p != '\0' && _sca_jd_parse_digits (p, 2, &off_m) == 0)
+				p += 2;
+
+			if (off_h > 23 || off_m > 59)
+				return -1;
+
+			off = (off_h * SCA_SECS_IN_HOUR + off_m * SCA_SECS_IN_MINUTE) * (negative ? -1 : 1);
+		}
 	}
 
-	return trunc (365.25 * (Y + 4716.0)) + trunc (30.6001 * (M + 1)) + D + B - 1524.5;
+	if (*p != '\0')
+		return -1;
+
+	if (*year < -4712 || *month < 1 || *month > 12 || d < 1 || d > _sca_jd_get_days_in_month (*year, *month) ||
+	    h > 23 || m > 59 || sec > 60)
+		return -1;
+
+	/* The same as SCA_DAYS_FROM_TIME () without fractions and time zone */
+	*day = d + ((double) (h * SCA_SECS_IN_HOUR + m * SCA_SECS_IN_MINUTE + sec - off) + secs) / SCA_SECS_IN_DAY;
+
+	return 0;
+}
+
+double
+sca_jd_from_calendar_date (const SCADate *date)
+{
+	if (date == NULL)
+		return -1;
+
+	if (date->year < -4712)
+		return 0;
+
+	return _sca_jd_from_calendar (date->year, (int) date->month, date->day);
 }
 
 int
 sca_jd_to_calendar_date (double		jd,
 			 SCADate	*date)
 {
-	double	A, B, C, D, E, F;
-	int	alpha, Z;
+	int	Z, year, month, day;
 
 	if (date == NULL || jd < 0)
 		return -1;
 
 	jd += 0.5;
-	Z = (int)(trunc (jd) + 0.1);
-	F = jd - Z;
-
-	if (Z < 2299161)
-		A = Z;
-	else {
-		alpha = (int) (trunc ((Z - 1867216.25) / 36524.25) + 0.1);
-		A = Z + 1 + alpha - trunc (alpha / 4);
-	}
-
-	B = A + 1524.0;
-	C = trunc ((B - 122.1) / 365.25);
-	D = trunc (365.25 * C);
-	E = trunc ((B - D) / 30.6001);
-
-	date->day = B - D - trunc (30.6001 * E) + F;
+	Z = (int) jd;
 
-	if (E < 14)
-		date->month = (SCAMonth) ((int) E - 1);
-	else
-		date->month = (SCAMonth) ((int) E - 13);
+	_sca_jd_to_calendar (Z, &year, &month, &day);
 
-	if (date->month > SCA_MONTH_FEBRUARY)
-		date->year = (int) C - 4716;
-	else
-		date->year = (int) C - 4715;
+	date->year	= year;
+	date->month	= (SCAMonth) month;
+	date->day	= (double) day + (jd - Z);
 
 	return 0;
 }
@@ -124,9 +499,7 @@ sca_jd_get_weekday (double	jd,
 	if (jd < 0 || weekday == NULL)
 		return -1;
 
-	jd += 1.5;
-	
-	*weekday = (SCAWeekDay) (jd - trunc (jd / 7.0) * 7.0);
+	*weekday = (SCAWeekDay) ((int) (jd + 1.5) % 7);
 
 	return 0;
 }
@@ -135,19 +508,13 @@ int
 sca_jd_get_day_of_year (double jd)
 {
 	SCADate		date;
-	int		K;
 
 	if (jd < 0)
 		return -1;
 
 	sca_jd_to_calendar_date (jd, &date);
 
-	if ((date.year % 400 != 0) && (date.year % 4 == 0))
-		K = 1;
-	else
-		K = 2;
-
-	return (int) (trunc (275.0 * (int) date.month / 9.0) - K * trunc (((int) date.month + 9.0) / 12.0) + date.day - 30.0);
+	return _sca_jd_get_day_of_year (date.year, (int) date.month, date.day);
 }
 
 double
@@ -155,40 +522,233 @@ sca_jd_from_day_of_year (int	year,
 			 int	num)
 {
 	SCADate		date;
-	int		K;
+	int		K, month;
 
 	if (num <= 0 || year < -4712)
 		return -1;
 
-	if ((year % 400 != 0) && (year % 4 == 0))
-		K = 1;
-	else
-		K = 2;
+	K = 2 - _sca_jd_is_leap_year (year);
 
-	if (num < 32)
-		date.month = (SCAMonth) 1;
-	else
-		date.month = (SCAMonth) (9.0 * (K + num) / 275.0 + 0.98);
+	/* The same as trunc (9.0 * (K + num) / 275.0 + 0.98) */
+	month = (num < 32) ? 1 : (18 * (K + num) + 539) / 550;
 
-	date.day	= num - trunc (275.0 * (int) date.month / 9.0) + K * trunc (((int) date.month + 9.0) / 12.0) + 30.0;
+	date.month	= (SCAMonth) month;
+	date.day	= (double) (num - (275 * month) / 9 + K * ((month + 9) / 12) + 30);
 	date.year	= year;
 
 	return sca_jd_from_calendar_date (&date);
 }
 
+int
+sca_jd_from_calendar_date_many (const int	*years,
+				const SCAMonth	*months,
+				const double	*days,
+				size_t		n,
+				double		*jds)
+{
+	SCAJDFromCalendarKernel	kernel;
+
+	if ((years == NULL || months == NULL || days == NULL || jds == NULL) && n > 0)
+		return -1;
+
+	kernel = _sca_jd_get_from_calendar_kernel ();
+
+	kernel (years, months, days, n, jds);
+
+	return 0;
+}
+
+int
+sca_jd_to_calendar_date_many (const double	*jds,
+			      size_t		n,
+			      int		*years,
+			      SCAMonth		*months,
+			      double		*days)
+{
+	SCAJDToCalendarKernel	kernel;
+	int			years_buf[SCA_JD_BLOCK];
+	SCAMonth		months_buf[SCA_JD_BLOCK];
+	double			days_buf[SCA_JD_BLOCK];
+	size_t			i, count;
+
+	if (jds == NULL && n > 0)
+		return -1;
+
+	if (_sca_jd_check_many (jds, n) != 0)
+		return -1;
+
+	kernel = _sca_jd_get_to_calendar_kernel ();
+
+	if (years != NULL && months != NULL && days != NULL) {
+		kernel (jds, n, years, months, days);
+		return 0;
+	}
+
+	for (i = 0; i < n; i += count) {
+		count = (n - i < SCA_JD_BLOCK) ? n - i : SCA_JD_BLOCK;
+
+		kernel (jds + i,
+			count,
+			years != NULL ? years + i : years_buf,
+			months != NULL ? months + i : months_buf,
+			days != NULL ? days + i : days_buf);
+	}
+
+	return 0;
+}
+
+int
+sca_jd_get_weekday_many (const double *jds, size_t n, SCAWeekDay *weekdays)
+{
+	size_t	i;
+
+	if ((jds == NULL || weekdays == NULL) && n > 0)
+		return -1;
+
+	if (_sca_jd_check_many (jds, n) != 0)
+		return -1;
+
+	for (i = 0; i < n; ++i)
+		weekdays[i] = (SCAWeekDay) ((int) (jds[i] + 1.5) % 7);
+
+	return 0;
+}
+
+int
+sca_jd_get_day_of_year_many (const double *jds, size_t n, int *nums)
+{
+	SCAJDToCalendarKernel	kernel;
+	int			years[SCA_JD_BLOCK];
+	SCAMonth		months[SCA_JD_BLOCK];
+	double			days[SCA_JD_BLOCK];
+	size_t			i, k, count;
+
+	if ((jds == NULL || nums == NULL) && n > 0)
+		return -1;
+
+	if (_sca_jd_check_many (jds, n) != 0)
+		return -1;
+
+	kernel = _sca_jd_get_to_calendar_kernel ();
+
+	for (i = 0; i < n; i += count) {
+		count = (n - i < SCA_JD_BLOCK) ? n - i : SCA_JD_BLOCK;
+
+		kernel (jds + i, count, years, months, days);
+
+		for (k = 0; k < count; ++k)
+			nums[i + k] = _sca_jd_get_day_of_year (years[k], (int) months[k], days[k]);
+	}
+
+	return 0;
+}
+
+double
+sca_jd_from_unix (double seconds)
+{
+	double	jd;
+
+	jd = SCA_JD_UNIX_EPOCH + seconds / SCA_SECS_IN_DAY;
+
+	return (jd < 0) ? -1 : jd;
+}
+
+int
+sca_jd_from_unix_many (const double *seconds, size_t n, double *jds)
+{
+	size_t	i;
+	int	negative;
+
+	if ((seconds == NULL || jds == NULL) && n > 0)
+		return -1;
+
+	negative = 0;
+
+	for (i = 0; i < n; ++i) {
+		jds[i]		= SCA_JD_UNIX_EPOCH + seconds[i] / SCA_SECS_IN_DAY;
+		negative	|= (jds[i] < 0);
+		jds[i]		= (jds[i] < 0) ? -1.0 : jds[i];
+	}
+
+	return negative ? -1 : 0;
+}
+
+int
+sca_jd_from_iso8601 (const char *str, double *jd)
+{
+	int	year, month;
+	double	day;
+
+	if (str == NULL || jd == NULL)
+		return -1;
+
+	if (_sca_jd_parse_iso8601 (str, &year, &month, &day) != 0)
+		return -1;
+
+	*jd = _sca_jd_from_calendar (year, month, day);
+
+	return 0;
+}
+
+int
+sca_jd_from_iso8601_many (const char * const *strs, size_t n, double *jds)
+{
+	SCAJDFromCalendarKernel	kernel;
+	int			years[SCA_JD_BLOCK];
+	SCAMonth		months[SCA_JD_BLOCK];
+	double			days[SCA_JD_BLOCK];
+	char			invalid[SCA_JD_BLOCK];
+	size_t			i, k, count;
+	int			month, failed;
+
+	if ((strs == NULL || jds == NULL) && n > 0)
+		return -1;
+
+	kernel = _sca_jd_get_from_calendar_kernel ();
+
+	failed = 0;
+
+	for (i = 0; i < n; i += count) {
+		count = (n - i < SCA_JD_BLOCK) ? n - i : SCA_JD_BLOCK;
+
+		/* Strings are parsed one by one, the conversion runs over the whole block */
+		for (k = 0; k < count; ++k) {
+			invalid[k] = (strs[i + k] == NULL ||
+				      _sca_jd_parse_iso8601 (strs[i + k], &years[k], &month, &days[k]) != 0);
+
+			if (invalid[k]) {
+				years[k]	= 2000;
+				month		= SCA_MONTH_JANUARY;
+				days[k]		= 1.0;
+				failed		= 1;
+			}
+
+			months[k] = (SCAMonth) month;
+		}
+
+		kernel (years, months, days, count, jds + i);
+
+		for (k = 0; k < count; ++k)
+			if (invalid[k])
+				jds[i + k] = -1.0;
+	}
+
+	return failed ? -1 : 0;
+}
+
 int
 sca_jd_get_sidereal_time (double	jd,
 			  SCAAngle	*sidereal)
 {
-	double		t;
 	SCAAngle	theta0, nut = 0, obl = 0;
+	SCA_STATS_DECLARE (ticks)
 
 	if (jd < 0 || sidereal == NULL)
 		return -1;
 
-	t	= sca_jd_get_centuries_2000 (jd);
-	theta0	= sca_angle_from_decimal_degrees (280.46061837 + 360.98564736629 * (jd - SCA_JD_EPOCH_2000)
-						 + 0.000387933 * t * t - (t * t * t) / 38710000.0);
+	SCA_STATS_BEGIN (ticks);
+
+	theta0 = sca_jd_get_mean_sidereal_time (jd);
 
 	sca_earth_get_nutation (jd, &nut, NULL);
 	sca_earth_get_ecliptic_obliquity (jd, &obl);
@@ -196,9 +756,22 @@ sca_jd_get_sidereal_time (double	jd,
 	*sidereal = theta0 + sca_angle_from_degrees (0, 0, 0, nut * 3600.0 * sca_angle_get_cos (obl) * 1000.0);
 	sca_angle_reduce (sidereal);
 
+	SCA_STATS_END (SCA_STATS_SIDEREAL_TIME, ticks);
+
 	return 0;
 }
 
+SCAAngle
+sca_jd_get_mean_sidereal_time (double jd)
+{
+	double	t;
+
+	t = sca_jd_get_centuries_2000 (jd);
+
+	return sca_angle_from_decimal_degrees (280.46061837 + 360.98564736629 * (jd - SCA_JD_EPOCH_2000)
+					       + 0.000387933 * t * t - (t * t * t) / 38710000.0);
+}
+
 double
 sca_jd_get_centuries_2000 (double jd)
 {
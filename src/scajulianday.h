@@ -83,6 +83,8 @@
 #ifndef __SCAJULIANDAY_H__
 #define __SCAJULIANDAY_H__
 
+#include <stddef.h>
+
 #include <scamacros.h>
 #include <scaangle.h>
 
@@ -95,6 +97,13 @@ SCA_BEGIN_DECLS
 #endif
 #define SCA_JD_EPOCH_2000 2451545.0
 
+#ifdef DOXYGEN_RUSSIAN
+/** Юлианский день для эпохи Unix (1 января 1970 года, 00:00 UTC). */
+#else
+/** Julian Day for Unix epoch (January 1, 1970, 00:00 UTC). */
+#endif
+#define SCA_JD_UNIX_EPOCH 2440587.5
+
 #ifdef DOXYGEN_RUSSIAN
 /** Перечисление месяцев. */
 #else
@@ -386,6 +395,240 @@ int		sca_jd_get_day_of_year		(double jd);
 #endif
 double		sca_jd_from_day_of_year		(int year, int num);
 
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает юлианские дни для массива календарных дат.
+ * @param years Массив календарных годов.
+ * @param months Массив календарных месяцев.
+ * @param days Массив календарных дней (включая суточное время).
+ * @param n Количество дат.
+ * @param[out] jds Массив юлианских дней.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Результаты совпадают с результатами sca_jd_from_calendar_date() для каждой
+ * даты. Расчёт выполняется в целых числах без ветвлений и векторизуется
+ * компилятором. Поддерживаются года до 200000.
+ */
+#else
+/**
+ * @brief Calculates Julian Days for the array of calendar dates.
+ * @param years Array of calendar years.
+ * @param months Array of calendar months.
+ * @param days Array of calendar days (including time).
+ * @param n Number of the dates.
+ * @param[out] jds Array of Julian Days.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Results are the same as of sca_jd_from_calendar_date() for every date.
+ * Calculations are done in integers without branches and are vectorized by
+ * the compiler. Years up to 200000 are supported.
+ */
+#endif
+int		sca_jd_from_calendar_date_many	(const int	*years,
+						 const SCAMonth	*months,
+						 const double	*days,
+						 size_t		n,
+						 double		*jds);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Преобразует массив юлианских дней в календарные даты.
+ * @param jds Массив юлианских дней.
+ * @param n Количество юлианских дней.
+ * @param[out] years Массив календарных годов, может быть NULL.
+ * @param[out] months Массив календарных месяцев, может быть NULL.
+ * @param[out] days Массив календарных дней (включая суточное время), может
+ * быть NULL.
+ * @return 0 в случае успеха, -1, если хотя бы один юлианский день
+ * отрицателен.
+ * @since 0.0.2
+ *
+ * Результаты совпадают с результатами sca_jd_to_calendar_date() для каждого
+ * юлианского дня. Если хотя бы один юлианский день отрицателен, массивы не
+ * изменяются.
+ */
+#else
+/**
+ * @brief Converts the array of Julian Days to calendar dates.
+ * @param jds Array of Julian Days.
+ * @param n Number of the Julian Days.
+ * @param[out] years Array of calendar years, may be NULL.
+ * @param[out] months Array of calendar months, may be NULL.
+ * @param[out] days Array of calendar days (including time), may be NULL.
+ * @return 0 in case of success, -1 if any of the Julian Days is negative.
+ * @since 0.0.2
+ *
+ * Results are the same as of sca_jd_to_calendar_date() for every Julian
+ * Day. Arrays are not modified if any of the Julian Days is negative.
+ */
+#endif
+int		sca_jd_to_calendar_date_many	(const double	*jds,
+						 size_t		n,
+						 int		*years,
+						 SCAMonth	*months,
+						 double		*days);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Определяет дни недели для массива юлианских дней.
+ * @param jds Массив юлианских дней.
+ * @param n Количество юлианских дней.
+ * @param[out] weekdays Массив дней недели.
+ * @return 0 в случае успеха, -1, если хотя бы один юлианский день
+ * отрицателен.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Determines the week days for the array of Julian Days.
+ * @param jds Array of Julian Days.
+ * @param n Number of the Julian Days.
+ * @param[out] weekdays Array of the days of the week.
+ * @return 0 in case of success, -1 if any of the Julian Days is negative.
+ * @since 0.0.2
+ */
+#endif
+int		sca_jd_get_weekday_many		(const double *jds, size_t n, SCAWeekDay *weekdays);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает номера дней в году для массива юлианских дней.
+ * @param jds Массив юлианских дней.
+ * @param n Количество юлианских дней.
+ * @param[out] nums Массив номеров дней в году.
+ * @return 0 в случае успеха, -1, если хотя бы один юлианский день
+ * отрицателен.
+ * @since 0.0.2
+ *
+ * Результаты совпадают с результатами sca_jd_get_day_of_year().
+ */
+#else
+/**
+ * @brief Calculates the numbers of the days in the year for the array of
+ * Julian Days.
+ * @param jds Array of Julian Days.
+ * @param n Number of the Julian Days.
+ * @param[out] nums Array of the numbers of the days in the year.
+ * @return 0 in case of success, -1 if any of the Julian Days is negative.
+ * @since 0.0.2
+ *
+ * Results are the same as of sca_jd_get_day_of_year().
+ */
+#endif
+int		sca_jd_get_day_of_year_many	(const double *jds, size_t n, int *nums);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает юлианский день для времени Unix.
+ * @param seconds Секунды с начала эпохи Unix, могут быть дробными или
+ * отрицательными.
+ * @return Юлианский день в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Секунды координации не учитываются, как и во времени Unix.
+ */
+#else
+/**
+ * @brief Calculates Julian Day for Unix time.
+ * @param seconds Seconds since Unix epoch, may be fractional or negative.
+ * @return Julian Day in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Leap seconds are not counted, the same as in Unix time.
+ */
+#endif
+double		sca_jd_from_unix		(double seconds);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает юлианские дни для массива значений времени Unix.
+ * @param seconds Массив секунд с начала эпохи Unix.
+ * @param n Количество значений.
+ * @param[out] jds Массив юлианских дней.
+ * @return 0 в случае успеха, -1, если хотя бы один юлианский день
+ * отрицателен.
+ * @since 0.0.2
+ *
+ * Отрицательные юлианские дни заменяются на -1.
+ */
+#else
+/**
+ * @brief Calculates Julian Days for the array of Unix times.
+ * @param seconds Array of seconds since Unix epoch.
+ * @param n Number of the values.
+ * @param[out] jds Array of Julian Days.
+ * @return 0 in case of success, -1 if any of the Julian Days is negative.
+ * @since 0.0.2
+ *
+ * Negative Julian Days are replaced with -1.
+ */
+#endif
+int		sca_jd_from_unix_many		(const double *seconds, size_t n, double *jds);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает юлианский день для даты и времени в формате ISO 8601.
+ * @param str Строка с датой и временем.
+ * @param[out] jd Юлианский день.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Поддерживается расширенный формат YYYY-MM-DD[Thh:mm[:ss[.sss]]][Z|±hh[:mm]]:
+ * год может иметь знак и до 6 цифр, вместо T допускается пробел, дробная
+ * часть секунд может иметь любую длину и отделяться точкой или запятой.
+ * Время со смещением часового пояса приводится к UTC, время без смещения
+ * считается UTC. Для дат до 15 октября 1582 года используется юлианский
+ * календарь, как и в sca_jd_from_calendar_date(). Память не выделяется,
+ * текущая локаль не используется.
+ */
+#else
+/**
+ * @brief Calculates Julian Day for the ISO 8601 date and time.
+ * @param str String with the date and time.
+ * @param[out] jd Julian Day.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Extended format YYYY-MM-DD[Thh:mm[:ss[.sss]]][Z|±hh[:mm]] is supported:
+ * the year may have a sign and up to 6 digits, a space is allowed instead of
+ * T, fraction of the seconds may have any length and be separated with a dot
+ * or a comma. Time with a time zone offset is converted to UTC, time without
+ * an offset is treated as UTC. Julian calendar is used for dates before
+ * October 15, 1582, the same as in sca_jd_from_calendar_date(). No memory is
+ * allocated, the current locale is not used.
+ */
+#endif
+int		sca_jd_from_iso8601		(const char *str, double *jd);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает юлианские дни для массива строк в формате ISO 8601.
+ * @param strs Массив строк с датой и временем.
+ * @param n Количество строк.
+ * @param[out] jds Массив юлианских дней.
+ * @return 0 в случае успеха, -1, если хотя бы одна строка некорректна.
+ * @since 0.0.2
+ *
+ * Юлианские дни для некорректных строк (включая NULL) заменяются на -1,
+ * остальные совпадают с результатами sca_jd_from_iso8601().
+ */
+#else
+/**
+ * @brief Calculates Julian Days for the array of ISO 8601 strings.
+ * @param strs Array of strings with the date and time.
+ * @param n Number of the strings.
+ * @param[out] jds Array of Julian Days.
+ * @return 0 in case of success, -1 if any of the strings is invalid.
+ * @since 0.0.2
+ *
+ * Julian Days for invalid strings (including NULL) are replaced with -1,
+ * others are the same as of sca_jd_from_iso8601().
+ */
+#endif
+int		sca_jd_from_iso8601_many	(const char * const *strs, size_t n, double *jds);
+
 #ifdef DOXYGEN_RUSSIAN
 /**
  * @brief Рассчитывает гринвичское истинное звёздное время.
@@ -128,13 +128,20 @@
 #include "scamacros.h"
 #include "scaangle.h"
 #include "scacoordinates.h"
+#include "scadiag.h"
 #include "scaearth.h"
+#include "scaepoch.h"
+#include "scaephemeriscache.h"
 #include "scajulianday.h"
 #include "scamisc.h"
 #include "scamoon.h"
+#include "scaparallel.h"
 #include "scaplanetdata.h"
 #include "scastar.h"
+#include "scastarcatalog.h"
+#include "scastats.h"
 #include "scasun.h"
+#include "scatimestepper.h"
 
 #endif /* __SCALIB_H__ */
 
@@ -137,10 +137,24 @@
 #endif
 
 #ifdef DOXYGEN_RUSSIAN
-/** Отладочное предупреждение. */
+/**
+ * @brief Отладочное предупреждение.
+ * @param module Модуль.
+ * @param str Текст сообщения.
+ * @deprecated Передаёт сообщение с кодом #SCA_DIAG_WARNING обработчику,
+ * установленному функцией sca_diag_set_handler(), вместо вывода в stdout.
+ * Используйте sca_diag_report().
+ */
 #else
-/** Debug warning. */
+/**
+ * @brief Debug warning.
+ * @param module Module.
+ * @param str Message text.
+ * @deprecated Passes the message with the #SCA_DIAG_WARNING code to the
+ * handler set with sca_diag_set_handler() instead of printing it to stdout.
+ * Use sca_diag_report() instead.
+ */
 #endif
-#define SCA_WARNING(module, str) printf ("%s: %s\n", module, str)
+#define SCA_WARNING(module, str) sca_diag_report (SCA_DIAG_WARNING, module, str)
 
 #endif /* __SCAMACROS_H__ */
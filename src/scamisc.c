@@ -18,6 +18,8 @@
 
 #include <scamisc.h>
 
+#include "scaprivate.h"
+
 #ifndef HAVE_TRUNC_DECL
 #  include <math.h>
 #  include <float.h>
@@ -46,7 +48,7 @@ sca_misc_interpolate_three (double	x[3],
 		return -1;
 
 	if (xval <= x[0] || xval >= x[2]) {
-		SCA_WARNING ("SCAMisc", "Interpolating value is out of range.");
+		SCA_DIAG (SCA_DIAG_OUT_OF_RANGE, "SCAMisc", "Interpolating value is out of range");
 		return -1;
 	}
 
@@ -55,7 +57,7 @@ sca_misc_interpolate_three (double	x[3],
 	factor = (xval - x[1]) / norm;
 
 	if (factor > 0.5)
-		SCA_WARNING ("SCAMisc", "Bad interpolating factor, results may have low accuracy");
+		SCA_DIAG (SCA_DIAG_LOW_ACCURACY, "SCAMisc", "Bad interpolating factor, results may have low accuracy");
 
 	/* Perform interpolation */
 	diff_a = y[1] - y[0];
@@ -88,7 +90,7 @@ sca_misc_interpolate_five (double	x[5],
 		return -1;
 
 	if (xval <= x[0] || xval >= x[4]) {
-		SCA_WARNING ("SCAMisc", "Interpolating value is out of range.");
+		SCA_DIAG (SCA_DIAG_OUT_OF_RANGE, "SCAMisc", "Interpolating value is out of range");
 		return -1;
 	}
 
@@ -97,7 +99,7 @@ sca_misc_interpolate_five (double	x[5],
 	factor = (xval - x[2]) / norm;
 
 	if (factor > 0.5)
-		SCA_WARNING ("SCAMisc", "Bad interpolating factor, results may have low accuracy");
+		SCA_DIAG (SCA_DIAG_LOW_ACCURACY, "SCAMisc", "Bad interpolating factor, results may have low accuracy");
 
 	/* Perform interpolation */
 	diff_a = y[1] - y[0];
@@ -27,6 +27,8 @@
  * and r (respectively): 6.288774 * sin (dM) and -20905.355 * cos (dM).
  */
 
+#include <stdlib.h>
+
 #include "scamoon.h"
 #include "scasun.h"
 #include "scajulianday.h"
@@ -34,6 +36,9 @@
 
 #define SCA_MOON_MAX_COEFS	60
 
+/* Maximum multiple of D, M, M' and F in the periodic terms */
+#define SCA_MOON_MAX_MULTIPLE	4
+
 /* Periodic terms for ecliptic longitude and geocentral distance (in kms) */
 static const double moon_data_lr[SCA_MOON_MAX_COEFS][6] = {
 /* D, M, dM, F, l, r  coefficients */
@@ -93,7 +98,7 @@ static const double moon_data_lr[SCA_MOON_MAX_COEFS][6] = {
 {3.0,	 0.0,	-2.0,	 0.0,	-0.000340,	 0.0000000},
 {4.0,	 0.0,	-3.0,	 0.0,	 0.000330,	 0.0000000},
 {2.0,	-1.0,	 2.0,	 0.0,	 0.000327,	 0.0000000},
-{0.0,	 2.0,	 1.0,	 0.0,	-0.000323,	 0.1650000},
+{0.0,	 2.0,	 1.0,	 0.0,	-0.000323,	 1.1650000},
 {1.0,	 1.0,	-1.0,	 0.0,	 0.000299,	 0.0000000},
 {2.0,	 0.0,	 3.0,	 0.0,	 0.000294,	 0.0000000},
 {2.0,	 0.0,	-1.0,	-2.0,	 0.000000,	 8.7520000}
@@ -164,20 +169,102 @@ static const double moon_data_b[SCA_MOON_MAX_COEFS][5] = {
 {2.0,	-2.0,	 0.0,	 1.0,	 0.000107}
 };
 
-int
-sca_moon_update_date (SCAMoon *moon, SCADate *date)
+/**
+ * @brief Calculates sines and cosines of the angle multiples.
+ * @param angle Angle.
+ * @param[out] s Sines of 0 to #SCA_MOON_MAX_MULTIPLE multiples of @a angle.
+ * @param[out] c Cosines of 0 to #SCA_MOON_MAX_MULTIPLE multiples of @a angle.
+ * @since 0.0.2
+ */
+static void
+_sca_moon_get_multiples (SCAAngle angle, double *s, double *c)
 {
-	double		jd, t;
-	double		r, l, b, E, E_clr, E_cb;
+	unsigned int	k;
+
+	s[0] = 0.0;
+	c[0] = 1.0;
+
+	sca_angle_get_sincos (angle, &s[1], &c[1]);
+
+	/* Chebyshev recurrence: sin ((k + 1) x) = 2 cos (x) sin (k x) - sin ((k - 1) x) */
+	for (k = 2; k <= SCA_MOON_MAX_MULTIPLE; ++k) {
+		s[k] = 2.0 * c[1] * s[k - 1] - s[k - 2];
+		c[k] = 2.0 * c[1] * c[k - 1] - c[k - 2];
+	}
+}
+
+/**
+ * @brief Calculates sine and cosine of the periodic term argument.
+ * @param coefs Multiples of D, M, M' and F.
+ * @param s Sines of the multiples for D, M, M' and F.
+ * @param c Cosines of the multiples for D, M, M' and F.
+ * @param[out] sin_arg Sine of the argument.
+ * @param[out] cos_arg Cosine of the argument.
+ * @since 0.0.2
+ */
+static void
+_sca_moon_get_term (const double	*coefs,
+		    double		s[4][SCA_MOON_MAX_MULTIPLE + 1],
+		    double		c[4][SCA_MOON_MAX_MULTIPLE + 1],
+		    double		*sin_arg,
+		    double		*cos_arg)
+{
+	double		sa, ca, sk, ck, tmp;
+	unsigned int	j;
+	int		k;
+
+	sa = 0.0;
+	ca = 1.0;
+
+	/* Angle addition: products only, no more calls to libm */
+	for (j = 0; j < 4; ++j) {
+		if ((k = (int) coefs[j]) == 0)
+			continue;
+
+		sk = k > 0 ? s[j][k] : -s[j][-k];
+		ck = k > 0 ? c[j][k] : c[j][-k];
+
+		tmp	= sa * ck + ca * sk;
+		ca	= ca * ck - sa * sk;
+		sa	= tmp;
+	}
+
+	*sin_arg = sa;
+	*cos_arg = ca;
+}
+
+const double *
+sca_moon_get_lr_terms (unsigned int *count)
+{
+	*count = SCA_MOON_MAX_COEFS;
+
+	return moon_data_lr[0];
+}
+
+const double *
+sca_moon_get_b_terms (unsigned int *count)
+{
+	*count = SCA_MOON_MAX_COEFS;
+
+	return moon_data_b[0];
+}
+
+void
+sca_moon_get_ecliptic (double jd, SCAAngle *L, SCAAngle *B, double *dst)
+{
+	double		t;
+	double		r, l, b, E, E_corr[3];
 	SCAAngle	dL, D, M, dM, F;
 	SCAAngle	A1, A2, A3;
-	SCAAngle	L, B;
-	unsigned int	i, M_abs_lr, M_abs_b;
-	
-	if (moon == NULL || date == NULL)
-		return -1;
+	double		s[4][SCA_MOON_MAX_MULTIPLE + 1];
+	double		c[4][SCA_MOON_MAX_MULTIPLE + 1];
+	double		sin_arg, cos_arg;
+	double		sin_dL, cos_dL, sin_dM, cos_dM, sin_F, cos_F, sin_A1, cos_A1;
+	unsigned int	i;
+	SCA_STATS_DECLARE (ticks)
+
+	SCA_STATS_BEGIN (ticks);
 
-	jd	= sca_jd_from_calendar_date (date);
 	t	= sca_jd_get_centuries_2000 (jd);
 
 	/* Moon's mean longitude, to take in account flattering of the Earth */
@@ -201,53 +288,155 @@ sca_moon_update_date (SCAMoon *moon, SCADate *date)
 	sca_angle_reduce (&A2);
 	sca_angle_reduce (&A3);	
 
+	/* Corrections for Earth's orbit eccentricity, indexed by |M| multiple */
+	E_corr[0] = 1.0;
+	E_corr[1] = E;
+	E_corr[2] = E * E;
+
+	/* All the periodic terms are combined from these multiples */
+	_sca_moon_get_multiples (D, s[0], c[0]);
+	_sca_moon_get_multiples (M, s[1], c[1]);
+	_sca_moon_get_multiples (dM, s[2], c[2]);
+	_sca_moon_get_multiples (F, s[3], c[3]);
+
 	r = l = b = 0.0;
 	for (i = 0; i < SCA_MOON_MAX_COEFS; ++i) {
-		M_abs_lr	= (unsigned int) fabs (moon_data_lr[i][1] + 0.5);
-		M_abs_b		= (unsigned int) fabs (moon_data_b[i][1] + 0.5);
-		
-		/* Corrections for Earth's orbit eccentricity */
-		E_clr = (M_abs_lr == 1) ? E : ((M_abs_lr == 2) ? E * E : 1.0);
-		E_cb = (M_abs_b == 1) ? E : ((M_abs_b == 2) ? E * E : 1.0);
-
-		l += moon_data_lr[i][4] * E_clr
-		   * sca_angle_get_sin (moon_data_lr[i][0] * D + moon_data_lr[i][1] * M
-				      + moon_data_lr[i][2] * dM + moon_data_lr[i][3] * F);
-		r += moon_data_lr[i][5] * E_clr
-		   * sca_angle_get_cos (moon_data_lr[i][0] * D + moon_data_lr[i][1] * M
-				      + moon_data_lr[i][2] * dM + moon_data_lr[i][3] * F);
-
-		b += moon_data_b[i][4] * E_cb
-		   * sca_angle_get_sin (moon_data_b[i][0] * D + moon_data_b[i][1] * M
-				      + moon_data_b[i][2] * dM + moon_data_b[i][3] * F);
+		_sca_moon_get_term (moon_data_lr[i], s, c, &sin_arg, &cos_arg);
+
+		l += moon_data_lr[i][4] * E_corr[abs ((int) moon_data_lr[i][1])] * sin_arg;
+		r += moon_data_lr[i][5] * E_corr[abs ((int) moon_data_lr[i][1])] * cos_arg;
+
+		_sca_moon_get_term (moon_data_b[i], s, c, &sin_arg, &cos_arg);
+
+		b += moon_data_b[i][4] * E_corr[abs ((int) moon_data_b[i][1])] * sin_arg;
 	}
 
-	l += (0.003958 * sca_angle_get_sin (A1) + 0.001962 * sca_angle_get_sin (dL - F)
+	sca_angle_get_sincos (dL, &sin_dL, &cos_dL);
+	sca_angle_get_sincos (A1, &sin_A1, &cos_A1);
+
+	sin_dM	= s[2][1];
+	cos_dM	= c[2][1];
+	sin_F	= s[3][1];
+	cos_F	= c[3][1];
+
+	l += (0.003958 * sin_A1 + 0.001962 * (sin_dL * cos_F - cos_dL * sin_F)
 	      + 0.000318 * sca_angle_get_sin (A2));
 
-	b += (-0.002235 * sca_angle_get_sin (dL)
+	b += (-0.002235 * sin_dL
 	      + 0.000382 * sca_angle_get_sin (A3)
-	      + 0.000175 * sca_angle_get_sin (A1 - F)
-	      + 0.000175 * sca_angle_get_sin (A1 + F)
-	      + 0.000127 * sca_angle_get_sin (dL - dM)
-	      - 0.000115 * sca_angle_get_sin (dL + dM));
+	      + 0.000175 * (sin_A1 * cos_F - cos_A1 * sin_F)
+	      + 0.000175 * (sin_A1 * cos_F + cos_A1 * sin_F)
+	      + 0.000127 * (sin_dL * cos_dM - cos_dL * sin_dM)
+	      - 0.000115 * (sin_dL * cos_dM + cos_dL * sin_dM));
+
+	*L = dL + sca_angle_from_decimal_degrees (l);
+	*B = sca_angle_from_decimal_degrees (b);
+
+	sca_angle_reduce (L);
+	sca_angle_reduce (B);
 
-	L = dL + sca_angle_from_decimal_degrees (l);
-	B = sca_angle_from_decimal_degrees (b);
+	*dst = (385000.56 + r) / SCA_AU;
+
+	SCA_STATS_END (SCA_STATS_MOON_SERIES, ticks);
+}
 
-	sca_angle_reduce (&L);
-	sca_angle_reduce (&B);
-		
+int
+sca_moon_update_date (SCAMoon *moon, SCADate *date)
+{
+	if (moon == NULL || date == NULL)
+		return -1;
+
+	return sca_moon_update_jd (moon, sca_jd_from_calendar_date (date));
+}
+
+int
+sca_moon_update_jd (SCAMoon *moon, double jd)
+{
+	SCAAngle	L, B;
+
+	if (moon == NULL || jd < 0)
+		return -1;
+
+	sca_moon_get_ecliptic (jd, &L, &B, &moon->dst);
 	sca_coordinates_ecliptic_to_equatorial (jd, L, B, &moon->ra, &moon->dec);
 
-	moon->jd	= jd;
-	moon->dst	= (385000.56 + r) / SCA_AU;
+	moon->jd = jd;
+
+	return 0;
+}
+
+int
+sca_moon_update_series (SCAMoon *moons, const double *jds, size_t n)
+{
+	size_t	i;
+
+	if ((moons == NULL || jds == NULL) && n > 0)
+		return -1;
+
+	for (i = 0; i < n; ++i)
+		if (jds[i] < 0)
+			return -1;
+
+	for (i = 0; i < n; ++i)
+		sca_moon_update_jd (moons + i, jds[i]);
 
 	return 0;
 }
 
 int
-sca_moon_get_local_coordinates	(SCAMoon *moon, SCAGeoLocation *loc, SCAAngle *A, SCAAngle *h)
+sca_moon_update_ctx (SCAMoon *moon, const SCAEpoch *epoch)
+{
+	SCAAngle	L, B;
+
+	if (moon == NULL || epoch == NULL)
+		return -1;
+
+	sca_moon_get_ecliptic (epoch->jd, &L, &B, &moon->dst);
+	sca_coordinates_ecliptic_to_equatorial_ctx (epoch, L, B, &moon->ra, &moon->dec);
+
+	moon->jd = epoch->jd;
+
+	return 0;
+}
+
+int
+sca_moon_update_cache (SCAMoon *moon, const SCAEpoch *epoch, const SCAEphemerisCache *cache)
+{
+	SCAAngle	L, B;
+
+	if (moon == NULL || epoch == NULL)
+		return -1;
+
+	if (sca_ephemeris_cache_get (cache, SCA_EPHEMERIS_MOON, epoch->jd, &L, &B, &moon->dst) != 0)
+		return -1;
+
+	sca_coordinates_ecliptic_to_equatorial_ctx (epoch, L, B, &moon->ra, &moon->dec);
+
+	moon->jd = epoch->jd;
+
+	return 0;
+}
+
+int
+sca_moon_update_stepper (SCAMoon *moon, const SCAEpoch *epoch, const SCATimeStepper *stepper)
+{
+	SCAAngle	L, B;
+
+	if (moon == NULL || epoch == NULL || stepper == NULL || epoch->jd != stepper->jd)
+		return -1;
+
+	if (sca_time_stepper_get (stepper, SCA_EPHEMERIS_MOON, &L, &B, &moon->dst) != 0)
+		return -1;
+
+	sca_coordinates_ecliptic_to_equatorial_ctx (epoch, L, B, &moon->ra, &moon->dec);
+
+	moon->jd = epoch->jd;
+
+	return 0;
+}
+
+int
+sca_moon_get_local_coordinates	(const SCAMoon *moon, const SCAGeoLocation *loc, SCAAngle *A, SCAAngle *h)
 {
 	SCAAngle d_ra, d_dec;
 
@@ -256,11 +445,41 @@ sca_moon_get_local_coordinates	(SCAMoon *moon, SCAGeoLocation *loc, SCAAngle *A,
 
 	/* Take parallax into account */
 	sca_earth_get_parallax_equatorial (moon->jd, moon->dst, loc, moon->ra, moon->dec, &d_ra, &d_dec);
-	
-	moon->ra	+= d_ra;
-	moon->dec	+= d_dec;
+	sca_coordinates_equatorial_to_local (moon->jd, loc, moon->ra + d_ra, moon->dec + d_dec, A, h);
 
-	sca_coordinates_equatorial_to_local (moon->jd, loc, moon->ra, moon->dec, A, h);
+	return 0;
+}
+
+int
+sca_moon_get_local_coordinates_ctx (const SCAMoon *moon, const SCAEpoch *epoch, const SCAGeoLocation *loc, SCAAngle *A, SCAAngle *h)
+{
+	SCAAngle d_ra, d_dec;
+
+	if (moon == NULL || epoch == NULL || loc == NULL || epoch->jd != moon->jd)
+		return -1;
+
+	/* Take parallax into account */
+	sca_earth_get_parallax_equatorial_ctx (epoch, moon->dst, loc, moon->ra, moon->dec, &d_ra, &d_dec);
+	sca_coordinates_equatorial_to_local_ctx (epoch, loc, moon->ra + d_ra, moon->dec + d_dec, A, h);
+
+	return 0;
+}
+
+int
+sca_moon_get_local_coordinates_observer (const SCAMoon		*moon,
+					 const SCAEpoch		*epoch,
+					 const SCAObserver	*obs,
+					 SCAAngle		*A,
+					 SCAAngle		*h)
+{
+	SCAAngle d_ra, d_dec;
+
+	if (moon == NULL || epoch == NULL || obs == NULL || epoch->jd != moon->jd)
+		return -1;
+
+	/* Take parallax into account */
+	sca_earth_get_parallax_equatorial_observer (epoch, moon->dst, obs, moon->ra, moon->dec, &d_ra, &d_dec);
+	sca_coordinates_equatorial_to_local_observer (epoch, obs, moon->ra + d_ra, moon->dec + d_dec, A, h);
 
 	return 0;
 }
@@ -363,3 +582,41 @@ sca_moon_get_mean_longitude_of_ascnode	(double jd, SCAAngle *lon)
 
 	return 0;
 }
+
+int
+sca_moon_get_topocentric_equatorial (const SCAMoon	*moon,
+				     const SCAEpoch	*epoch,
+				     const SCAObserver	*obs,
+				     SCAAngle		*ra,
+				     SCAAngle		*dec)
+{
+	SCAAngle d_ra, d_dec;
+
+	if (moon == NULL || epoch == NULL || obs == NULL || epoch->jd != moon->jd)
+		return -1;
+
+	sca_earth_get_parallax_equatorial_observer (epoch, moon->dst, obs, moon->ra, moon->dec, &d_ra, &d_dec);
+
+	if (ra != NULL)
+		*ra = moon->ra + d_ra;
+
+	if (dec != NULL)
+		*dec = moon->dec + d_dec;
+
+	return 0;
+}
+
+int
+sca_moon_get_local_coordinates_many (const SCAMoon	*moon,
+				     const SCAEpoch	*epoch,
+				     const SCAAngle	*longitudes,
+				     const SCAAngle	*latitudes,
+				     size_t		n,
+				     SCAAngle		*A,
+				     SCAAngle		*h)
+{
+	if (moon == NULL || epoch == NULL || epoch->jd != moon->jd)
+		return -1;
+
+	return sca_coordinates_equatorial_to_local_many (epoch, moon->ra, moon->dec, moon->dst, longitudes, latitudes, n, A, h);
+}
@@ -90,10 +90,15 @@
 #ifndef __SCAMOON_H__
 #define __SCAMOON_H__
 
+#include <stddef.h>
+
 #include <scamacros.h>
 #include <scaangle.h>
 #include <scajulianday.h>
 #include <scaearth.h>
+#include <scaepoch.h>
+#include <scaephemeriscache.h>
+#include <scatimestepper.h>
 
 SCA_BEGIN_DECLS
 
@@ -253,6 +258,56 @@ int	sca_moon_get_mean_longitude_of_ascnode	(double jd, SCAAngle *lon);
 #endif
 int	sca_moon_update_date			(SCAMoon *moon, SCADate *date);
 
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает положение Луны на заданный юлианский день.
+ * @param moon Объект #SCAMoon для обновления данных.
+ * @param jd Юлианский день в UT для выполнения расчёта.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Результат совпадает с результатом sca_moon_update_date() для даты,
+ * соответствующей @a jd.
+ */
+#else
+/**
+ * @brief Calculates Moon's position for given Julian Day.
+ * @param moon #SCAMoon object for updating.
+ * @param jd Julian Day in UT to perform calculation for.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Result is the same as of sca_moon_update_date() for the date corresponding
+ * to @a jd.
+ */
+#endif
+int	sca_moon_update_jd			(SCAMoon *moon, double jd);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает положения Луны на несколько моментов времени.
+ * @param[out] moons Массив объектов #SCAMoon для результатов.
+ * @param jds Массив юлианских дней в UT.
+ * @param n Количество моментов времени.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Если хотя бы один юлианский день отрицателен, объекты не обновляются.
+ */
+#else
+/**
+ * @brief Calculates positions of the Moon for several instances of time.
+ * @param[out] moons Array of #SCAMoon objects for the results.
+ * @param jds Array of Julian Days in UT.
+ * @param n Number of the instances of time.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Objects are not updated if any of the Julian Days is negative.
+ */
+#endif
+int	sca_moon_update_series			(SCAMoon *moons, const double *jds, size_t n);
+
 #ifdef DOXYGEN_RUSSIAN
 /**
  * @brief Рассчитывает местные координаты Луны с учётом параллакса.
@@ -265,6 +320,10 @@ int	sca_moon_update_date			(SCAMoon *moon, SCADate *date);
  * @note Для учёта рефракции используйте функцию sca_earth_get_refraction().
  * Данная функция должна вызываться только после хотя бы одного вызова функции
  * sca_moon_update_date() для того же объекта #SCAMoon, иначе результат неопределён.
+ *
+ * Координаты объекта не изменяются, поэтому один объект может одновременно
+ * использоваться из нескольких потоков. Топоцентрические координаты
+ * возвращает функция sca_moon_get_topocentric_equatorial().
  */
 #else
 /**
@@ -278,9 +337,226 @@ int	sca_moon_update_date			(SCAMoon *moon, SCADate *date);
  * @note To take in account refraction use sca_earth_get_refraction() routine.
  * This function must be called only after at least one call of sca_moon_update_date()
  * for the same #SCAMoon object or result is undefined.
+ *
+ * Coordinates of the object are not modified, so a single object may be used
+ * from several threads at once. Use sca_moon_get_topocentric_equatorial() to
+ * get topocentric coordinates.
+ */
+#endif
+int	sca_moon_get_local_coordinates		(const SCAMoon *moon, const SCAGeoLocation *loc, SCAAngle *A, SCAAngle *h);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает положение Луны, используя контекст расчётов.
+ * @param moon Объект #SCAMoon для обновления данных.
+ * @param epoch Контекст расчётов на нужный момент времени.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Calculates Moon's position using calculation context.
+ * @param moon #SCAMoon object for updating.
+ * @param epoch Calculation context for required instance of time.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ */
+#endif
+int	sca_moon_update_ctx			(SCAMoon *moon, const SCAEpoch *epoch);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает положение Луны, используя кэш эфемерид.
+ * @param[out] moon Объект #SCAMoon для обновления.
+ * @param epoch Контекст расчётов на нужный момент времени.
+ * @param cache Кэш эфемерид, содержащий #SCA_EPHEMERIS_MOON.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Возвращает ошибку, если момент времени находится вне интервала кэша.
+ */
+#else
+/**
+ * @brief Calculates Moon's position using cache of the ephemerides.
+ * @param[out] moon #SCAMoon object for updating.
+ * @param epoch Calculation context for required instance of time.
+ * @param cache Cache of the ephemerides containing #SCA_EPHEMERIS_MOON.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Fails if the instance of time is outside of the cache interval.
+ */
+#endif
+int	sca_moon_update_cache			(SCAMoon *moon, const SCAEpoch *epoch, const SCAEphemerisCache *cache);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает положение Луны для текущего шага расчёта с постоянным
+ * шагом.
+ * @param[out] moon Объект #SCAMoon для обновления.
+ * @param epoch Контекст расчётов на момент текущего шага.
+ * @param stepper Расчёт с постоянным шагом, содержащий #SCA_EPHEMERIS_MOON.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Возвращает ошибку, если момент времени контекста не совпадает с текущим
+ * шагом.
+ */
+#else
+/**
+ * @brief Calculates Moon's position for the current step of the calculations
+ * with a fixed time step.
+ * @param[out] moon #SCAMoon object for updating.
+ * @param epoch Calculation context for the instance of the current step.
+ * @param stepper Calculations with a fixed time step containing
+ * #SCA_EPHEMERIS_MOON.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Fails if the instance of the context doesn't match the current step.
+ */
+#endif
+int	sca_moon_update_stepper			(SCAMoon *moon, const SCAEpoch *epoch, const SCATimeStepper *stepper);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает местные координаты Луны с учётом параллакса, используя
+ * контекст расчётов.
+ * @param moon Объект #SCAMoon.
+ * @param epoch Контекст расчётов, должен соответствовать дате объекта @a moon.
+ * @param loc Положение наблюдателя.
+ * @param[out] A Азимут (положительный на запад от юга), может быть NULL.
+ * @param[out] h Высота над горизонтом, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ * @note Для учёта рефракции используйте функцию sca_earth_get_refraction().
+ *
+ * Координаты объекта не изменяются, поэтому один объект может одновременно
+ * использоваться из нескольких потоков. Топоцентрические координаты
+ * возвращает функция sca_moon_get_topocentric_equatorial().
+ */
+#else
+/**
+ * @brief Calculates local coordinates of the Moon including parallax corrections
+ * using calculation context.
+ * @param moon #SCAMoon object.
+ * @param epoch Calculation context, must correspond to the date of @a moon.
+ * @param loc Observer location.
+ * @param[out] A Azimuth (positive westward from south), may be NULL.
+ * @param[out] h Altitude above horizon, may be NULL.
+ * @return 0 in case if success, -1 otherwise.
+ * @since 0.0.2
+ * @note To take in account refraction use sca_earth_get_refraction() routine.
+ *
+ * Coordinates of the object are not modified, so a single object may be used
+ * from several threads at once. Use sca_moon_get_topocentric_equatorial() to
+ * get topocentric coordinates.
+ */
+#endif
+int	sca_moon_get_local_coordinates_ctx	(const SCAMoon *moon, const SCAEpoch *epoch, const SCAGeoLocation *loc, SCAAngle *A, SCAAngle *h);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает местные координаты Луны с учётом параллакса для
+ * наблюдателя, используя контекст расчётов.
+ * @param moon Объект #SCAMoon.
+ * @param epoch Контекст расчётов, должен соответствовать дате объекта @a moon.
+ * @param obs Наблюдатель.
+ * @param[out] A Азимут (положительный на запад от юга), может быть NULL.
+ * @param[out] h Высота над горизонтом, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ * @note Для учёта рефракции используйте функцию sca_earth_get_refraction().
+ */
+#else
+/**
+ * @brief Calculates local coordinates of the Moon including parallax corrections for
+ * the observer using calculation context.
+ * @param moon #SCAMoon object.
+ * @param epoch Calculation context, must correspond to the date of @a moon.
+ * @param obs Observer.
+ * @param[out] A Azimuth (positive westward from south), may be NULL.
+ * @param[out] h Altitude above horizon, may be NULL.
+ * @return 0 in case if success, -1 otherwise.
+ * @since 0.0.2
+ * @note To take in account refraction use sca_earth_get_refraction() routine.
+ */
+#endif
+int	sca_moon_get_local_coordinates_observer	(const SCAMoon *moon, const SCAEpoch *epoch, const SCAObserver *obs, SCAAngle *A, SCAAngle *h);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает топоцентрические экваториальные координаты Луны для
+ * наблюдателя, используя контекст расчётов.
+ * @param moon Объект #SCAMoon.
+ * @param epoch Контекст расчётов, должен соответствовать дате объекта @a moon.
+ * @param obs Наблюдатель.
+ * @param[out] ra Прямое восхождение с учётом параллакса, может быть NULL.
+ * @param[out] dec Склонение с учётом параллакса, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Координаты объекта @a moon остаются геоцентрическими.
+ */
+#else
+/**
+ * @brief Calculates topocentric equatorial coordinates of the Moon for the
+ * observer using calculation context.
+ * @param moon #SCAMoon object.
+ * @param epoch Calculation context, must correspond to the date of @a moon.
+ * @param obs Observer.
+ * @param[out] ra Right ascension including parallax, may be NULL.
+ * @param[out] dec Declination including parallax, may be NULL.
+ * @return 0 in case if success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Coordinates of the @a moon object stay geocentric.
+ */
+#endif
+int	sca_moon_get_topocentric_equatorial	(const SCAMoon *moon, const SCAEpoch *epoch, const SCAObserver *obs, SCAAngle *ra, SCAAngle *dec);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает местные координаты Луны с учётом параллакса для нескольких мест
+ * наблюдения, используя контекст расчётов.
+ * @param moon Объект #SCAMoon.
+ * @param epoch Контекст расчётов, должен соответствовать дате объекта @a moon.
+ * @param longitudes Массив долгот мест наблюдения.
+ * @param latitudes Массив широт мест наблюдения.
+ * @param n Количество мест наблюдения.
+ * @param[out] A Массив азимутов (положительных на запад от юга), может быть NULL.
+ * @param[out] h Массив высот над горизонтом, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ * @note Для учёта рефракции используйте функцию sca_earth_get_refraction().
+ *
+ * Подробности в описании sca_coordinates_equatorial_to_local_many().
+ */
+#else
+/**
+ * @brief Calculates local coordinates of the Moon including parallax corrections for several
+ * sites using calculation context.
+ * @param moon #SCAMoon object.
+ * @param epoch Calculation context, must correspond to the date of @a moon.
+ * @param longitudes Array of the site longitudes.
+ * @param latitudes Array of the site latitudes.
+ * @param n Number of the sites.
+ * @param[out] A Array of azimuths (positive westward from south), may be NULL.
+ * @param[out] h Array of altitudes above horizon, may be NULL.
+ * @return 0 in case if success, -1 otherwise.
+ * @since 0.0.2
+ * @note To take in account refraction use sca_earth_get_refraction() routine.
+ *
+ * See sca_coordinates_equatorial_to_local_many() for details.
  */
 #endif
-int	sca_moon_get_local_coordinates		(SCAMoon *moon, SCAGeoLocation *loc, SCAAngle *A, SCAAngle *h);
+int	sca_moon_get_local_coordinates_many	(const SCAMoon		*moon,
+						 const SCAEpoch		*epoch,
+						 const SCAAngle		*longitudes,
+						 const SCAAngle		*latitudes,
+						 size_t			n,
+						 SCAAngle		*A,
+						 SCAAngle		*h);
 
 SCA_END_DECLS
 
@@ -0,0 +1,431 @@
+/*
+ * Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+ */
+
+#ifndef _WIN32
+#  include <pthread.h>
+#  include <unistd.h>
+#endif
+
+#include "scaparallel.h"
+#include "scacoordinates.h"
+#include "scaprivate.h"
+#include "scathreadpool.h"
+
+/* Number of chunks per thread when the chunk size is selected automatically */
+#define SCA_PARALLEL_CHUNKS_PER_THREAD	16
+/* Catalog chunks are aligned to the vector block of the catalog */
+#define SCA_PARALLEL_CATALOG_GRANULARITY	8
+
+typedef struct _SCAParallelStars {
+	SCAStar			*stars;
+	const SCAStarDateTerms	*terms;
+} SCAParallelStars;
+
+typedef struct _SCAParallelCatalog {
+	SCAStarCatalog		*catalog;
+	const SCAStarDateTerms	*terms;
+} SCAParallelCatalog;
+
+typedef struct _SCAParallelLocal {
+	const SCAEpoch		*epoch;
+	const SCAGeoLocation	*locs;
+	SCAAngle		ra;
+	SCAAngle		dec;
+	SCAAngle		*A;
+	SCAAngle		*h;
+} SCAParallelLocal;
+
+typedef struct _SCAParallelSeries {
+	void			*objects;
+	const double		*jds;
+} SCAParallelSeries;
+
+static int		parallel_threads	= 0;
+static size_t		parallel_chunk		= 0;
+static SCAThreadPool	*parallel_pool		= NULL;
+/* Whether parallel_pool is running a job, the pool runs one job at a time */
+static int		parallel_busy		= 0;
+
+#ifndef _WIN32
+static pthread_mutex_t	parallel_lock		= PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/**
+ * @brief Gets number of threads to use.
+ * @return Number of threads, at least 1.
+ * @since 0.0.2
+ */
+static int
+_sca_parallel_get_threads (void)
+{
+#ifdef _WIN32
+	return 1;
+#else
+	long	cpus;
+
+	if (parallel_threads > 0)
+		return parallel_threads;
+
+	cpus = sysconf (_SC_NPROCESSORS_ONLN);
+
+	return cpus > 0 ? (int) cpus : 1;
+#endif
+}
+
+/**
+ * @brief Runs the job using the shared thread pool.
+ * @param n Number of the items.
+ * @param granularity Chunk size is rounded up to a multiple of this value.
+ * @param func Function to process the items.
+ * @param data User data for @a func.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * The lock is held only to read the settings and to take the pool. If the
+ * pool is running another caller's job, this one is run in the calling
+ * thread instead of waiting.
+ */
+static int
+_sca_parallel_run (size_t		n,
+		   size_t		granularity,
+		   SCAThreadPoolFunc	func,
+		   void			*data)
+{
+	SCAThreadPool	*pool;
+	size_t		chunk;
+	int		threads;
+
+#ifndef _WIN32
+	pthread_mutex_lock (&parallel_lock);
+#endif
+
+	pool = NULL;
+
+	if (!parallel_busy) {
+		if (parallel_pool == NULL)
+			parallel_pool = sca_thread_pool_new (_sca_parallel_get_threads ());
+
+		if ((pool = parallel_pool) == NULL) {
+#ifndef _WIN32
+			pthread_mutex_unlock (&parallel_lock);
+#endif
+			return -1;
+		}
+
+		parallel_busy = 1;
+	}
+
+	threads	= (pool != NULL) ? sca_thread_pool_get_threads (pool) : 1;
+	chunk	= parallel_chunk;
+
+#ifndef _WIN32
+	pthread_mutex_unlock (&parallel_lock);
+#endif
+
+	if (chunk == 0)
+		chunk = n / ((size_t) threads * SCA_PARALLEL_CHUNKS_PER_THREAD);
+
+	chunk = (chunk + granularity - 1) / granularity * granularity;
+
+	if (chunk == 0)
+		chunk = granularity;
+
+	if (pool == NULL) {
+		func (data, 0, n);
+		return 0;
+	}
+
+	sca_thread_pool_run (pool, n, chunk, func, data);
+
+#ifndef _WIN32
+	pthread_mutex_lock (&parallel_lock);
+#endif
+
+	/* The pool is replaced by sca_parallel_set_threads() while running */
+	if (pool == parallel_pool) {
+		parallel_busy	= 0;
+		pool		= NULL;
+	}
+
+#ifndef _WIN32
+	pthread_mutex_unlock (&parallel_lock);
+#endif
+
+	sca_thread_pool_free (pool);
+
+	return 0;
+}
+
+static void
+_sca_parallel_stars_func (void *data, size_t begin, size_t end)
+{
+	SCAParallelStars	*job;
+	size_t			i;
+
+	job = (SCAParallelStars *) data;
+
+	for (i = begin; i < end; ++i)
+		sca_star_update_terms (&job->stars[i], job->terms);
+}
+
+static void
+_sca_parallel_catalog_func (void *data, size_t begin, size_t end)
+{
+	SCAParallelCatalog	*job;
+
+	job = (SCAParallelCatalog *) data;
+
+	sca_star_catalog_update_terms (job->catalog, job->terms, begin, end);
+}
+
+static void
+_sca_parallel_local_func (void *data, size_t begin, size_t end)
+{
+	SCAParallelLocal	*job;
+	size_t			i;
+
+	job = (SCAParallelLocal *) data;
+
+	for (i = begin; i < end; ++i)
+		sca_coordinates_equatorial_to_local_ctx (job->epoch,
+							 &job->locs[i],
+							 job->ra,
+							 job->dec,
+							 job->A != NULL ? &job->A[i] : NULL,
+							 job->h != NULL ? &job->h[i] : NULL);
+}
+
+static void
+_sca_parallel_sun_func (void *data, size_t begin, size_t end)
+{
+	SCAParallelSeries	*job;
+	SCAEpoch		epoch;
+	size_t			i;
+
+	job = (SCAParallelSeries *) data;
+
+	/* Julian Days are checked before the run, so the calls can't fail */
+	for (i = begin; i < end; ++i) {
+		sca_epoch_new (&epoch, job->jds[i]);
+		sca_sun_update_ctx ((SCASun *) job->objects + i, &epoch);
+	}
+}
+
+static void
+_sca_parallel_moon_func (void *data, size_t begin, size_t end)
+{
+	SCAParallelSeries	*job;
+	SCAEpoch		epoch;
+	size_t			i;
+
+	job = (SCAParallelSeries *) data;
+
+	/* Julian Days are checked before the run, so the calls can't fail */
+	for (i = begin; i < end; ++i) {
+		sca_epoch_new (&epoch, job->jds[i]);
+		sca_moon_update_ctx ((SCAMoon *) job->objects + i, &epoch);
+	}
+}
+
+int
+sca_parallel_set_threads (int threads)
+{
+	SCAThreadPool	*pool;
+
+	if (threads < 0)
+		return -1;
+
+#ifndef _WIN32
+	pthread_mutex_lock (&parallel_lock);
+#endif
+
+	parallel_threads = threads;
+
+	/* The pool is created again on the next call, a running pool is freed by its caller */
+	pool		= parallel_busy ? NULL : parallel_pool;
+	parallel_pool	= NULL;
+	parallel_busy	= 0;
+
+#ifndef _WIN32
+	pthread_mutex_unlock (&parallel_lock);
+#endif
+
+	sca_thread_pool_free (pool);
+
+	return 0;
+}
+
+int
+sca_parallel_get_threads (void)
+{
+	int	threads;
+
+#ifndef _WIN32
+	pthread_mutex_lock (&parallel_lock);
+#endif
+
+	threads = _sca_parallel_get_threads ();
+
+#ifndef _WIN32
+	pthread_mutex_unlock (&parallel_lock);
+#endif
+
+	return threads;
+}
+
+void
+sca_parallel_set_chunk_size (size_t size)
+{
+#ifndef _WIN32
+	pthread_mutex_lock (&parallel_lock);
+#endif
+
+	parallel_chunk = size;
+
+#ifndef _WIN32
+	pthread_mutex_unlock (&parallel_lock);
+#endif
+}
+
+size_t
+sca_parallel_get_chunk_size (void)
+{
+	size_t	size;
+
+#ifndef _WIN32
+	pthread_mutex_lock (&parallel_lock);
+#endif
+
+	size = parallel_chunk;
+
+#ifndef _WIN32
+	pthread_mutex_unlock (&parallel_lock);
+#endif
+
+	return size;
+}
+
+int
+sca_parallel_star_update_catalog (SCAStar *stars, size_t n, double jd)
+{
+	SCAEpoch		epoch;
+	SCAStarDateTerms	terms;
+	SCAParallelStars	job;
+
+	if ((stars == NULL && n > 0) || jd < 0)
+		return -1;
+
+	if (sca_epoch_new (&epoch, jd) != 0)
+		return -1;
+
+	sca_star_date_terms_init (&terms, &epoch);
+
+	job.stars	= stars;
+	job.terms	= &terms;
+
+	return _sca_parallel_run (n, 1, _sca_parallel_stars_func, &job);
+}
+
+int
+sca_parallel_star_catalog_update (SCAStarCatalog *catalog, double jd)
+{
+	SCAEpoch		epoch;
+	SCAStarDateTerms	terms;
+	SCAParallelCatalog	job;
+
+	if (catalog == NULL || catalog->ra2000 == NULL)
+		return -1;
+
+	if (sca_epoch_new (&epoch, jd) != 0)
+		return -1;
+
+	sca_star_date_terms_init (&terms, &epoch);
+
+	job.catalog	= catalog;
+	job.terms	= &terms;
+
+	if (catalog->size > 0 &&
+	    _sca_parallel_run (catalog->size, SCA_PARALLEL_CATALOG_GRANULARITY, _sca_parallel_catalog_func, &job) != 0)
+		return -1;
+
+	catalog->jd = jd;
+
+	return 0;
+}
+
+int
+sca_parallel_equatorial_to_local (const SCAEpoch	*epoch,
+				  const SCAGeoLocation	*locs,
+				  size_t		n,
+				  SCAAngle		ra,
+				  SCAAngle		dec,
+				  SCAAngle		*A,
+				  SCAAngle		*h)
+{
+	SCAParallelLocal	job;
+
+	if (epoch == NULL || (locs == NULL && n > 0))
+		return -1;
+
+	job.epoch	= epoch;
+	job.locs	= locs;
+	job.ra		= ra;
+	job.dec		= dec;
+	job.A		= A;
+	job.h		= h;
+
+	return _sca_parallel_run (n, 1, _sca_parallel_local_func, &job);
+}
+
+int
+sca_parallel_sun_update_series (SCASun *suns, const double *jds, size_t n)
+{
+	SCAParallelSeries	job;
+	size_t			i;
+
+	if ((suns == NULL || jds == NULL) && n > 0)
+		return -1;
+
+	for (i = 0; i < n; ++i)
+		if (!(jds[i] >= 0))
+			return -1;
+
+	job.objects	= suns;
+	job.jds		= jds;
+
+	return _sca_parallel_run (n, 1, _sca_parallel_sun_func, &job);
+}
+
+int
+sca_parallel_moon_update_series (SCAMoon *moons, const double *jds, size_t n)
+{
+	SCAParallelSeries	job;
+	size_t			i;
+
+	if ((moons == NULL || jds == NULL) && n > 0)
+		return -1;
+
+	for (i = 0; i < n; ++i)
+		if (!(jds[i] >= 0))
+			return -1;
+
+	job.objects	= moons;
+	job.jds		= jds;
+
+	return _sca_parallel_run (n, 1, _sca_parallel_moon_func, &job);
+}
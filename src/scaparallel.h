@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+ */
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @file scaparallel.h
+ * @brief Параллельные расчёты
+ * @author Александр Сапрыкин
+ *
+ * Функции с префиксом sca_parallel_ разбивают массив объектов на части и
+ * обрабатывают их в нескольких потоках. Потоки создаются один раз при первом
+ * вызове и затем используются повторно. Поток, который простаивает, забирает
+ * часть работы у других потоков, поэтому неравномерная нагрузка не замедляет
+ * расчёт.
+ *
+ * Каждый объект рассчитывается той же функцией, что и при последовательном
+ * расчёте, поэтому результаты не зависят ни от количества потоков, ни от
+ * размера частей. Потоки используются одним параллельным расчётом за раз:
+ * если они заняты расчётом, вызванным из другого потока, расчёт выполняется в
+ * вызывающем потоке без ожидания.
+ *
+ * На платформах без POSIX потоков все расчёты выполняются в вызывающем потоке.
+ */
+#else
+/**
+ * @file scaparallel.h
+ * @brief Parallel calculations
+ * @author Alexander Saprykin
+ *
+ * Routines with sca_parallel_ prefix split an array of objects into chunks
+ * and process them using several threads. Threads are created once on the
+ * first call and are reused later. Idle thread steals chunks from other
+ * threads, so uneven load doesn't slow down the calculation.
+ *
+ * Every object is calculated by the same routine as in the sequential case,
+ * so results depend neither on the number of threads nor on the chunk size.
+ * The threads are used by one parallel calculation at a time: if they are
+ * busy with a calculation called from another thread, the calculation is
+ * performed in the calling thread without waiting.
+ *
+ * On platforms without POSIX threads all the calculations are performed in
+ * the calling thread.
+ */
+#endif
+
+#if !defined (__SCALIB_H_INSIDE__) && !defined (SCALIB_COMPILATION)
+#  error "Header files shouldn't be included directly, consider using <scalib.h> instead."
+#endif
+
+#ifndef __SCAPARALLEL_H__
+#define __SCAPARALLEL_H__
+
+#include <stddef.h>
+
+#include <scamacros.h>
+#include <scaangle.h>
+#include <scaearth.h>
+#include <scaepoch.h>
+#include <scamoon.h>
+#include <scastar.h>
+#include <scastarcatalog.h>
+#include <scasun.h>
+
+SCA_BEGIN_DECLS
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Задаёт количество потоков для параллельных расчётов.
+ * @param threads Количество потоков, включая вызывающий, 0 - по количеству
+ * процессоров.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * По умолчанию используется количество процессоров. Значение 1 останавливает
+ * все дополнительные потоки.
+ */
+#else
+/**
+ * @brief Sets number of threads for parallel calculations.
+ * @param threads Number of threads including the calling one, 0 to use the
+ * number of processors.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * By default the number of processors is used. Value of 1 stops all the
+ * additional threads.
+ */
+#endif
+int		sca_parallel_set_threads	(int threads);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Возвращает количество потоков для параллельных расчётов.
+ * @return Количество потоков, включая вызывающий.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Gets number of threads for parallel calculations.
+ * @return Number of threads including the calling one.
+ * @since 0.0.2
+ */
+#endif
+int		sca_parallel_get_threads	(void);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Задаёт количество объектов в одной части работы.
+ * @param size Количество объектов, 0 - выбирать автоматически.
+ * @since 0.0.2
+ *
+ * Маленькие части лучше распределяют нагрузку, большие - уменьшают накладные
+ * расходы на синхронизацию. По умолчанию размер выбирается так, чтобы на каждый
+ * поток приходилось около 16 частей.
+ */
+#else
+/**
+ * @brief Sets number of objects in a single chunk of work.
+ * @param size Number of objects, 0 to select automatically.
+ * @since 0.0.2
+ *
+ * Small chunks balance the load better, large ones reduce synchronization
+ * overhead. By default the size is selected to get about 16 chunks per thread.
+ */
+#endif
+void		sca_parallel_set_chunk_size	(size_t size);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Возвращает количество объектов в одной части работы.
+ * @return Количество объектов, 0 - выбирается автоматически.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Gets number of objects in a single chunk of work.
+ * @return Number of objects, 0 if selected automatically.
+ * @since 0.0.2
+ */
+#endif
+size_t		sca_parallel_get_chunk_size	(void);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Параллельно обновляет положение массива звёзд.
+ * @param[in,out] stars Массив объектов #SCAStar для обновления положения.
+ * @param n Количество звёзд в массиве @a stars.
+ * @param jd Юлианский день в UT для выполнения расчёта.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Результат совпадает с sca_star_update_catalog().
+ */
+#else
+/**
+ * @brief Updates coordinates of the stars array in parallel.
+ * @param[in,out] stars Array of #SCAStar objects to update coordinates.
+ * @param n Number of the stars in @a stars array.
+ * @param jd Julian Day in UT to perform calculation for.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Result is the same as for sca_star_update_catalog().
+ */
+#endif
+int		sca_parallel_star_update_catalog	(SCAStar *stars, size_t n, double jd);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Параллельно обновляет положения всех звёзд каталога.
+ * @param catalog Каталог звёзд.
+ * @param jd Юлианский день в UT для выполнения расчёта.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Результат совпадает с sca_star_catalog_update().
+ */
+#else
+/**
+ * @brief Updates positions of all the stars in the catalog in parallel.
+ * @param catalog Catalog of the stars.
+ * @param jd Julian Day in UT to perform calculation for.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Result is the same as for sca_star_catalog_update().
+ */
+#endif
+int		sca_parallel_star_catalog_update	(SCAStarCatalog *catalog, double jd);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Параллельно рассчитывает местные координаты объекта для нескольких
+ * наблюдателей.
+ * @param epoch Контекст расчётов на момент преобразования.
+ * @param locs Массив положений наблюдателей.
+ * @param n Количество наблюдателей.
+ * @param ra Прямое восхождение объекта.
+ * @param dec Склонение объекта.
+ * @param[out] A Массив азимутов для каждого наблюдателя, может быть NULL.
+ * @param[out] h Массив высот для каждого наблюдателя, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Calculates local coordinates of the object for several observers
+ * in parallel.
+ * @param epoch Calculation context for the transformation instance.
+ * @param locs Array of observer locations.
+ * @param n Number of the observers.
+ * @param ra Right ascension of the object.
+ * @param dec Declination of the object.
+ * @param[out] A Array of azimuths for every observer, may be NULL.
+ * @param[out] h Array of altitudes for every observer, may be NULL.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ */
+#endif
+int		sca_parallel_equatorial_to_local	(const SCAEpoch		*epoch,
+							 const SCAGeoLocation	*locs,
+							 size_t			n,
+							 SCAAngle		ra,
+							 SCAAngle		dec,
+							 SCAAngle		*A,
+							 SCAAngle		*h);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Параллельно рассчитывает положения Солнца на несколько моментов времени.
+ * @param[out] suns Массив объектов #SCASun для результатов.
+ * @param jds Массив юлианских дней в UT.
+ * @param n Количество моментов времени.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Calculates positions of the Sun for several instances of time in
+ * parallel.
+ * @param[out] suns Array of #SCASun objects for the results.
+ * @param jds Array of Julian Days in UT.
+ * @param n Number of the instances of time.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ */
+#endif
+int		sca_parallel_sun_update_series		(SCASun *suns, const double *jds, size_t n);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Параллельно рассчитывает положения Луны на несколько моментов времени.
+ * @param[out] moons Массив объектов #SCAMoon для результатов.
+ * @param jds Массив юлианских дней в UT.
+ * @param n Количество моментов времени.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Calculates positions of the Moon for several instances of time in
+ * parallel.
+ * @param[out] moons Array of #SCAMoon objects for the results.
+ * @param jds Array of Julian Days in UT.
+ * @param n Number of the instances of time.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ */
+#endif
+int		sca_parallel_moon_update_series		(SCAMoon *moons, const double *jds, size_t n);
+
+SCA_END_DECLS
+
+#endif /* __SCAPARALLEL_H__ */
@@ -37,6 +37,8 @@
 #ifndef __SCAPLANETDATA_H__
 #define __SCAPLANETDATA_H__
 
+#include <stddef.h>
+
 #include <scamacros.h>
 #include <scaangle.h>
 
@@ -116,6 +118,9 @@ typedef enum _SCAPlanet {
  * @param[out] dst Расстояние до Солнца в АЕ, может быть NULL.
  * @return 0 в случае успеха, иначе -1.
  * @since 0.0.1
+ *
+ * Возвращает -1 для значений @a planet вне перечисления #SCAPlanet, см.
+ * sca_planet_data_is_available().
  */
 #else
 /**
@@ -128,10 +133,124 @@ typedef enum _SCAPlanet {
  * @param[out] dst Distance to the Sun in AUs, may be NULL.
  * @return 0 in case of success, -1 otherwise.
  * @since 0.0.1
+ *
+ * Returns -1 for @a planet values outside of #SCAPlanet enumeration, see
+ * sca_planet_data_is_available().
  */
 #endif
 int sca_planet_data_get (SCAPlanet planet, double jd, SCAAngle *lon, SCAAngle *lat, double *dst);
 
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает гелиоцентрическое положение планеты и расстояние до Солнца
+ * с заданной точностью.
+ * @param planet Целевая планета.
+ * @param jd Юлианский день, соответствующий времени расчёта.
+ * @param accuracy Требуемая точность в секундах дуги, 0 - полная точность.
+ * @param[out] lon Гелиоцентрическая долгота, может быть NULL.
+ * @param[out] lat Гелиоцентрическая широта, может быть NULL.
+ * @param[out] dst Расстояние до Солнца в АЕ, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Ряды VSOP87 обрезаются так, чтобы ошибка не превышала @a accuracy в пределах
+ * 1000 лет от эпохи J2000. Используются уровни точности 0.1, 1, 10 и 60 секунд
+ * дуги, выбирается самый грубый уровень, не превышающий @a accuracy. Точность
+ * расстояния задаётся относительно среднего расстояния планеты до Солнца, то
+ * есть 1 секунда дуги соответствует примерно 5e-6 среднего расстояния.
+ * Невычисляемые величины (NULL) не рассчитываются.
+ */
+#else
+/**
+ * @brief Calculates heliocentric planet position and distance to the Sun
+ * with given accuracy.
+ * @param planet Target planet.
+ * @param jd Julian Day corresponding to calculation instance.
+ * @param accuracy Required accuracy in arcseconds, 0 for full accuracy.
+ * @param[out] lon Heliocentric longitude, may be NULL.
+ * @param[out] lat Heliocentric latitude, may be NULL.
+ * @param[out] dst Distance to the Sun in AUs, may be NULL.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * VSOP87 series are truncated so that the error doesn't exceed @a accuracy
+ * within 1000 years from J2000 epoch. Accuracy tiers of 0.1, 1, 10 and 60
+ * arcseconds are used, the coarsest tier not exceeding @a accuracy is selected.
+ * Accuracy of the distance is relative to the mean distance of the planet to
+ * the Sun, i.e. 1 arcsecond corresponds to about 5e-6 of the mean distance.
+ * Values which are not requested (NULL) are not calculated.
+ */
+#endif
+int sca_planet_data_get_accuracy (SCAPlanet planet, double jd, double accuracy, SCAAngle *lon, SCAAngle *lat, double *dst);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает гелиоцентрические положения планеты и расстояния до
+ * Солнца для нескольких моментов времени.
+ * @param planet Целевая планета.
+ * @param jds Массив юлианских дней из @a n элементов.
+ * @param n Количество моментов времени.
+ * @param[out] lon Массив гелиоцентрических долгот из @a n элементов, может быть NULL.
+ * @param[out] lat Массив гелиоцентрических широт из @a n элементов, может быть NULL.
+ * @param[out] dst Массив расстояний до Солнца в АЕ из @a n элементов, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Результаты совпадают с результатами sca_planet_data_get() для каждого
+ * момента времени с точностью до ошибок округления (менее 1e-15 радиана).
+ * Каждый член рядов VSOP87 применяется сразу к группе моментов времени, что
+ * позволяет использовать векторные инструкции процессора. Выгоднее всего вызывать функцию для сотен моментов времени
+ * сразу, например, для построения таблиц.
+ */
+#else
+/**
+ * @brief Calculates heliocentric planet positions and distances to the Sun
+ * for several instances.
+ * @param planet Target planet.
+ * @param jds Array of @a n Julian Days.
+ * @param n Number of instances.
+ * @param[out] lon Array of @a n heliocentric longitudes, may be NULL.
+ * @param[out] lat Array of @a n heliocentric latitudes, may be NULL.
+ * @param[out] dst Array of @a n distances to the Sun in AUs, may be NULL.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Results are the same as returned by sca_planet_data_get() for each
+ * instance up to rounding errors (below 1e-15 radians). Each term of VSOP87
+ * series is applied to a group of instances at once, which allows to use
+ * vector instructions of the CPU. It's best to call the function for hundreds
+ * of instances at once, i.e. to build tables.
+ */
+#endif
+int sca_planet_data_get_many (SCAPlanet planet, const double *jds, size_t n, SCAAngle *lon, SCAAngle *lat, double *dst);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Проверяет, доступны ли данные VSOP87 для планеты.
+ * @param planet Целевая планета.
+ * @return 1, если данные доступны, иначе 0.
+ * @since 0.0.2
+ *
+ * Функция sca_planet_data_get() возвращает -1 для планет, данные для которых
+ * не включены в библиотеку. Включены данные всех планет (ряды VSOP87D,
+ * сокращённые по Меесу), поэтому 0 возвращается только для значений вне
+ * перечисления #SCAPlanet.
+ */
+#else
+/**
+ * @brief Checks whether VSOP87 data is available for the planet.
+ * @param planet Target planet.
+ * @return 1 if the data is available, 0 otherwise.
+ * @since 0.0.2
+ *
+ * sca_planet_data_get() returns -1 for the planets which data is not included
+ * into the library. Data for all the planets is included (VSOP87D series as
+ * truncated by Meeus), so 0 is returned only for values outside of #SCAPlanet
+ * enumeration.
+ */
+#endif
+int sca_planet_data_is_available (SCAPlanet planet);
+
 SCA_END_DECLS
 
 #endif /* __SCAPLANETDATA_H__ */
@@ -16,6 +16,74 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
  */
 
+#ifndef __SCAPRIVATE_H__
+#define __SCAPRIVATE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <scaangle.h>
+#include <scadiag.h>
+#include <scaepoch.h>
+#include <scaplanetdata.h>
+#include <scastar.h>
+#include <scastarcatalog.h>
+#include <scastats.h>
+
+#if defined (_MSC_VER)
+#  define SCA_THREAD_LOCAL	__declspec (thread)
+#elif defined (__GNUC__)
+#  define SCA_THREAD_LOCAL	__thread
+#else
+#  define SCA_THREAD_LOCAL
+#endif
+
+/* Diagnostics are compiled out with SCA_ENABLE_DIAGNOSTICS=OFF */
+#ifdef SCA_DISABLE_DIAGNOSTICS
+#  define SCA_DIAG(code, module, message)	((void) 0)
+#else
+#  define SCA_DIAG(code, module, message)	sca_diag_report ((code), (module), (message))
+#endif
+
+#ifdef SCA_ENABLE_STATS
+/**
+ * @brief Reads the CPU cycles counter.
+ * @return Value of the counter, 0 if there is no counter.
+ * @since 0.0.2
+ */
+uint64_t	sca_stats_get_ticks		(void);
+
+/**
+ * @brief Counts the call of the stage in the current thread.
+ * @param stage Stage.
+ * @param begin Value of sca_stats_get_ticks() at the beginning of the call.
+ * @since 0.0.2
+ */
+void		sca_stats_add			(SCAStatsStage stage, uint64_t begin);
+
+/**
+ * @brief Counts the cache lookup in the current thread.
+ * @param stage Stage of the cache.
+ * @param hit Whether the lookup has succeeded.
+ * @since 0.0.2
+ */
+void		sca_stats_add_cache		(SCAStatsStage stage, int hit);
+#endif
+
+/* Statistics are compiled in only with SCA_ENABLE_STATS=ON, SCA_STATS_DECLARE
+ * goes among the variable declarations without a semicolon */
+#ifdef SCA_ENABLE_STATS
+#  define SCA_STATS_DECLARE(ticks)	uint64_t ticks;
+#  define SCA_STATS_BEGIN(ticks)		((ticks) = sca_stats_get_ticks ())
+#  define SCA_STATS_END(stage, ticks)	sca_stats_add ((stage), (ticks))
+#  define SCA_STATS_CACHE(stage, hit)	sca_stats_add_cache ((stage), (hit))
+#else
+#  define SCA_STATS_DECLARE(ticks)
+#  define SCA_STATS_BEGIN(ticks)		((void) 0)
+#  define SCA_STATS_END(stage, ticks)	((void) 0)
+#  define SCA_STATS_CACHE(stage, hit)	((void) 0)
+#endif
+
 /**
  * @brief Calculates Dynamic Time delta (in Julian Days) from the Universal Time.
  * @param jd Julian Day in Universal Time.
@@ -24,3 +92,119 @@
  */
 double		sca_jd_get_dynamic_time		(double jd);
 
+/**
+ * @brief Calculates mean sidereal time at Greenwich.
+ * @param jd Julian Day for calculation.
+ * @return Mean sidereal time, not reduced.
+ * @since 0.0.2
+ */
+SCAAngle	sca_jd_get_mean_sidereal_time	(double jd);
+
+/**
+ * @brief Calculates Moon's geocentric ecliptical position.
+ * @param jd Julian Day corresponding to calculation instance.
+ * @param[out] L Ecliptical longitude.
+ * @param[out] B Ecliptical latitude.
+ * @param[out] dst Distance to the Earth (in AUs).
+ * @since 0.0.2
+ */
+void		sca_moon_get_ecliptic		(double jd, SCAAngle *L, SCAAngle *B, double *dst);
+
+/**
+ * @brief Gets Moon's periodic terms for the longitude and the distance.
+ * @param[out] count Number of the terms.
+ * @return Terms, 6 values each: multiples of D, M, M', F, longitude coefficient
+ * (in degrees) and distance coefficient (in kms).
+ * @since 0.0.2
+ */
+const double *	sca_moon_get_lr_terms		(unsigned int *count);
+
+/**
+ * @brief Gets Moon's periodic terms for the latitude.
+ * @param[out] count Number of the terms.
+ * @return Terms, 5 values each: multiples of D, M, M', F and latitude
+ * coefficient (in degrees).
+ * @since 0.0.2
+ */
+const double *	sca_moon_get_b_terms		(unsigned int *count);
+
+/**
+ * @brief Gets periodic terms of the nutation.
+ * @param[out] count Number of the terms.
+ * @return Terms, 9 values each: multiples of D, M, M', F, Omega, then
+ * longitude and obliquity coefficients (in arcseconds) as pairs of constant
+ * and T-dependent parts.
+ * @since 0.0.2
+ */
+const double *	sca_earth_get_nutation_terms	(unsigned int *count);
+
+/**
+ * @brief Gets VSOP87 terms of a single series of the planet.
+ * @param planet Target planet.
+ * @param var Variable: 0 for L, 1 for B, 2 for R.
+ * @param power Power of T.
+ * @param[out] count Number of the terms, 0 if there is no such series.
+ * @return Terms, A, B and C values each, NULL if there is no such series.
+ * @since 0.0.2
+ */
+const double *	sca_planet_data_get_terms	(SCAPlanet	planet,
+						 unsigned int	var,
+						 unsigned int	power,
+						 unsigned int	*count);
+
+/** Private structure for date dependent terms shared by all the stars. */
+typedef struct _SCAStarDateTerms {
+	double		jd;			/**< Julian Day of the terms.		*/
+	double		years;			/**< Julian years since J2000 epoch.	*/
+	SCAAngle	zeta;			/**< Precession angle zeta.		*/
+	double		sin_zeta;		/**< Sine of precession angle zeta.	*/
+	double		cos_zeta;		/**< Cosine of precession angle zeta.	*/
+	SCAAngle	z;			/**< Precession angle z.		*/
+	double		sin_z;			/**< Sine of precession angle z.	*/
+	double		cos_z;			/**< Cosine of precession angle z.	*/
+	double		sin_theta;		/**< Sine of precession angle theta.	*/
+	double		cos_theta;		/**< Cosine of precession angle theta.	*/
+	SCAAngle	K;			/**< Aberration constant.		*/
+	double		e;			/**< Earth's orbit eccentricity.	*/
+	double		sin_sun;		/**< Sine of Sun's true longitude.	*/
+	double		cos_sun;		/**< Cosine of Sun's true longitude.	*/
+	double		sin_pi;			/**< Sine of perihelion longitude.	*/
+	double		cos_pi;			/**< Cosine of perihelion longitude.	*/
+	double		sin_obl;		/**< Sine of mean obliquity.		*/
+	double		cos_obl;		/**< Cosine of mean obliquity.		*/
+	double		tan_obl;		/**< Tangent of mean obliquity.		*/
+	SCAAngle	nut_lon;		/**< Nutation in longitude.		*/
+	SCAAngle	nut_obl;		/**< Nutation in obliquity.		*/
+} SCAStarDateTerms;
+
+/**
+ * @brief Prepares star reduction terms which depend only on the date.
+ * @param[out] terms Terms to fill in.
+ * @param epoch Calculation context.
+ * @since 0.0.2
+ */
+void		sca_star_date_terms_init	(SCAStarDateTerms *terms, const SCAEpoch *epoch);
+
+/**
+ * @brief Calculates apparent position of the star.
+ * @param star Star to perform calculation for.
+ * @param terms Date dependent terms.
+ * @since 0.0.2
+ */
+void		sca_star_update_terms		(SCAStar *star, const SCAStarDateTerms *terms);
+
+/**
+ * @brief Calculates apparent positions for the range of the stars in the catalog.
+ * @param catalog Catalog of the stars.
+ * @param terms Date dependent terms.
+ * @param begin Index of the first star, should be a multiple of 8 to keep
+ * the vector loads aligned.
+ * @param end Index past the last star.
+ * @since 0.0.2
+ */
+void		sca_star_catalog_update_terms	(SCAStarCatalog		*catalog,
+						 const SCAStarDateTerms	*terms,
+						 size_t			begin,
+						 size_t			end);
+
+#endif /* __SCAPRIVATE_H__ */
@@ -16,57 +16,87 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
  */
 
+#include <string.h>
+
 #include "scastar.h"
 #include "scaearth.h"
+#include "scafastmath.h"
 #include "scaprivate.h"
 #include "scasun.h"
 
+/* Allowed error of each of two terms of the cached linear proper motion, in radians (0.0005 arcsecond) */
+#define SCA_STAR_CACHED_TOLERANCE	2.424e-9
+
+void
+sca_star_date_terms_init (SCAStarDateTerms *terms, const SCAEpoch *epoch)
+{
+	double		t;
+	SCAAngle	theta;
+
+	terms->jd = epoch->jd;
+
+	/* Julian years between epoches */
+	terms->years = sca_jd_get_centuries_2000 (epoch->jd) * 100.0;
+
+	/* Centuries since J2000 epoch */
+	t = terms->years / 100.0;
+
+	terms->zeta	= sca_angle_from_degrees (0, 0, 0, (2306.2181 * t + 0.30188 * t * t + 0.017998 * t * t * t) * 1000.0);
+	terms->z	= sca_angle_from_degrees (0, 0, 0, (2306.2181 * t + 1.09468 * t * t + 0.018203 * t * t * t) * 1000.0);
+	theta		= sca_angle_from_degrees (0, 0, 0, (2004.3109 * t - 0.42665 * t * t - 0.041833 * t * t * t) * 1000.0);
+
+	sca_angle_get_sincos (terms->zeta, &terms->sin_zeta, &terms->cos_zeta);
+	sca_angle_get_sincos (terms->z, &terms->sin_z, &terms->cos_z);
+	sca_angle_get_sincos (theta, &terms->sin_theta, &terms->cos_theta);
+
+	terms->K	= sca_earth_get_aberration_constant ();
+	terms->e	= epoch->eccentricity;
+
+	sca_angle_get_sincos (epoch->sun_lon, &terms->sin_sun, &terms->cos_sun);
+	sca_angle_get_sincos (epoch->perihelion, &terms->sin_pi, &terms->cos_pi);
+
+	terms->sin_obl	= epoch->sin_obl;
+	terms->cos_obl	= epoch->cos_obl;
+	terms->tan_obl	= tan (sca_angle_to_radians (epoch->obl));
+
+	terms->nut_lon	= epoch->nut_lon;
+	terms->nut_obl	= epoch->nut_obl;
+}
+
 /**
  * @brief Performs precession in equatorial coordinates.
  * @param star Star for precession.
- * @param jd Julian Day corresponding to calculation instance.
+ * @param terms Date dependent terms.
  * @since 0.0.1
  */
 static void
-_sca_star_precess (SCAStar *star, double jd)
+_sca_star_precess (SCAStar *star, const SCAStarDateTerms *terms)
 {
-	double		t;
 	double		A, B, C;
-	double		sin_theta, cos_theta;
 	double		sin_dec0, cos_dec0;
+	double		sin_ra0, cos_ra0;
 	double		ra, dec;
-	SCAAngle	zeta, z, theta;
 
-	/* Julian years between epoches */
-	t = sca_jd_get_centuries_2000 (jd) * 100.0;
-	
 	/* 1. Calculate proper motion */
-	star->ra	+= t * star->ra_motion;
-	star->dec	+= t * star->dec_motion;
+	star->ra	+= terms->years * star->ra_motion;
+	star->dec	+= terms->years * star->dec_motion;
 
 	sca_angle_reduce (&star->ra);
 	sca_angle_reduce (&star->dec);
 
-	/* Centuries since J2000 epoch */
-	t /= 100.0;
-
 	/* 2. Reduce epoch to given date */
-	zeta	= sca_angle_from_degrees (0, 0, 0, (2306.2181 * t + 0.30188 * t * t + 0.017998 * t * t * t) * 1000.0);
-	z	= sca_angle_from_degrees (0, 0, 0, (2306.2181 * t + 1.09468 * t * t + 0.018203 * t * t * t) * 1000.0);
-	theta	= sca_angle_from_degrees (0, 0, 0, (2004.3109 * t - 0.42665 * t * t - 0.041833 * t * t * t) * 1000.0);
-
-	sca_angle_get_sincos (theta, &sin_theta, &cos_theta);
 	sca_angle_get_sincos (star->dec, &sin_dec0, &cos_dec0);
+	sca_angle_get_sincos (star->ra + terms->zeta, &sin_ra0, &cos_ra0);
 
-	A = cos_dec0 * sca_angle_get_sin (star->ra + zeta);
-	B = cos_theta * cos_dec0 * sca_angle_get_cos (star->ra + zeta) - sin_theta * sin_dec0;
-	C = sin_theta * cos_dec0 * sca_angle_get_cos (star->ra + zeta) + cos_theta * sin_dec0;
+	A = cos_dec0 * sin_ra0;
+	B = terms->cos_theta * cos_dec0 * cos_ra0 - terms->sin_theta * sin_dec0;
+	C = terms->sin_theta * cos_dec0 * cos_ra0 + terms->cos_theta * sin_dec0;
 
-	ra = atan2 (A, B) * SCA_ANGLE_RAD_TO_DEG + z;
+	ra = atan2 (A, B) * SCA_ANGLE_RAD_TO_DEG + terms->z;
 
-	/* If star is close to celestial pole */
+	/* If star is close to celestial pole, acos() loses the sign of the declination */
 	if (fabs (star->dec2000) > 80.0)
-		dec = acos (sqrt (A * A + B * B)) * SCA_ANGLE_RAD_TO_DEG;
+		dec = copysign (acos (sqrt (A * A + B * B)), C) * SCA_ANGLE_RAD_TO_DEG;
 	else
 		dec = asin (C) * SCA_ANGLE_RAD_TO_DEG;
 
@@ -74,6 +104,57 @@ _sca_star_precess (SCAStar *star, double jd)
 	star->dec	= dec;
 }
 
+/**
+ * @brief Performs precession in equatorial coordinates using cached vectors.
+ * @param star Star with cached vectors for precession.
+ * @param terms Date dependent terms.
+ * @param[out] sin_ra Sine of the resulting right ascension.
+ * @param[out] cos_ra Cosine of the resulting right ascension.
+ * @param[out] sin_dec Sine of the resulting declination.
+ * @param[out] cos_dec Cosine of the resulting declination.
+ * @since 0.0.2
+ */
+static void
+_sca_star_precess_cached (SCAStarCached			*star,
+			  const SCAStarDateTerms	*terms,
+			  double			*sin_ra,
+			  double			*cos_ra,
+			  double			*sin_dec,
+			  double			*cos_dec)
+{
+	double		v[3];
+	double		len, rho;
+	double		A, B, C;
+	double		x0, y0;
+	int		i;
+
+	/* 1. Calculate proper motion */
+	for (i = 0; i < 3; ++i)
+		v[i] = star->vec2000[i] + terms->years * star->motion2000[i];
+
+	/* The vector is moved along the tangent, so it must be renormalized */
+	len = sqrt (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+
+	/* 2. Reduce epoch to given date, (x0, y0) is rotated by zeta */
+	x0 = (v[0] * terms->cos_zeta - v[1] * terms->sin_zeta) / len;
+	y0 = (v[0] * terms->sin_zeta + v[1] * terms->cos_zeta) / len;
+
+	A = y0;
+	B = terms->cos_theta * x0 - terms->sin_theta * v[2] / len;
+	C = terms->sin_theta * x0 + terms->cos_theta * v[2] / len;
+
+	rho = sqrt (A * A + B * B);
+
+	star->star.ra	= atan2 (A, B) * SCA_ANGLE_RAD_TO_DEG + terms->z;
+	star->star.dec	= atan2 (C, rho) * SCA_ANGLE_RAD_TO_DEG;
+
+	/* (A, B) is rotated by z to get the mean place */
+	*sin_ra		= (A * terms->cos_z + B * terms->sin_z) / rho;
+	*cos_ra		= (B * terms->cos_z - A * terms->sin_z) / rho;
+	*sin_dec	= C;
+	*cos_dec	= rho;
+}
+
 /**
  * @brief Calculates aberration (in ecliptical coordinates).
  * @param star Star to perform calculation for.
@@ -110,46 +191,46 @@ _sca_star_get_aberration_ecliptic (SCAStar *star, double jd, SCAAngle *abr_lon,
 
 /**
  * @brief Calculates aberration (in equatorial coordinates).
- * @param star Star to perform calculation for.
- * @param jd Julian Day corresponding to calculation instance.
+ * @param terms Date dependent terms.
+ * @param sin_ra Sine of star's right ascension.
+ * @param cos_ra Cosine of star's right ascension.
+ * @param sin_dec Sine of star's declination.
+ * @param cos_dec Cosine of star's declination.
  * @param abr_ra Output aberration in right ascension.
  * @param abr_dec Output aberration in declination.
  * @since 0.0.1
  */
 static void
-_sca_star_get_aberration_equatorial (SCAStar *star, double jd, SCAAngle *abr_ra, SCAAngle *abr_dec)
+_sca_star_get_aberration_equatorial (const SCAStarDateTerms	*terms,
+				     double			sin_ra,
+				     double			cos_ra,
+				     double			sin_dec,
+				     double			cos_dec,
+				     SCAAngle			*abr_ra,
+				     SCAAngle			*abr_dec)
 {
-	double		t, e;
-	SCAAngle	K, theta;
-	SCAAngle	pi;
-	SCAAngle	obl;
-	double		cos_ra, sin_ra, cos_dec, sin_dec;
+	double		e;
+	SCAAngle	K;
 	double		cos_pi, sin_pi, cos_theta, sin_theta;
-	double		cos_obl;
-
-	sca_earth_get_ecliptic_obliquity (jd, &obl);
-
-	cos_obl	= sca_angle_get_cos (obl);
-	K	= sca_earth_get_aberration_constant ();
-	t	= sca_jd_get_centuries_2000 (jd);
-
-	sca_sun_get_true_longitude (jd, &theta);
-	sca_earth_get_orbit_eccentricity (jd, &e);
-	sca_earth_get_perihelion_longitude (jd, &pi);
+	double		cos_obl, tan_obl;
 
-	sca_angle_get_sincos (star->ra, &sin_ra, &cos_ra);
-	sca_angle_get_sincos (star->dec, &sin_dec, &cos_dec);
-	sca_angle_get_sincos (pi, &sin_pi, &cos_pi);
-	sca_angle_get_sincos (theta, &sin_theta, &cos_theta);
+	K		= terms->K;
+	e		= terms->e;
+	sin_theta	= terms->sin_sun;
+	cos_theta	= terms->cos_sun;
+	sin_pi		= terms->sin_pi;
+	cos_pi		= terms->cos_pi;
+	cos_obl		= terms->cos_obl;
+	tan_obl		= terms->tan_obl;
 
 	if (abr_ra != NULL)
 		*abr_ra = (-K) * (cos_ra * cos_theta * cos_obl + sin_ra * sin_theta) / cos_dec
 			   + e * K * (cos_ra * cos_pi * cos_obl + sin_ra * sin_pi) / cos_dec;
 
 	if (abr_dec != NULL)
-		*abr_dec = (-K) * (cos_theta * cos_obl * (tan (sca_angle_to_radians (obl)) * cos_dec - sin_ra * sin_dec)
+		*abr_dec = (-K) * (cos_theta * cos_obl * (tan_obl * cos_dec - sin_ra * sin_dec)
 				   + cos_ra * sin_dec * sin_theta)
-			    + e * K * (cos_pi * cos_obl * (tan (sca_angle_to_radians (obl)) * cos_dec - sin_ra * sin_dec)
+			    + e * K * (cos_pi * cos_obl * (tan_obl * cos_dec - sin_ra * sin_dec)
 				       + cos_ra * sin_dec * sin_pi);
 }
 
@@ -172,28 +253,30 @@ _sca_star_get_nutation_ecliptic (double jd, SCAAngle *nut_lon, SCAAngle *nut_lat
 
 /**
  * @brief Calculates nutation in equatorial coordinates.
- * @param star Star to perform calculation for.
- * @param jd Julian Day corresponding to calculation instance.
+ * @param terms Date dependent terms.
+ * @param sin_ra Sine of star's right ascension.
+ * @param cos_ra Cosine of star's right ascension.
+ * @param tan_dec Tangent of star's declination.
  * @param nut_ra Output nutation in right ascension.
  * @param nut_dec Output nutation in declination.
  * @since 0.0.1
  */
 static void
-_sca_star_get_nutation_equatorial (SCAStar *star, double jd, SCAAngle *nut_ra, SCAAngle *nut_dec)
+_sca_star_get_nutation_equatorial (const SCAStarDateTerms	*terms,
+				   double			sin_ra,
+				   double			cos_ra,
+				   double			tan_dec,
+				   SCAAngle			*nut_ra,
+				   SCAAngle			*nut_dec)
 {
-	SCAAngle	obl;
 	SCAAngle	d_nut, d_obl;
 	double		cos_obl, sin_obl;
-	double		cos_ra, sin_ra;
-	double		tan_dec;
 
-	sca_earth_get_nutation (jd, &d_nut, &d_obl);
-	sca_earth_get_ecliptic_obliquity (jd, &obl);
+	d_nut	= terms->nut_lon;
+	d_obl	= terms->nut_obl;
+	sin_obl	= terms->sin_obl;
+	cos_obl	= terms->cos_obl;
 
-	sca_angle_get_sincos (obl, &sin_obl, &cos_obl);
-	sca_angle_get_sincos (star->ra, &sin_ra, &cos_ra);
-	tan_dec = tan (sca_angle_to_radians (star->dec));
-	
 	if (nut_ra != NULL)
 		*nut_ra	= (cos_obl + sin_obl * sin_ra * tan_dec) * d_nut - (cos_ra * tan_dec) * d_obl;
 	
@@ -201,6 +284,202 @@ _sca_star_get_nutation_equatorial (SCAStar *star, double jd, SCAAngle *nut_ra, S
 		*nut_dec = (sin_obl * cos_ra) * d_nut + sin_ra * d_obl; 
 }
 
+/**
+ * @brief Applies aberration and nutation to the mean place of the star.
+ * @param star Star with the mean place for the date.
+ * @param terms Date dependent terms.
+ * @param sin_ra Sine of the mean right ascension.
+ * @param cos_ra Cosine of the mean right ascension.
+ * @param sin_dec Sine of the mean declination.
+ * @param cos_dec Cosine of the mean declination.
+ * @since 0.0.2
+ */
+static void
+_sca_star_apply_terms (SCAStar			*star,
+		       const SCAStarDateTerms	*terms,
+		       double			sin_ra,
+		       double			cos_ra,
+		       double			sin_dec,
+		       double			cos_dec)
+{
+	SCAAngle	abr_ra, abr_dec;
+	SCAAngle	nut_ra, nut_dec;
+	SCA_STATS_DECLARE (ticks)
+
+	SCA_STATS_BEGIN (ticks);
+
+	_sca_star_get_aberration_equatorial (terms, sin_ra, cos_ra, sin_dec, cos_dec, &abr_ra, &abr_dec);
+
+	SCA_STATS_END (SCA_STATS_STAR_ABERRATION, ticks);
+	SCA_STATS_BEGIN (ticks);
+
+	_sca_star_get_nutation_equatorial (terms, sin_ra, cos_ra, sin_dec / cos_dec, &nut_ra, &nut_dec);
+
+	SCA_STATS_END (SCA_STATS_STAR_NUTATION, ticks);
+
+	star->ra	+= (abr_ra + nut_ra);
+	star->dec	+= (abr_dec + nut_dec);
+
+	star->jd	= terms->jd;
+}
+
+void
+sca_star_update_terms (SCAStar *star, const SCAStarDateTerms *terms)
+{
+	double		sin_ra, cos_ra, sin_dec, cos_dec;
+	SCA_STATS_DECLARE (ticks)
+
+	SCA_STATS_BEGIN (ticks);
+
+	star->ra	= star->ra2000;
+	star->dec	= star->dec2000;
+
+	_sca_star_precess (star, terms);
+
+	/* Both aberration and nutation are calculated for the mean place */
+	sca_angle_get_sincos (star->ra, &sin_ra, &cos_ra);
+	sca_angle_get_sincos (star->dec, &sin_dec, &cos_dec);
+
+	SCA_STATS_END (SCA_STATS_STAR_PRECESSION, ticks);
+
+	_sca_star_apply_terms (star, terms, sin_ra, cos_ra, sin_dec, cos_dec);
+}
+
+/**
+ * @brief Updates coordinates of the star with cached vectors.
+ * @param star Star with cached vectors to update coordinates.
+ * @param terms Date dependent terms.
+ * @since 0.0.2
+ */
+static void
+_sca_star_cached_update_terms (SCAStarCached *star, const SCAStarDateTerms *terms)
+{
+	double		sin_ra, cos_ra, sin_dec, cos_dec;
+	SCA_STATS_DECLARE (ticks)
+
+	if (fabs (terms->years) > star->years_max) {
+		sca_star_update_terms (&star->star, terms);
+		return;
+	}
+
+	SCA_STATS_BEGIN (ticks);
+
+	_sca_star_precess_cached (star, terms, &sin_ra, &cos_ra, &sin_dec, &cos_dec);
+
+	SCA_STATS_END (SCA_STATS_STAR_PRECESSION, ticks);
+
+	_sca_star_apply_terms (&star->star, terms, sin_ra, cos_ra, sin_dec, cos_dec);
+}
+
+/**
+ * @brief Calculates unit vector of the direction.
+ * @param ra Right ascension.
+ * @param dec Declination.
+ * @param[out] vec Output unit vector.
+ * @since 0.0.2
+ */
+static void
+_sca_star_get_vector (SCAAngle ra, SCAAngle dec, double vec[3])
+{
+	double	sin_ra, cos_ra, sin_dec, cos_dec;
+
+	sca_angle_get_sincos (ra, &sin_ra, &cos_ra);
+	sca_angle_get_sincos (dec, &sin_dec, &cos_dec);
+
+	vec[0] = cos_dec * cos_ra;
+	vec[1] = cos_dec * sin_ra;
+	vec[2] = sin_dec;
+}
+
+/**
+ * @brief Applies rotation around one of the axes to the matrix.
+ * @param[in,out] m Matrix to rotate, it is multiplied by the rotation from the left.
+ * @param axis Axis index: 0 for X, 1 for Y, 2 for Z.
+ * @param angle Rotation angle, positive counterclockwise looking from the end
+ * of the axis.
+ * @since 0.0.2
+ */
+static void
+_sca_star_matrix_rotate (double m[3][3], int axis, SCAAngle angle)
+{
+	double	sin_a, cos_a;
+	double	r0, r1;
+	int	i0, i1, j;
+
+	sca_angle_get_sincos (angle, &sin_a, &cos_a);
+
+	/* Rotation around Y axis goes from Z to X */
+	i0 = (axis + 1) % 3;
+	i1 = (axis + 2) % 3;
+
+	for (j = 0; j < 3; ++j) {
+		r0 = m[i0][j];
+		r1 = m[i1][j];
+
+		m[i0][j] = cos_a * r0 - sin_a * r1;
+		m[i1][j] = sin_a * r0 + cos_a * r1;
+	}
+}
+
+/**
+ * @brief Calculates annual change of the direction unit vector.
+ * @param star Star with J2000 coordinates and proper motion.
+ * @param[out] motion Output vector.
+ * @return Interval from J2000 in Julian years where linear motion of the unit
+ * vector doesn't differ from linear change of the angles by more than twice
+ * #SCA_STAR_CACHED_TOLERANCE.
+ * @since 0.0.2
+ */
+static double
+_sca_star_get_motion_vector (const SCAStar *star, double motion[3])
+{
+	double	sin_ra, cos_ra, sin_dec, cos_dec;
+	double	d_ra, d_dec, d_sq;
+	double	vec[3], acc[3], dot, perp, speed;
+	double	years;
+	int	i;
+
+	sca_angle_get_sincos (star->ra2000, &sin_ra, &cos_ra);
+	sca_angle_get_sincos (star->dec2000, &sin_dec, &cos_dec);
+
+	d_ra	= sca_angle_to_radians (star->ra_motion);
+	d_dec	= sca_angle_to_radians (star->dec_motion);
+	d_sq	= d_ra * d_ra + d_dec * d_dec;
+
+	/* Derivatives of the unit vector by RA and Dec */
+	motion[0] = -cos_dec * sin_ra * d_ra - sin_dec * cos_ra * d_dec;
+	motion[1] = cos_dec * cos_ra * d_ra - sin_dec * sin_ra * d_dec;
+	motion[2] = cos_dec * d_dec;
+
+	/* Second derivative for linear change of the angles */
+	acc[0] = -cos_dec * cos_ra * d_sq + 2.0 * sin_dec * sin_ra * d_ra * d_dec;
+	acc[1] = -cos_dec * sin_ra * d_sq - 2.0 * sin_dec * cos_ra * d_ra * d_dec;
+	acc[2] = -sin_dec * d_dec * d_dec;
+
+	vec[0] = cos_dec * cos_ra;
+	vec[1] = cos_dec * sin_ra;
+	vec[2] = sin_dec;
+
+	/* The renormalized linear motion has no second derivative across the unit vector */
+	dot = acc[0] * vec[0] + acc[1] * vec[1] + acc[2] * vec[2];
+
+	for (i = 0; i < 3; ++i)
+		acc[i] -= dot * vec[i];
+
+	perp	= sqrt (acc[0] * acc[0] + acc[1] * acc[1] + acc[2] * acc[2]);
+	speed	= sqrt (motion[0] * motion[0] + motion[1] * motion[1] + motion[2] * motion[2]);
+	years	= HUGE_VAL;
+
+	/* Second order error is perp * t^2 / 2, the renormalization lags by (speed * t)^3 / 3 */
+	if (perp > 0.0)
+		years = sqrt (2.0 * SCA_STAR_CACHED_TOLERANCE / perp);
+
+	if (speed > 0.0 && cbrt (3.0 * SCA_STAR_CACHED_TOLERANCE) / speed < years)
+		years = cbrt (3.0 * SCA_STAR_CACHED_TOLERANCE) / speed;
+
+	return years;
+}
+
 int
 sca_star_new (SCAStar	*star,
 	      SCAAngle	ra2000,
@@ -230,40 +509,268 @@ sca_star_new (SCAStar	*star,
 	return 0;
 }
 
+int
+sca_star_cached_new (SCAStarCached	*star,
+		     SCAAngle		ra2000,
+		     SCAAngle		dec2000,
+		     SCAAngle		ra_motion,
+		     SCAAngle		dec_motion)
+{
+	if (star == NULL)
+		return -1;
+
+	if (sca_star_new (&star->star, ra2000, dec2000, ra_motion, dec_motion) != 0)
+		return -1;
+
+	_sca_star_get_vector (star->star.ra2000, star->star.dec2000, star->vec2000);
+
+	star->years_max = _sca_star_get_motion_vector (&star->star, star->motion2000);
+
+	return 0;
+}
+
 int
 sca_star_update_date (SCAStar	*star,
 		      SCADate	*date)
 {
-	double		jd;
-	SCAAngle	abr_ra, abr_dec;
-	SCAAngle	nut_ra, nut_dec;
+	if (star == NULL || date == NULL)
+		return -1;
 
+	return sca_star_update_jd (star, sca_jd_from_calendar_date (date));
+}
 
-	if (star == NULL || date == NULL)
+int
+sca_star_update_jd (SCAStar	*star,
+		    double	jd)
+{
+	SCAEpoch	epoch;
+
+	if (star == NULL)
 		return -1;
 
-	jd = sca_jd_from_calendar_date (date);
+	/* All the date terms are needed anyway, so it's cheaper to get them at once */
+	if (sca_epoch_new (&epoch, jd) != 0)
+		return -1;
 
-	star->ra	= star->ra2000;
-	star->dec	= star->dec2000;
+	return sca_star_update_ctx (star, &epoch);
+}
 
-	_sca_star_precess (star, jd);
-	_sca_star_get_aberration_equatorial (star, jd, &abr_ra, &abr_dec);
-	_sca_star_get_nutation_equatorial (star, jd, &nut_ra, &nut_dec);
+int
+sca_star_update_ctx (SCAStar		*star,
+		     const SCAEpoch	*epoch)
+{
+	SCAStarDateTerms	terms;
 
-	star->ra	+= (abr_ra + nut_ra);
-	star->dec	+= (abr_dec + nut_dec);
+	if (star == NULL || epoch == NULL)
+		return -1;
 
-	star->jd	= jd;
+	sca_star_date_terms_init (&terms, epoch);
+	sca_star_update_terms (star, &terms);
 
 	return 0;
 }
 
 int
-sca_star_get_local_coordinates	(SCAStar	*star,
-				 SCAGeoLocation	*loc,
-				 SCAAngle	*A,
-				 SCAAngle	*h)
+sca_star_update_catalog (SCAStar	*stars,
+			 size_t		n,
+			 double		jd)
+{
+	SCAEpoch		epoch;
+	SCAStarDateTerms	terms;
+	size_t			i;
+
+	if (stars == NULL && n > 0)
+		return -1;
+
+	if (sca_epoch_new (&epoch, jd) != 0)
+		return -1;
+
+	sca_star_date_terms_init (&terms, &epoch);
+
+	for (i = 0; i < n; ++i)
+		sca_star_update_terms (&stars[i], &terms);
+
+	return 0;
+}
+
+int
+sca_star_matrix_new (SCAStarMatrix	*matrix,
+		     const SCAEpoch	*epoch)
+{
+	SCAStarDateTerms	terms;
+	SCAAngle		theta;
+	SCAAngle		K;
+	double			sin_sun, cos_sun;
+	double			t;
+	int			i;
+
+	if (matrix == NULL || epoch == NULL)
+		return -1;
+
+	sca_star_date_terms_init (&terms, epoch);
+
+	matrix->jd	= epoch->jd;
+	matrix->years	= terms.years;
+
+	t	= terms.years / 100.0;
+	theta	= sca_angle_from_degrees (0, 0, 0, (2004.3109 * t - 0.42665 * t * t - 0.041833 * t * t * t) * 1000.0);
+
+	memset (matrix->pn, 0, sizeof (matrix->pn));
+
+	for (i = 0; i < 3; ++i)
+		matrix->pn[i][i] = 1.0;
+
+	/* Precession: R3 (-z) * R2 (theta) * R3 (-zeta) */
+	_sca_star_matrix_rotate (matrix->pn, 2, terms.zeta);
+	_sca_star_matrix_rotate (matrix->pn, 1, -theta);
+	_sca_star_matrix_rotate (matrix->pn, 2, terms.z);
+
+	/* Nutation: R1 (-obl - d_obl) * R3 (-d_nut) * R1 (obl) */
+	_sca_star_matrix_rotate (matrix->pn, 0, -epoch->obl);
+	_sca_star_matrix_rotate (matrix->pn, 2, epoch->nut_lon);
+	_sca_star_matrix_rotate (matrix->pn, 0, epoch->true_obl);
+
+	/* Earth's velocity in ecliptical coordinates rotated to the equator */
+	K	= sca_angle_to_radians (terms.K);
+	sin_sun	= terms.sin_sun - terms.e * terms.sin_pi;
+	cos_sun	= terms.cos_sun - terms.e * terms.cos_pi;
+
+	matrix->aberration[0] = K * sin_sun;
+	matrix->aberration[1] = -K * cos_sun * terms.cos_obl;
+	matrix->aberration[2] = -K * cos_sun * terms.sin_obl;
+
+	return 0;
+}
+
+/**
+ * @brief Applies reduction matrix to the unit vector of the star.
+ * @param star Star to update coordinates.
+ * @param matrix Reduction matrix.
+ * @param moved Unit vector of the star for the date of the matrix.
+ * @since 0.0.2
+ */
+static void
+_sca_star_apply_matrix (SCAStar			*star,
+			const SCAStarMatrix	*matrix,
+			const double		moved[3])
+{
+	double		w[3];
+	int		i;
+
+	for (i = 0; i < 3; ++i)
+		w[i] = matrix->pn[i][0] * moved[0]
+		     + matrix->pn[i][1] * moved[1]
+		     + matrix->pn[i][2] * moved[2]
+		     + matrix->aberration[i];
+
+	star->ra	= atan2 (w[1], w[0]) * SCA_ANGLE_RAD_TO_DEG;
+	star->dec	= atan2 (w[2], sqrt (w[0] * w[0] + w[1] * w[1])) * SCA_ANGLE_RAD_TO_DEG;
+	star->jd	= matrix->jd;
+}
+
+int
+sca_star_update_matrix (SCAStar			*star,
+			const SCAStarMatrix	*matrix)
+{
+	double		moved[3];
+
+	if (star == NULL || matrix == NULL)
+		return -1;
+
+	_sca_star_get_vector (star->ra2000 + matrix->years * star->ra_motion,
+			      star->dec2000 + matrix->years * star->dec_motion,
+			      moved);
+
+	_sca_star_apply_matrix (star, matrix, moved);
+
+	return 0;
+}
+
+int
+sca_star_cached_update_jd (SCAStarCached	*star,
+			   double		jd)
+{
+	SCAEpoch	epoch;
+
+	if (star == NULL)
+		return -1;
+
+	if (sca_epoch_new (&epoch, jd) != 0)
+		return -1;
+
+	return sca_star_cached_update_ctx (star, &epoch);
+}
+
+int
+sca_star_cached_update_ctx (SCAStarCached	*star,
+			    const SCAEpoch	*epoch)
+{
+	SCAStarDateTerms	terms;
+
+	if (star == NULL || epoch == NULL)
+		return -1;
+
+	sca_star_date_terms_init (&terms, epoch);
+	_sca_star_cached_update_terms (star, &terms);
+
+	return 0;
+}
+
+int
+sca_star_cached_update_catalog (SCAStarCached	*stars,
+				size_t		n,
+				double		jd)
+{
+	SCAEpoch		epoch;
+	SCAStarDateTerms	terms;
+	size_t			i;
+
+	if (stars == NULL && n > 0)
+		return -1;
+
+	if (sca_epoch_new (&epoch, jd) != 0)
+		return -1;
+
+	sca_star_date_terms_init (&terms, &epoch);
+
+	for (i = 0; i < n; ++i)
+		_sca_star_cached_update_terms (&stars[i], &terms);
+
+	return 0;
+}
+
+int
+sca_star_cached_update_matrix (SCAStarCached		*star,
+			       const SCAStarMatrix	*matrix)
+{
+	double		moved[3];
+	double		len;
+	int		i;
+
+	if (star == NULL || matrix == NULL)
+		return -1;
+
+	if (fabs (matrix->years) > star->years_max)
+		return sca_star_update_matrix (&star->star, matrix);
+
+	for (i = 0; i < 3; ++i)
+		moved[i] = star->vec2000[i] + matrix->years * star->motion2000[i];
+
+	len = sqrt (moved[0] * moved[0] + moved[1] * moved[1] + moved[2] * moved[2]);
+
+	for (i = 0; i < 3; ++i)
+		moved[i] /= len;
+
+	_sca_star_apply_matrix (&star->star, matrix, moved);
+
+	return 0;
+}
+
+int
+sca_star_get_local_coordinates	(const SCAStar		*star,
+				 const SCAGeoLocation	*loc,
+				 SCAAngle		*A,
+				 SCAAngle		*h)
 {
 	if (star == NULL || loc == NULL)
 		return -1;
@@ -272,3 +779,48 @@ sca_star_get_local_coordinates	(SCAStar	*star,
 
 	return 0;
 }
+
+int
+sca_star_get_local_coordinates_ctx (const SCAStar		*star,
+				    const SCAEpoch		*epoch,
+				    const SCAGeoLocation	*loc,
+				    SCAAngle			*A,
+				    SCAAngle			*h)
+{
+	if (star == NULL || epoch == NULL || loc == NULL || epoch->jd != star->jd)
+		return -1;
+
+	sca_coordinates_equatorial_to_local_ctx (epoch, loc, star->ra, star->dec, A, h);
+
+	return 0;
+}
+
+int
+sca_star_get_local_coordinates_observer (const SCAStar		*star,
+					 const SCAEpoch		*epoch,
+					 const SCAObserver	*obs,
+					 SCAAngle		*A,
+					 SCAAngle		*h)
+{
+	if (star == NULL || epoch == NULL || obs == NULL || epoch->jd != star->jd)
+		return -1;
+
+	sca_coordinates_equatorial_to_local_observer (epoch, obs, star->ra, star->dec, A, h);
+
+	return 0;
+}
+
+int
+sca_star_get_local_coordinates_many (const SCAStar	*star,
+				     const SCAEpoch	*epoch,
+				     const SCAAngle	*longitudes,
+				     const SCAAngle	*latitudes,
+				     size_t		n,
+				     SCAAngle		*A,
+				     SCAAngle		*h)
+{
+	if (star == NULL || epoch == NULL || epoch->jd != star->jd)
+		return -1;
+
+	return sca_coordinates_equatorial_to_local_many (epoch, star->ra, star->dec, 0.0, longitudes, latitudes, n, A, h);
+}
@@ -95,11 +95,13 @@
 #define __SCASTAR_H__
 
 #include <math.h>
+#include <stddef.h>
 
 #include <scamacros.h>
 #include <scaangle.h>
 #include <scajulianday.h>
 #include <scacoordinates.h>
+#include <scaepoch.h>
 
 SCA_BEGIN_DECLS
 
@@ -159,6 +161,76 @@ typedef struct _SCAStar {
 	double		jd;
 } SCAStar;
 
+#ifdef DOXYGEN_RUSSIAN
+/** Определение типа для матрицы редукции звёзд. */
+#else
+/** Typedef for stars reduction matrix. */
+#endif
+typedef struct _SCAStarMatrix {
+#ifdef DOXYGEN_RUSSIAN
+	/** Юлианский день матрицы.				*/
+#else
+	/** Julian Day of the matrix.				*/
+#endif
+	double		jd;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Юлианские годы от эпохи J2000.			*/
+#else
+	/** Julian years since J2000 epoch.			*/
+#endif
+	double		years;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Произведение матриц нутации и прецессии.		*/
+#else
+	/** Product of the nutation and precession matrices.	*/
+#endif
+	double		pn[3][3];
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Вектор аберрации (скорость Земли в долях c).	*/
+#else
+	/** Aberration vector (Earth's velocity in units of c).	*/
+#endif
+	double		aberration[3];
+} SCAStarMatrix;
+
+#ifdef DOXYGEN_RUSSIAN
+/** Определение типа для звезды с кэшированными векторами. */
+#else
+/** Typedef for star object with cached vectors. */
+#endif
+typedef struct _SCAStarCached {
+#ifdef DOXYGEN_RUSSIAN
+	/** Звезда, её поля обновляются так же, как для #SCAStar.	*/
+#else
+	/** Star, its fields are updated the same way as for #SCAStar.	*/
+#endif
+	SCAStar		star;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Единичный вектор направления на J2000.			*/
+#else
+	/** J2000 direction unit vector.				*/
+#endif
+	double		vec2000[3];
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Годовое изменение вектора направления.			*/
+#else
+	/** Annual change of the direction vector.			*/
+#endif
+	double		motion2000[3];
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Интервал от J2000 в юлианских годах для кэшированных векторов.	*/
+#else
+	/** Interval from J2000 in Julian years to use cached vectors for.	*/
+#endif
+	double		years_max;
+} SCAStarCached;
+
 #ifdef DOXYGEN_RUSSIAN
 /**
  * @brief Инициализиует объект #SCAStar.
@@ -211,6 +283,29 @@ int		sca_star_new			(SCAStar	*star,
 #endif
 int		sca_star_update_date		(SCAStar *star, SCADate *date);
 
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Обновляет положение звезды на заданный юлианский день.
+ * @param[in,out] star Объект #SCAStar для обновления положения.
+ * @param jd Юлианский день в UT для выполнения расчёта.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ * @note Перед вызовом данной функции необходимо проинициализировать объект
+ * @a star функцией sca_star_new().
+ */
+#else
+/**
+ * @brief Updates coordinates of the star to corresponding Julian Day.
+ * @param[in,out] star #SCAStar to update coordinates.
+ * @param jd Julian Day in UT to perform calculation for.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ * @note You must initialize @a star object with sca_star_new() routine
+ * before calling this one.
+ */
+#endif
+int		sca_star_update_jd		(SCAStar *star, double jd);
+
 #ifdef DOXYGEN_RUSSIAN
 /**
  * @brief Рассчитывает местные координаты звезды.
@@ -238,7 +333,403 @@ int		sca_star_update_date		(SCAStar *star, SCADate *date);
  * for the same #SCAStar object or result is undefined.
  */
 #endif
-int		sca_star_get_local_coordinates	(SCAStar *star, SCAGeoLocation *loc, SCAAngle *A, SCAAngle *h);
+int		sca_star_get_local_coordinates	(const SCAStar *star, const SCAGeoLocation *loc, SCAAngle *A, SCAAngle *h);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Обновляет положение звезды, используя контекст расчётов.
+ * @param[in,out] star Объект #SCAStar для обновления положения.
+ * @param epoch Контекст расчётов на нужный момент времени.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ * @note Перед вызовом данной функции необходимо проинициализировать объект
+ * @a star функцией sca_star_new().
+ */
+#else
+/**
+ * @brief Updates coordinates of the star using calculation context.
+ * @param[in,out] star #SCAStar to update coordinates.
+ * @param epoch Calculation context for required instance of time.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ * @note You must initialize @a star object with sca_star_new() routine
+ * before calling this one.
+ */
+#endif
+int		sca_star_update_ctx		(SCAStar *star, const SCAEpoch *epoch);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Обновляет положение массива звёзд на заданный момент времени.
+ * @param[in,out] stars Массив объектов #SCAStar для обновления положения.
+ * @param n Количество звёзд в массиве @a stars.
+ * @param jd Юлианский день в UT для выполнения расчёта.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Величины, зависящие только от даты (прецессия, нутация, долгота Солнца и
+ * параметры орбиты Земли), рассчитываются один раз для всего массива. Результат
+ * совпадает с последовательными вызовами sca_star_update_date() для каждой звезды.
+ * @note Перед вызовом данной функции необходимо проинициализировать все объекты
+ * массива @a stars функцией sca_star_new().
+ */
+#else
+/**
+ * @brief Updates coordinates of the stars array to corresponding date.
+ * @param[in,out] stars Array of #SCAStar objects to update coordinates.
+ * @param n Number of the stars in @a stars array.
+ * @param jd Julian Day in UT to perform calculation for.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Values which depend only on the date (precession, nutation, Sun's longitude
+ * and Earth's orbit elements) are calculated once for the whole array. Result
+ * is the same as for calling sca_star_update_date() for each star.
+ * @note You must initialize all objects in @a stars array with sca_star_new()
+ * routine before calling this one.
+ */
+#endif
+int		sca_star_update_catalog		(SCAStar *stars, size_t n, double jd);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает местные координаты звезды, используя контекст расчётов.
+ * @param star Объект #SCAStar.
+ * @param epoch Контекст расчётов, должен соответствовать дате объекта @a star.
+ * @param loc Положение наблюдателя.
+ * @param[out] A Азимут (положительный на запад от юга), может быть NULL.
+ * @param[out] h Высота над горизонтом, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ * @note Для учёта рефракции используйте функцию sca_earth_get_refraction().
+ */
+#else
+/**
+ * @brief Calculates local coordinates of the star using calculation context.
+ * @param star #SCAStar object.
+ * @param epoch Calculation context, must correspond to the date of @a star.
+ * @param loc Observer location.
+ * @param[out] A Azimuth (positive westward from south), may be NULL.
+ * @param[out] h Altitude above horizon, may be NULL.
+ * @return 0 in case if success, -1 otherwise.
+ * @since 0.0.2
+ * @note To take in account refraction use sca_earth_get_refraction() routine.
+ */
+#endif
+int		sca_star_get_local_coordinates_ctx	(const SCAStar *star, const SCAEpoch *epoch, const SCAGeoLocation *loc, SCAAngle *A, SCAAngle *h);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает местные координаты звезды для
+ * наблюдателя, используя контекст расчётов.
+ * @param star Объект #SCAStar.
+ * @param epoch Контекст расчётов, должен соответствовать дате объекта @a star.
+ * @param obs Наблюдатель.
+ * @param[out] A Азимут (положительный на запад от юга), может быть NULL.
+ * @param[out] h Высота над горизонтом, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ * @note Для учёта рефракции используйте функцию sca_earth_get_refraction().
+ */
+#else
+/**
+ * @brief Calculates local coordinates of the star for
+ * the observer using calculation context.
+ * @param star #SCAStar object.
+ * @param epoch Calculation context, must correspond to the date of @a star.
+ * @param obs Observer.
+ * @param[out] A Azimuth (positive westward from south), may be NULL.
+ * @param[out] h Altitude above horizon, may be NULL.
+ * @return 0 in case if success, -1 otherwise.
+ * @since 0.0.2
+ * @note To take in account refraction use sca_earth_get_refraction() routine.
+ */
+#endif
+int		sca_star_get_local_coordinates_observer	(const SCAStar *star, const SCAEpoch *epoch, const SCAObserver *obs, SCAAngle *A, SCAAngle *h);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает матрицу редукции звёзд для контекста расчётов.
+ * @param[out] matrix Структура #SCAStarMatrix для инициализации.
+ * @param epoch Контекст расчётов на нужный момент времени.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Матрица объединяет прецессию и нутацию, аберрация учитывается сложением
+ * векторов. Матрицу нужно рассчитать один раз для момента времени, после чего
+ * положение каждой звезды рассчитывается функцией sca_star_update_matrix().
+ */
+#else
+/**
+ * @brief Calculates stars reduction matrix for calculation context.
+ * @param[out] matrix #SCAStarMatrix structure to initialize.
+ * @param epoch Calculation context for required instance of time.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * The matrix combines precession and nutation, aberration is applied as
+ * vector addition. Calculate the matrix once for the instance of time, then
+ * use sca_star_update_matrix() to get position of each star.
+ */
+#endif
+int		sca_star_matrix_new		(SCAStarMatrix *matrix, const SCAEpoch *epoch);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Обновляет положение звезды, используя матрицу редукции.
+ * @param[in,out] star Объект #SCAStar для обновления положения.
+ * @param matrix Матрица редукции на нужный момент времени.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Положение звезды рассчитывается умножением её единичного вектора на матрицу,
+ * поэтому не требует вычисления тригонометрических функций для прецессии,
+ * нутации и аберрации. Прецессия, нутация и аберрация учитываются строго, а не
+ * по приближённым формулам первого порядка, поэтому результат отличается от
+ * sca_star_update_ctx(). С 1800 по 2200 год разница не превышает 0.006
+ * секунды дуги для склонений до 60 градусов по модулю, 0.035 секунды дуги до
+ * 85 градусов и достигает нескольких секунд дуги в пределах градуса от полюсов
+ * мира (0.25 секунды дуги для Полярной звезды), где приближённые формулы
+ * теряют точность.
+ * @note Перед вызовом данной функции необходимо проинициализировать объект
+ * @a star функцией sca_star_new().
+ */
+#else
+/**
+ * @brief Updates coordinates of the star using reduction matrix.
+ * @param[in,out] star #SCAStar to update coordinates.
+ * @param matrix Reduction matrix for required instance of time.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Position of the star is calculated by multiplying its unit vector by the
+ * matrix, so no trigonometric functions are needed for precession, nutation
+ * and aberration. Precession, nutation and aberration are applied rigorously
+ * rather than with approximate first order formulae, so result differs from
+ * sca_star_update_ctx(). From 1800 to 2200 the difference is below 0.006
+ * arcsecond for declinations within 60 degrees, 0.035 arcsecond up to 85
+ * degrees and reaches several arcseconds within a degree of the celestial
+ * poles (0.25 arcsecond for Polaris), where the approximate formulae lose
+ * accuracy.
+ * @note You must initialize @a star object with sca_star_new() routine
+ * before calling this one.
+ */
+#endif
+int		sca_star_update_matrix		(SCAStar *star, const SCAStarMatrix *matrix);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Инициализиует объект #SCAStarCached.
+ * @param[out] star Структура #SCAStarCached для инициализации.
+ * @param ra2000 Прямое восхождение на эпоху J2000.
+ * @param dec2000 Склонение на эпоху J2000.
+ * @param ra_motion Годовое собственное движение прямого восхождения.
+ * @param dec_motion Годовое собственное движение склонения.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Кроме инициализации поля @a star так же, как sca_star_new(), функция
+ * рассчитывает единичный вектор направления и вектор собственного движения.
+ * Функции sca_star_cached_update_*() используют их вместо тригонометрических
+ * функций от координат на J2000, что ускоряет многократное обновление положения
+ * одной и той же звезды.
+ *
+ * С кэшированными векторами собственное движение учитывается как линейное
+ * движение вектора направления, а не как линейное изменение углов. Поэтому
+ * векторы используются только в пределах @a years_max лет от J2000, где
+ * разница с sca_star_new() не превышает 0.001 секунды дуги. Для большинства
+ * звёзд это столетия, для Веги - 50 лет, для звезды Барнарда - 12 лет; за
+ * пределами интервала положение рассчитывается так же, как для #SCAStar.
+ */
+#else
+/**
+ * @brief Initializes #SCAStarCached object.
+ * @param[out] star #SCAStarCached structure to initialize.
+ * @param ra2000 Right ascension for J2000 epoch.
+ * @param dec2000 Declination for J2000 epoch.
+ * @param ra_motion Annual proper motion of right ascension.
+ * @param dec_motion Annual proper motion of declination.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Besides initializing @a star field the same way as sca_star_new() does, the
+ * routine calculates the direction unit vector and the proper motion vector.
+ * The sca_star_cached_update_*() routines use them instead of trigonometric
+ * functions of J2000 coordinates, which speeds up repeated updates of the same
+ * star.
+ *
+ * With the cached vectors proper motion is applied as linear motion of the
+ * direction vector rather than linear change of the angles. That's why the
+ * vectors are used only within @a years_max years from J2000, where the
+ * difference from sca_star_new() doesn't exceed 0.001 arcsecond. It's
+ * centuries for most stars, 50 years for Vega and 12 years for Barnard's Star;
+ * outside of the interval position is calculated the same way as for #SCAStar.
+ */
+#endif
+int		sca_star_cached_new		(SCAStarCached	*star,
+						 SCAAngle	ra2000,
+						 SCAAngle	dec2000,
+						 SCAAngle	ra_motion,
+						 SCAAngle	dec_motion);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Обновляет положение звезды с кэшированными векторами на заданный
+ * юлианский день.
+ * @param[in,out] star Объект #SCAStarCached для обновления положения.
+ * @param jd Юлианский день в UT для выполнения расчёта.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ * @note Перед вызовом данной функции необходимо проинициализировать объект
+ * @a star функцией sca_star_cached_new().
+ */
+#else
+/**
+ * @brief Updates coordinates of the star with cached vectors to corresponding
+ * Julian Day.
+ * @param[in,out] star #SCAStarCached to update coordinates.
+ * @param jd Julian Day in UT to perform calculation for.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ * @note You must initialize @a star object with sca_star_cached_new() routine
+ * before calling this one.
+ */
+#endif
+int		sca_star_cached_update_jd	(SCAStarCached *star, double jd);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Обновляет положение звезды с кэшированными векторами, используя
+ * контекст расчётов.
+ * @param[in,out] star Объект #SCAStarCached для обновления положения.
+ * @param epoch Контекст расчётов на нужный момент времени.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ * @note Перед вызовом данной функции необходимо проинициализировать объект
+ * @a star функцией sca_star_cached_new().
+ */
+#else
+/**
+ * @brief Updates coordinates of the star with cached vectors using calculation
+ * context.
+ * @param[in,out] star #SCAStarCached to update coordinates.
+ * @param epoch Calculation context for required instance of time.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ * @note You must initialize @a star object with sca_star_cached_new() routine
+ * before calling this one.
+ */
+#endif
+int		sca_star_cached_update_ctx	(SCAStarCached *star, const SCAEpoch *epoch);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Обновляет положение массива звёзд с кэшированными векторами на
+ * заданный момент времени.
+ * @param[in,out] stars Массив объектов #SCAStarCached для обновления положения.
+ * @param n Количество звёзд в массиве @a stars.
+ * @param jd Юлианский день в UT для выполнения расчёта.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Величины, зависящие только от даты, рассчитываются один раз для всего
+ * массива, как в sca_star_update_catalog().
+ * @note Перед вызовом данной функции необходимо проинициализировать все объекты
+ * массива @a stars функцией sca_star_cached_new().
+ */
+#else
+/**
+ * @brief Updates coordinates of the stars with cached vectors array to
+ * corresponding date.
+ * @param[in,out] stars Array of #SCAStarCached objects to update coordinates.
+ * @param n Number of the stars in @a stars array.
+ * @param jd Julian Day in UT to perform calculation for.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Values which depend only on the date are calculated once for the whole
+ * array, as in sca_star_update_catalog().
+ * @note You must initialize all objects in @a stars array with
+ * sca_star_cached_new() routine before calling this one.
+ */
+#endif
+int		sca_star_cached_update_catalog	(SCAStarCached *stars, size_t n, double jd);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Обновляет положение звезды с кэшированными векторами, используя
+ * матрицу редукции.
+ * @param[in,out] star Объект #SCAStarCached для обновления положения.
+ * @param matrix Матрица редукции на нужный момент времени.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * В пределах интервала кэшированных векторов тригонометрические функции
+ * вычисляются только для перевода результата в углы. Точность такая же, как у
+ * sca_star_update_matrix().
+ * @note Перед вызовом данной функции необходимо проинициализировать объект
+ * @a star функцией sca_star_cached_new().
+ */
+#else
+/**
+ * @brief Updates coordinates of the star with cached vectors using reduction
+ * matrix.
+ * @param[in,out] star #SCAStarCached to update coordinates.
+ * @param matrix Reduction matrix for required instance of time.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Within the interval of the cached vectors trigonometric functions are needed
+ * only to convert the result back to angles. Accuracy is the same as for
+ * sca_star_update_matrix().
+ * @note You must initialize @a star object with sca_star_cached_new() routine
+ * before calling this one.
+ */
+#endif
+int		sca_star_cached_update_matrix	(SCAStarCached *star, const SCAStarMatrix *matrix);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает местные координаты звезды для нескольких мест
+ * наблюдения, используя контекст расчётов.
+ * @param star Объект #SCAStar.
+ * @param epoch Контекст расчётов, должен соответствовать дате объекта @a star.
+ * @param longitudes Массив долгот мест наблюдения.
+ * @param latitudes Массив широт мест наблюдения.
+ * @param n Количество мест наблюдения.
+ * @param[out] A Массив азимутов (положительных на запад от юга), может быть NULL.
+ * @param[out] h Массив высот над горизонтом, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ * @note Для учёта рефракции используйте функцию sca_earth_get_refraction().
+ *
+ * Подробности в описании sca_coordinates_equatorial_to_local_many().
+ */
+#else
+/**
+ * @brief Calculates local coordinates of the star for several
+ * sites using calculation context.
+ * @param star #SCAStar object.
+ * @param epoch Calculation context, must correspond to the date of @a star.
+ * @param longitudes Array of the site longitudes.
+ * @param latitudes Array of the site latitudes.
+ * @param n Number of the sites.
+ * @param[out] A Array of azimuths (positive westward from south), may be NULL.
+ * @param[out] h Array of altitudes above horizon, may be NULL.
+ * @return 0 in case if success, -1 otherwise.
+ * @since 0.0.2
+ * @note To take in account refraction use sca_earth_get_refraction() routine.
+ *
+ * See sca_coordinates_equatorial_to_local_many() for details.
+ */
+#endif
+int	sca_star_get_local_coordinates_many	(const SCAStar		*star,
+						 const SCAEpoch		*epoch,
+						 const SCAAngle		*longitudes,
+						 const SCAAngle		*latitudes,
+						 size_t			n,
+						 SCAAngle		*A,
+						 SCAAngle		*h);
 
 SCA_END_DECLS
 
@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "scastarcatalog.h"
+#include "scaepoch.h"
+#include "scajulianday.h"
+#include "scafastmath.h"
+#include "scaprivate.h"
+
+/* Arrays are aligned for the widest vector register (AVX-512) */
+#define SCA_STAR_CATALOG_ALIGN		64
+/* Array capacity granularity, keeps all the arrays in the block aligned */
+#define SCA_STAR_CATALOG_BLOCK		8
+#define SCA_STAR_CATALOG_ARRAYS		6
+
+typedef void (*SCAStarCatalogKernel) (const SCAStarDateTerms	*terms,
+				      size_t			count,
+				      const double		*ra2000,
+				      const double		*dec2000,
+				      const double		*ra_motion,
+				      const double		*dec_motion,
+				      double			*ra,
+				      double			*dec);
+
+/**
+ * @brief Calculates apparent positions for the array of the stars.
+ * @param terms Date dependent terms.
+ * @param count Number of the stars, including padding.
+ * @param ra2000 J2000 right ascensions.
+ * @param dec2000 J2000 declinations.
+ * @param ra_motion Annual proper motions of RA.
+ * @param dec_motion Annual proper motions of Dec.
+ * @param[out] ra Output right ascensions.
+ * @param[out] dec Output declinations.
+ * @since 0.0.2
+ *
+ * This is the same reduction as in scastar.c, but written without calls and
+ * branches. Sine and Cosine of the mean place are obtained from the rotated
+ * vector directly instead of calculating them from the angles again.
+ */
+SCA_ALWAYS_INLINE void
+_sca_star_catalog_kernel (const SCAStarDateTerms	*terms,
+			  size_t			count,
+			  const double	* SCA_RESTRICT	ra2000,
+			  const double	* SCA_RESTRICT	dec2000,
+			  const double	* SCA_RESTRICT	ra_motion,
+			  const double	* SCA_RESTRICT	dec_motion,
+			  double	* SCA_RESTRICT	ra,
+			  double	* SCA_RESTRICT	dec)
+{
+	double	years, zeta, z, sin_z, cos_z, sin_th, cos_th;
+	double	K, eK, sin_obl, cos_obl, tan_obl, d_nut, d_obl;
+	double	abr_c, abr_s, abr_d;
+	size_t	i;
+
+	years	= terms->years;
+	zeta	= terms->zeta;
+	z	= terms->z;
+	sin_z	= terms->sin_z;
+	cos_z	= terms->cos_z;
+	sin_th	= terms->sin_theta;
+	cos_th	= terms->cos_theta;
+	K	= terms->K;
+	eK	= terms->e * terms->K;
+	sin_obl	= terms->sin_obl;
+	cos_obl	= terms->cos_obl;
+	tan_obl	= terms->tan_obl;
+	d_nut	= terms->nut_lon;
+	d_obl	= terms->nut_obl;
+
+	/* Aberration terms which do not depend on the star */
+	abr_c	= (-K) * terms->cos_sun + eK * terms->cos_pi;
+	abr_s	= (-K) * terms->sin_sun + eK * terms->sin_pi;
+	abr_d	= abr_c * cos_obl;
+
+	for (i = 0; i < count; ++i) {
+		double	sin_a, cos_a, sin_d, cos_d;
+		double	A, B, C, rho, inv_rho;
+		double	sin_ra, cos_ra, sin_dec, cos_dec, tan_dec, sec_dec;
+		double	ra_m, dec_m;
+		double	abr_ra, abr_dec, nut_ra, nut_dec;
+
+		/* 1. Proper motion and precession */
+		sca_fast_sincos ((ra2000[i] + years * ra_motion[i] + zeta) * SCA_ANGLE_DEG_TO_RAD,
+				 &sin_a, &cos_a);
+		sca_fast_sincos ((dec2000[i] + years * dec_motion[i]) * SCA_ANGLE_DEG_TO_RAD,
+				 &sin_d, &cos_d);
+
+		A = cos_d * sin_a;
+		B = cos_th * cos_d * cos_a - sin_th * sin_d;
+		C = sin_th * cos_d * cos_a + cos_th * sin_d;
+
+		rho	= sqrt (A * A + B * B);
+		inv_rho	= 1.0 / rho;
+
+		ra_m	= sca_fast_atan2 (A, B) * SCA_ANGLE_RAD_TO_DEG + z;
+		dec_m	= sca_fast_atan2 (C, rho) * SCA_ANGLE_RAD_TO_DEG;
+
+		/* 2. Mean place: (A, B) is rotated by z, C is the Sine of declination */
+		sin_ra	= (A * cos_z + B * sin_z) * inv_rho;
+		cos_ra	= (B * cos_z - A * sin_z) * inv_rho;
+		sin_dec	= C;
+		cos_dec	= rho;
+		sec_dec	= inv_rho;
+		tan_dec	= sin_dec * sec_dec;
+
+		/* 3. Aberration */
+		abr_ra	= (cos_ra * abr_c * cos_obl + sin_ra * abr_s) * sec_dec;
+		abr_dec	= abr_d * (tan_obl * cos_dec - sin_ra * sin_dec) + cos_ra * sin_dec * abr_s;
+
+		/* 4. Nutation */
+		nut_ra	= (cos_obl + sin_obl * sin_ra * tan_dec) * d_nut - (cos_ra * tan_dec) * d_obl;
+		nut_dec	= (sin_obl * cos_ra) * d_nut + sin_ra * d_obl;
+
+		ra[i]	= ra_m + (abr_ra + nut_ra);
+		dec[i]	= dec_m + (abr_dec + nut_dec);
+	}
+}
+
+static void
+_sca_star_catalog_kernel_generic (const SCAStarDateTerms	*terms,
+				  size_t			count,
+				  const double			*ra2000,
+				  const double			*dec2000,
+				  const double			*ra_motion,
+				  const double			*dec_motion,
+				  double			*ra,
+				  double			*dec)
+{
+	_sca_star_catalog_kernel (terms, count, ra2000, dec2000, ra_motion, dec_motion, ra, dec);
+}
+
+#ifdef HAVE_CPU_DISPATCH
+__attribute__ ((target ("avx2,fma"))) static void
+_sca_star_catalog_kernel_avx2 (const SCAStarDateTerms	*terms,
+			       size_t			count,
+			       const double		*ra2000,
+			       const double		*dec2000,
+			       const double		*ra_motion,
+			       const double		*dec_motion,
+			       double			*ra,
+			       double			*dec)
+{
+	_sca_star_catalog_kernel (terms, count, ra2000, dec2000, ra_motion, dec_motion, ra, dec);
+}
+
+__attribute__ ((target ("avx512f"))) static void
+_sca_star_catalog_kernel_avx512 (const SCAStarDateTerms	*terms,
+				 size_t				count,
+				 const double			*ra2000,
+				 const double			*dec2000,
+				 const double			*ra_motion,
+				 const double			*dec_motion,
+				 double				*ra,
+				 double				*dec)
+{
+	_sca_star_catalog_kernel (terms, count, ra2000, dec2000, ra_motion, dec_motion, ra, dec);
+}
+#endif
+
+/**
+ * @brief Selects the best kernel for the current CPU.
+ * @return Kernel to use.
+ * @since 0.0.2
+ *
+ * The choice is not cached: __builtin_cpu_supports() only reads the CPU
+ * model filled in by the runtime at startup, so concurrent calls don't race.
+ */
+static SCAStarCatalogKernel
+_sca_star_catalog_get_kernel (void)
+{
+#ifdef HAVE_CPU_DISPATCH
+	if (__builtin_cpu_supports ("avx512f"))
+		return _sca_star_catalog_kernel_avx512;
+	else if (__builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma"))
+		return _sca_star_catalog_kernel_avx2;
+#endif
+
+	return _sca_star_catalog_kernel_generic;
+}
+
+/**
+ * @brief Calculates capacity of the catalog arrays.
+ * @param size Number of the stars.
+ * @return Capacity rounded up to the block size.
+ * @since 0.0.2
+ */
+static size_t
+_sca_star_catalog_get_capacity (size_t size)
+{
+	return (size + SCA_STAR_CATALOG_BLOCK - 1) / SCA_STAR_CATALOG_BLOCK * SCA_STAR_CATALOG_BLOCK;
+}
+
+int
+sca_star_catalog_new (SCAStarCatalog *catalog, size_t size)
+{
+	size_t	capacity;
+	size_t	bytes;
+	double	*mem;
+
+	if (catalog == NULL)
+		return -1;
+
+	memset (catalog, 0, sizeof (SCAStarCatalog));
+
+	capacity = _sca_star_catalog_get_capacity (size);
+
+	if (capacity == 0)
+		capacity = SCA_STAR_CATALOG_BLOCK;
+
+	if (capacity > ((size_t) -1) / (SCA_STAR_CATALOG_ARRAYS * sizeof (double)))
+		return -1;
+
+	bytes = capacity * SCA_STAR_CATALOG_ARRAYS * sizeof (double);
+
+#ifdef _WIN32
+	if ((mem = _aligned_malloc (bytes, SCA_STAR_CATALOG_ALIGN)) == NULL)
+		return -1;
+#else
+	if (posix_memalign ((void **) &mem, SCA_STAR_CATALOG_ALIGN, bytes) != 0)
+		return -1;
+#endif
+
+	/* Padding stars are zero too, they are processed but never seen */
+	memset (mem, 0, bytes);
+
+	catalog->size		= size;
+	catalog->ra2000		= mem;
+	catalog->dec2000	= mem + capacity;
+	catalog->ra_motion	= mem + capacity * 2;
+	catalog->dec_motion	= mem + capacity * 3;
+	catalog->ra		= mem + capacity * 4;
+	catalog->dec		= mem + capacity * 5;
+	catalog->jd		= SCA_JD_EPOCH_2000;
+
+	return 0;
+}
+
+void
+sca_star_catalog_free (SCAStarCatalog *catalog)
+{
+	if (catalog == NULL || catalog->ra2000 == NULL)
+		return;
+
+#ifdef _WIN32
+	_aligned_free (catalog->ra2000);
+#else
+	free (catalog->ra2000);
+#endif
+
+	memset (catalog, 0, sizeof (SCAStarCatalog));
+}
+
+int
+sca_star_catalog_set (SCAStarCatalog	*catalog,
+		      size_t		index,
+		      SCAAngle		ra2000,
+		      SCAAngle		dec2000,
+		      SCAAngle		ra_motion,
+		      SCAAngle		dec_motion)
+{
+	if (catalog == NULL || catalog->ra2000 == NULL || index >= catalog->size)
+		return -1;
+
+	sca_angle_reduce (&ra2000);
+	sca_angle_reduce (&dec2000);
+	sca_angle_reduce (&ra_motion);
+	sca_angle_reduce (&dec_motion);
+
+	catalog->ra2000[index]		= ra2000;
+	catalog->dec2000[index]		= dec2000;
+	catalog->ra_motion[index]	= ra_motion;
+	catalog->dec_motion[index]	= dec_motion;
+	catalog->ra[index]		= ra2000;
+	catalog->dec[index]		= dec2000;
+
+	return 0;
+}
+
+void
+sca_star_catalog_update_terms (SCAStarCatalog		*catalog,
+			       const SCAStarDateTerms	*terms,
+			       size_t			begin,
+			       size_t			end)
+{
+	SCAStarCatalogKernel	kernel;
+	size_t			capacity;
+
+	capacity = _sca_star_catalog_get_capacity (catalog->size);
+
+	/* Let the last range include the padding */
+	if (end >= catalog->size)
+		end = capacity;
+
+	if (begin >= end)
+		return;
+
+	kernel = _sca_star_catalog_get_kernel ();
+
+	kernel (terms,
+		end - begin,
+		catalog->ra2000 + begin,
+		catalog->dec2000 + begin,
+		catalog->ra_motion + begin,
+		catalog->dec_motion + begin,
+		catalog->ra + begin,
+		catalog->dec + begin);
+}
+
+int
+sca_star_catalog_update (SCAStarCatalog *catalog, double jd)
+{
+	SCAEpoch		epoch;
+	SCAStarDateTerms	terms;
+
+	if (catalog == NULL || catalog->ra2000 == NULL)
+		return -1;
+
+	if (sca_epoch_new (&epoch, jd) != 0)
+		return -1;
+
+	sca_star_date_terms_init (&terms, &epoch);
+	sca_star_catalog_update_terms (catalog, &terms, 0, catalog->size);
+
+	catalog->jd = jd;
+
+	return 0;
+}
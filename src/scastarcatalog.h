@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+ */
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @file scastarcatalog.h
+ * @brief Каталог звёзд
+ * @author Александр Сапрыкин
+ *
+ * #SCAStarCatalog хранит параметры большого количества звёзд в виде отдельных
+ * непрерывных выровненных массивов для каждого поля. Такое представление позволяет
+ * обрабатывать несколько звёзд одной векторной инструкцией процессора. Подходящий
+ * набор инструкций (SSE2, AVX2 или AVX-512) выбирается во время выполнения.
+ * @code
+ * SCAStarCatalog	catalog;
+ * size_t		i;
+ *
+ * sca_star_catalog_new (&catalog, 1000);
+ *
+ * for (i = 0; i < 1000; ++i)
+ *	sca_star_catalog_set (&catalog, i, ra2000[i], dec2000[i], pmra[i], pmdec[i]);
+ *
+ * sca_star_catalog_update (&catalog, jd);
+ *
+ * for (i = 0; i < 1000; ++i)
+ *	printf ("%f %f\n", catalog.ra[i], catalog.dec[i]);
+ *
+ * sca_star_catalog_free (&catalog);
+ * @endcode
+ * Положения звёзд совпадают с результатами sca_star_update_date() с точностью
+ * не хуже 1 миллисекунды дуги.
+ */
+#else
+/**
+ * @file scastarcatalog.h
+ * @brief Catalog of the stars
+ * @author Alexander Saprykin
+ *
+ * #SCAStarCatalog stores parameters of a large number of stars as separate
+ * contiguous aligned arrays, one per field. Such layout allows to process
+ * several stars with a single vector instruction of the CPU. Suitable
+ * instruction set (SSE2, AVX2 or AVX-512) is selected at runtime.
+ * @code
+ * SCAStarCatalog	catalog;
+ * size_t		i;
+ *
+ * sca_star_catalog_new (&catalog, 1000);
+ *
+ * for (i = 0; i < 1000; ++i)
+ *	sca_star_catalog_set (&catalog, i, ra2000[i], dec2000[i], pmra[i], pmdec[i]);
+ *
+ * sca_star_catalog_update (&catalog, jd);
+ *
+ * for (i = 0; i < 1000; ++i)
+ *	printf ("%f %f\n", catalog.ra[i], catalog.dec[i]);
+ *
+ * sca_star_catalog_free (&catalog);
+ * @endcode
+ * Positions of the stars match results of sca_star_update_date() within
+ * 1 milliarcsecond.
+ */
+#endif
+
+#if !defined (__SCALIB_H_INSIDE__) && !defined (SCALIB_COMPILATION)
+#  error "Header files shouldn't be included directly, consider using <scalib.h> instead."
+#endif
+
+#ifndef __SCASTARCATALOG_H__
+#define __SCASTARCATALOG_H__
+
+#include <stddef.h>
+
+#include <scamacros.h>
+#include <scaangle.h>
+
+SCA_BEGIN_DECLS
+
+#ifdef DOXYGEN_RUSSIAN
+/** Определение типа для каталога звёзд. */
+#else
+/** Typedef for catalog of the stars. */
+#endif
+typedef struct _SCAStarCatalog {
+#ifdef DOXYGEN_RUSSIAN
+	/** Количество звёзд в каталоге.			*/
+#else
+	/** Number of the stars in the catalog.		*/
+#endif
+	size_t		size;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Прямые восхождения на J2000.		*/
+#else
+	/** J2000 right ascensions.			*/
+#endif
+	SCAAngle	*ra2000;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Склонения на J2000.				*/
+#else
+	/** J2000 declinations.				*/
+#endif
+	SCAAngle	*dec2000;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Годовые собственные движения RA.		*/
+#else
+	/** Annual proper motions of RA.		*/
+#endif
+	SCAAngle	*ra_motion;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Годовые собственные движения Dec.		*/
+#else
+	/** Annual proper motions of Dec.		*/
+#endif
+	SCAAngle	*dec_motion;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Текущие прямые восхождения.			*/
+#else
+	/** Current right ascensions.			*/
+#endif
+	SCAAngle	*ra;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Текущие склонения.				*/
+#else
+	/** Current declinations.			*/
+#endif
+	SCAAngle	*dec;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Юлианский день, соответствующий положениям.	*/
+#else
+	/** Julian day corresponding to positions.	*/
+#endif
+	double		jd;
+} SCAStarCatalog;
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Создаёт каталог звёзд заданного размера.
+ * @param[out] catalog Структура #SCAStarCatalog для инициализации.
+ * @param size Количество звёзд в каталоге.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Все звёзды каталога инициализируются нулевыми координатами. Память, выделенная
+ * для каталога, должна быть освобождена функцией sca_star_catalog_free().
+ */
+#else
+/**
+ * @brief Creates catalog of the stars with given size.
+ * @param[out] catalog #SCAStarCatalog structure to initialize.
+ * @param size Number of the stars in the catalog.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * All the stars in the catalog are initialized with zero coordinates. Memory
+ * allocated for the catalog must be freed with sca_star_catalog_free().
+ */
+#endif
+int		sca_star_catalog_new		(SCAStarCatalog *catalog, size_t size);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Освобождает память, выделенную для каталога звёзд.
+ * @param catalog Каталог для освобождения.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Frees memory allocated for the catalog of the stars.
+ * @param catalog Catalog to free.
+ * @since 0.0.2
+ */
+#endif
+void		sca_star_catalog_free		(SCAStarCatalog *catalog);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Задаёт параметры звезды в каталоге.
+ * @param catalog Каталог звёзд.
+ * @param index Индекс звезды в каталоге.
+ * @param ra2000 Прямое восхождение на эпоху J2000.
+ * @param dec2000 Склонение на эпоху J2000.
+ * @param ra_motion Годовое собственное движение прямого восхождения.
+ * @param dec_motion Годовое собственное движение склонения.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Sets parameters of the star in the catalog.
+ * @param catalog Catalog of the stars.
+ * @param index Index of the star in the catalog.
+ * @param ra2000 Right ascension for J2000 epoch.
+ * @param dec2000 Declination for J2000 epoch.
+ * @param ra_motion Annual proper motion of right ascension.
+ * @param dec_motion Annual proper motion of declination.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ */
+#endif
+int		sca_star_catalog_set		(SCAStarCatalog	*catalog,
+						 size_t		index,
+						 SCAAngle	ra2000,
+						 SCAAngle	dec2000,
+						 SCAAngle	ra_motion,
+						 SCAAngle	dec_motion);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Обновляет положения всех звёзд каталога на заданный момент времени.
+ * @param catalog Каталог звёзд.
+ * @param jd Юлианский день в UT для выполнения расчёта.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Updates positions of all the stars in the catalog to corresponding
+ * date.
+ * @param catalog Catalog of the stars.
+ * @param jd Julian Day in UT to perform calculation for.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ */
+#endif
+int		sca_star_catalog_update		(SCAStarCatalog *catalog, double jd);
+
+SCA_END_DECLS
+
+#endif /* __SCASTARCATALOG_H__ */
@@ -0,0 +1,330 @@
+/*
+ * Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+ */
+
+/**
+ * Every thread gets its own block of the counters on the first update. Blocks
+ * are linked into a global list under a lock and are never freed, so the
+ * snapshot may walk the list while other threads keep counting into their
+ * blocks. Counters are read and written atomically, so the snapshot never
+ * sees a torn value, but the owner thread doesn't need a locked instruction
+ * to update its own block. The reset only advances the epoch, each thread
+ * clears its own block when it sees a new epoch, and the snapshot skips the
+ * blocks which were not cleared yet. Threads which share the fallback block
+ * update it with atomic additions.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef SCA_ENABLE_STATS
+#  ifdef _WIN32
+#    include <windows.h>
+#  else
+#    include <pthread.h>
+#  endif
+#  if defined (_MSC_VER) && (defined (_M_X64) || defined (_M_IX86))
+#    include <intrin.h>
+#  endif
+#endif
+
+#include "scastats.h"
+#include "scaprivate.h"
+
+static const char * const stats_stage_names[SCA_STATS_STAGES] = {
+	"nutation",
+	"obliquity",
+	"sidereal_time",
+	"planet_series",
+	"planet_series_block",
+	"moon_series",
+	"ecliptic_to_equatorial",
+	"star_precession",
+	"star_aberration",
+	"star_nutation",
+	"ephemeris_cache"
+};
+
+#ifdef SCA_ENABLE_STATS
+typedef struct _SCAStatsThread {
+	SCAStatsCounter		stages[SCA_STATS_STAGES];	/**< Counters of the thread.	*/
+	uint64_t		epoch;				/**< Epoch of the counters.	*/
+	struct _SCAStatsThread	*next;				/**< Next thread in the list.	*/
+} SCAStatsThread;
+
+static SCAStatsThread			*stats_threads	= NULL;
+static SCA_THREAD_LOCAL SCAStatsThread	*stats_thread	= NULL;
+/* Advanced by sca_stats_reset() */
+static uint64_t				stats_epoch	= 0;
+
+/* Shared by the threads which have failed to allocate their own block */
+static SCAStatsThread			stats_fallback;
+
+#  ifdef _WIN32
+static SRWLOCK				stats_lock	= SRWLOCK_INIT;
+#  else
+static pthread_mutex_t			stats_lock	= PTHREAD_MUTEX_INITIALIZER;
+#  endif
+
+static void
+_sca_stats_lock (void)
+{
+#  ifdef _WIN32
+	AcquireSRWLockExclusive (&stats_lock);
+#  else
+	pthread_mutex_lock (&stats_lock);
+#  endif
+}
+
+static void
+_sca_stats_unlock (void)
+{
+#  ifdef _WIN32
+	ReleaseSRWLockExclusive (&stats_lock);
+#  else
+	pthread_mutex_unlock (&stats_lock);
+#  endif
+}
+
+static uint64_t
+_sca_stats_load (const uint64_t *value)
+{
+#  if defined (_MSC_VER)
+	return (uint64_t) InterlockedCompareExchange64 ((volatile LONGLONG *) value, 0, 0);
+#  elif defined (__GNUC__)
+	return __atomic_load_n (value, __ATOMIC_ACQUIRE);
+#  else
+	return *value;
+#  endif
+}
+
+static void
+_sca_stats_store (uint64_t *value, uint64_t x)
+{
+#  if defined (_MSC_VER)
+	InterlockedExchange64 ((volatile LONGLONG *) value, (LONGLONG) x);
+#  elif defined (__GNUC__)
+	__atomic_store_n (value, x, __ATOMIC_RELEASE);
+#  else
+	*value = x;
+#  endif
+}
+
+static void
+_sca_stats_fetch_add (uint64_t *value, uint64_t x)
+{
+#  if defined (_MSC_VER)
+	InterlockedExchangeAdd64 ((volatile LONGLONG *) value, (LONGLONG) x);
+#  elif defined (__GNUC__)
+	__atomic_fetch_add (value, x, __ATOMIC_RELAXED);
+#  else
+	*value += x;
+#  endif
+}
+
+/**
+ * @brief Adds the value to the counter of the current thread.
+ * @param thread Counters of the current thread.
+ * @param value Counter.
+ * @param x Value to add.
+ * @since 0.0.2
+ *
+ * Only the owner thread writes its own block, so a plain atomic load and
+ * store are enough. The fallback block is shared and needs an atomic addition.
+ */
+static void
+_sca_stats_counter_add (const SCAStatsThread *thread, uint64_t *value, uint64_t x)
+{
+	if (thread == &stats_fallback)
+		_sca_stats_fetch_add (value, x);
+	else
+		_sca_stats_store (value, _sca_stats_load (value) + x);
+}
+
+/**
+ * @brief Gets the counters of the current thread.
+ * @return Counters of the current thread.
+ * @since 0.0.2
+ */
+static SCAStatsThread *
+_sca_stats_get_thread (void)
+{
+	SCAStatsThread	*thread;
+
+	uint64_t	epoch;
+	int		i;
+
+	if ((thread = stats_thread) == NULL) {
+		if ((thread = calloc (1, sizeof (SCAStatsThread))) == NULL)
+			thread = &stats_fallback;
+		else {
+			_sca_stats_lock ();
+			thread->next	= stats_threads;
+			stats_threads	= thread;
+			_sca_stats_unlock ();
+		}
+
+		stats_thread = thread;
+	}
+
+	if (thread == &stats_fallback)
+		return thread;
+
+	/* Clear the counters after sca_stats_reset(), then publish the epoch */
+	if ((epoch = _sca_stats_load (&stats_epoch)) != thread->epoch) {
+		for (i = 0; i < SCA_STATS_STAGES; ++i) {
+			_sca_stats_store (&thread->stages[i].calls, 0);
+			_sca_stats_store (&thread->stages[i].cycles, 0);
+			_sca_stats_store (&thread->stages[i].hits, 0);
+			_sca_stats_store (&thread->stages[i].misses, 0);
+		}
+
+		_sca_stats_store (&thread->epoch, epoch);
+	}
+
+	return thread;
+}
+
+/**
+ * @brief Adds the counters of the thread to the snapshot.
+ * @param stats Snapshot.
+ * @param thread Counters of the thread.
+ * @since 0.0.2
+ */
+static void
+_sca_stats_sum (SCAStats *stats, const SCAStatsThread *thread)
+{
+	int	i;
+
+	for (i = 0; i < SCA_STATS_STAGES; ++i) {
+		stats->stages[i].calls	+= _sca_stats_load (&thread->stages[i].calls);
+		stats->stages[i].cycles	+= _sca_stats_load (&thread->stages[i].cycles);
+		stats->stages[i].hits	+= _sca_stats_load (&thread->stages[i].hits);
+		stats->stages[i].misses	+= _sca_stats_load (&thread->stages[i].misses);
+	}
+}
+
+uint64_t
+sca_stats_get_ticks (void)
+{
+#  if defined (_MSC_VER) && (defined (_M_X64) || defined (_M_IX86))
+	return __rdtsc ();
+#  elif defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+	return __builtin_ia32_rdtsc ();
+#  else
+	return 0;
+#  endif
+}
+
+void
+sca_stats_add (SCAStatsStage stage, uint64_t begin)
+{
+	SCAStatsThread	*thread;
+	SCAStatsCounter	*counter;
+
+	thread	= _sca_stats_get_thread ();
+	counter	= &thread->stages[stage];
+
+	_sca_stats_counter_add (thread, &counter->calls, 1);
+	_sca_stats_counter_add (thread, &counter->cycles, sca_stats_get_ticks () - begin);
+}
+
+void
+sca_stats_add_cache (SCAStatsStage stage, int hit)
+{
+	SCAStatsThread	*thread;
+	SCAStatsCounter	*counter;
+
+	thread	= _sca_stats_get_thread ();
+	counter	= &thread->stages[stage];
+
+	_sca_stats_counter_add (thread, hit ? &counter->hits : &counter->misses, 1);
+}
+#endif
+
+int
+sca_stats_is_enabled (void)
+{
+#ifdef SCA_ENABLE_STATS
+	return TRUE;
+#else
+	return FALSE;
+#endif
+}
+
+int
+sca_stats_snapshot (SCAStats *stats)
+{
+#ifdef SCA_ENABLE_STATS
+	const SCAStatsThread	*thread;
+	uint64_t		epoch;
+#endif
+
+	if (stats == NULL)
+		return -1;
+
+	memset (stats, 0, sizeof (SCAStats));
+
+#ifdef SCA_ENABLE_STATS
+	_sca_stats_lock ();
+
+	epoch = _sca_stats_load (&stats_epoch);
+
+	/* Blocks of the previous epochs are not cleared by their threads yet */
+	for (thread = stats_threads; thread != NULL; thread = thread->next)
+		if (_sca_stats_load (&thread->epoch) == epoch)
+			_sca_stats_sum (stats, thread);
+
+	_sca_stats_sum (stats, &stats_fallback);
+
+	_sca_stats_unlock ();
+
+	return 0;
+#else
+	return -1;
+#endif
+}
+
+void
+sca_stats_reset (void)
+{
+#ifdef SCA_ENABLE_STATS
+	int	i;
+
+	_sca_stats_lock ();
+
+	_sca_stats_store (&stats_epoch, _sca_stats_load (&stats_epoch) + 1);
+
+	for (i = 0; i < SCA_STATS_STAGES; ++i) {
+		_sca_stats_store (&stats_fallback.stages[i].calls, 0);
+		_sca_stats_store (&stats_fallback.stages[i].cycles, 0);
+		_sca_stats_store (&stats_fallback.stages[i].hits, 0);
+		_sca_stats_store (&stats_fallback.stages[i].misses, 0);
+	}
+
+	_sca_stats_unlock ();
+#endif
+}
+
+const char *
+sca_stats_get_stage_name (SCAStatsStage stage)
+{
+	if (stage < 0 || stage >= SCA_STATS_STAGES)
+		return NULL;
+
+	return stats_stage_names[stage];
+}
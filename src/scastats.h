@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+ */
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @file scastats.h
+ * @brief Статистика внутренних этапов расчёта
+ * @author Александр Сапрыкин
+ *
+ * Если библиотека собрана с опцией SCA_ENABLE_STATS=ON, для каждого
+ * внутреннего этапа расчёта (ряды VSOP87, нутация, наклон эклиптики,
+ * преобразование координат, прецессия звезды и т.д.) считаются количество
+ * вызовов и затраченные такты процессора, а для кэша эфемерид - количество
+ * попаданий и промахов. Счётчики ведутся отдельно в каждом потоке без
+ * блокировок, функция sca_stats_snapshot() суммирует их по всем потокам:
+ * @code
+ * SCAStats	stats;
+ * int		i;
+ *
+ * if (sca_stats_snapshot (&stats) == 0)
+ *	for (i = 0; i < SCA_STATS_STAGES; ++i)
+ *		printf ("%s: %llu calls, %llu cycles\n",
+ *			sca_stats_get_stage_name ((SCAStatsStage) i),
+ *			(unsigned long long) stats.stages[i].calls,
+ *			(unsigned long long) stats.stages[i].cycles);
+ * @endcode
+ * Такты включают вложенные этапы: например, такты
+ * #SCA_STATS_SIDEREAL_TIME включают вызов sca_earth_get_nutation(). Такты
+ * считаются по счётчику TSC на x86, на других платформах они равны 0. По
+ * умолчанию статистика не собирается и не влияет на скорость расчётов.
+ */
+#else
+/**
+ * @file scastats.h
+ * @brief Statistics of the internal calculation stages
+ * @author Alexander Saprykin
+ *
+ * If the library is built with SCA_ENABLE_STATS=ON, every internal stage of
+ * the calculations (VSOP87 series, nutation, ecliptic obliquity, coordinates
+ * conversion, star precession, etc.) counts its calls and spent CPU cycles,
+ * the ephemeris cache also counts hits and misses. Counters are kept in every
+ * thread separately without locks, sca_stats_snapshot() sums them over all the
+ * threads:
+ * @code
+ * SCAStats	stats;
+ * int		i;
+ *
+ * if (sca_stats_snapshot (&stats) == 0)
+ *	for (i = 0; i < SCA_STATS_STAGES; ++i)
+ *		printf ("%s: %llu calls, %llu cycles\n",
+ *			sca_stats_get_stage_name ((SCAStatsStage) i),
+ *			(unsigned long long) stats.stages[i].calls,
+ *			(unsigned long long) stats.stages[i].cycles);
+ * @endcode
+ * Cycles include the nested stages: e.g. cycles of #SCA_STATS_SIDEREAL_TIME
+ * include the sca_earth_get_nutation() call. Cycles are taken from the TSC
+ * counter on x86, they are 0 on other platforms. Statistics are not collected
+ * by default and don't affect the calculations speed.
+ */
+#endif
+
+#if !defined (__SCALIB_H_INSIDE__) && !defined (SCALIB_COMPILATION)
+#  error "Header files shouldn't be included directly, consider using <scalib.h> instead."
+#endif
+
+#ifndef __SCASTATS_H__
+#define __SCASTATS_H__
+
+#include <stdint.h>
+
+#include <scamacros.h>
+
+SCA_BEGIN_DECLS
+
+#ifdef DOXYGEN_RUSSIAN
+/** Внутренние этапы расчёта. */
+#else
+/** Internal calculation stages. */
+#endif
+typedef enum _SCAStatsStage {
+#ifdef DOXYGEN_RUSSIAN
+	/** sca_earth_get_nutation().					*/
+#else
+	/** sca_earth_get_nutation().					*/
+#endif
+	SCA_STATS_NUTATION		= 0,
+
+#ifdef DOXYGEN_RUSSIAN
+	/** sca_earth_get_ecliptic_obliquity().				*/
+#else
+	/** sca_earth_get_ecliptic_obliquity().				*/
+#endif
+	SCA_STATS_OBLIQUITY		= 1,
+
+#ifdef DOXYGEN_RUSSIAN
+	/** sca_jd_get_sidereal_time().					*/
+#else
+	/** sca_jd_get_sidereal_time().					*/
+#endif
+	SCA_STATS_SIDEREAL_TIME		= 2,
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Ряды VSOP87 для одного момента времени.			*/
+#else
+	/** VSOP87 series for a single instance.			*/
+#endif
+	SCA_STATS_PLANET_SERIES		= 3,
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Ряды VSOP87 для блока моментов времени, один вызов на блок.	*/
+#else
+	/** VSOP87 series for a block of instances, a call per block.	*/
+#endif
+	SCA_STATS_PLANET_SERIES_BLOCK	= 4,
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Периодические члены Луны.					*/
+#else
+	/** Moon's periodic terms.					*/
+#endif
+	SCA_STATS_MOON_SERIES		= 5,
+
+#ifdef DOXYGEN_RUSSIAN
+	/** sca_coordinates_ecliptic_to_equatorial().			*/
+#else
+	/** sca_coordinates_ecliptic_to_equatorial().			*/
+#endif
+	SCA_STATS_ECLIPTIC_TO_EQUATORIAL	= 6,
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Прецессия звезды.						*/
+#else
+	/** Star precession.						*/
+#endif
+	SCA_STATS_STAR_PRECESSION	= 7,
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Аберрация для звезды.					*/
+#else
+	/** Star aberration.						*/
+#endif
+	SCA_STATS_STAR_ABERRATION	= 8,
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Нутация для звезды.						*/
+#else
+	/** Star nutation.						*/
+#endif
+	SCA_STATS_STAR_NUTATION		= 9,
+
+#ifdef DOXYGEN_RUSSIAN
+	/** sca_ephemeris_cache_get(), с попаданиями и промахами.	*/
+#else
+	/** sca_ephemeris_cache_get(), with hits and misses.		*/
+#endif
+	SCA_STATS_EPHEMERIS_CACHE	= 10,
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Количество этапов.						*/
+#else
+	/** Number of the stages.					*/
+#endif
+	SCA_STATS_STAGES		= 11
+} SCAStatsStage;
+
+#ifdef DOXYGEN_RUSSIAN
+/** Определение типа для счётчиков этапа. */
+#else
+/** Typedef for the stage counters. */
+#endif
+typedef struct _SCAStatsCounter {
+#ifdef DOXYGEN_RUSSIAN
+	/** Количество вызовов.						*/
+#else
+	/** Number of the calls.					*/
+#endif
+	uint64_t	calls;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Такты процессора, включая вложенные этапы.			*/
+#else
+	/** CPU cycles, including the nested stages.			*/
+#endif
+	uint64_t	cycles;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Попадания в кэш, только для кэшей.				*/
+#else
+	/** Cache hits, only for the caches.				*/
+#endif
+	uint64_t	hits;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Промахи кэша, только для кэшей.				*/
+#else
+	/** Cache misses, only for the caches.				*/
+#endif
+	uint64_t	misses;
+} SCAStatsCounter;
+
+#ifdef DOXYGEN_RUSSIAN
+/** Определение типа для снимка статистики. */
+#else
+/** Typedef for the statistics snapshot. */
+#endif
+typedef struct _SCAStats {
+#ifdef DOXYGEN_RUSSIAN
+	/** Счётчики, индексированные #SCAStatsStage.			*/
+#else
+	/** Counters indexed by #SCAStatsStage.				*/
+#endif
+	SCAStatsCounter	stages[SCA_STATS_STAGES];
+} SCAStats;
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Проверяет, собирается ли статистика.
+ * @return TRUE, если библиотека собрана с опцией SCA_ENABLE_STATS=ON, иначе
+ * FALSE.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Checks whether the statistics are collected.
+ * @return TRUE if the library is built with SCA_ENABLE_STATS=ON, FALSE
+ * otherwise.
+ * @since 0.0.2
+ */
+#endif
+int		sca_stats_is_enabled		(void);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Получает снимок статистики, просуммированной по всем потокам.
+ * @param[out] stats Снимок статистики.
+ * @return 0 в случае успеха, -1, если статистика не собирается.
+ * @since 0.0.2
+ *
+ * Функцию можно вызывать из любого потока во время расчётов. Счётчики других
+ * потоков читаются без синхронизации, поэтому снимок может не учитывать
+ * последние вызовы. Счётчики завершившихся потоков сохраняются. Если
+ * статистика не собирается, все счётчики равны 0.
+ */
+#else
+/**
+ * @brief Gets the snapshot of the statistics summed over all the threads.
+ * @param[out] stats Statistics snapshot.
+ * @return 0 in case of success, -1 if the statistics are not collected.
+ * @since 0.0.2
+ *
+ * The routine may be called from any thread during the calculations. Counters
+ * of other threads are read without synchronization, so the snapshot may miss
+ * the latest calls. Counters of the finished threads are kept. If the
+ * statistics are not collected, all the counters are 0.
+ */
+#endif
+int		sca_stats_snapshot		(SCAStats *stats);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Сбрасывает счётчики всех потоков.
+ * @since 0.0.2
+ *
+ * Вызовы, выполняемые в других потоках во время сброса, могут быть учтены
+ * частично. Для периодического опроса лучше вычислять разность снимков.
+ */
+#else
+/**
+ * @brief Resets the counters of all the threads.
+ * @since 0.0.2
+ *
+ * Calls performed in other threads during the reset may be counted
+ * partially. For periodic polling it's better to take the difference of the
+ * snapshots.
+ */
+#endif
+void		sca_stats_reset			(void);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Получает имя этапа для вывода.
+ * @param stage Этап.
+ * @return Имя этапа, например, "nutation", NULL для неверного этапа.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Gets the stage name for the output.
+ * @param stage Stage.
+ * @return Stage name, e.g. "nutation", NULL for invalid stage.
+ * @since 0.0.2
+ */
+#endif
+const char *	sca_stats_get_stage_name	(SCAStatsStage stage);
+
+SCA_END_DECLS
+
+#endif /* __SCASTATS_H__ */
@@ -21,6 +21,9 @@
 #include <scaplanetdata.h>
 #include <scaprivate.h>
 
+/* Number of the instances for which Earth's series are evaluated at once */
+#define SCA_SUN_SERIES_BLOCK	64
+
 int
 sca_sun_get_mean_longitude (double jd, SCAAngle *L)
 {
@@ -82,48 +85,179 @@ sca_sun_get_mean_anomaly (double jd, SCAAngle *M)
 	return 0;
 }
 
+static void
+_sca_sun_apply_corrections (SCAAngle d_lon, SCAAngle *L, double R)
+{
+	SCAAngle	d_abr;
+
+	/* Take nutation into account */
+	*L += d_lon;
+
+	/* Take aberration into account:
+	 * this constant is K * (1 - e^2), where K is aberration constant, and e is
+	 * Earth's orbit eccentricity */
+	d_abr	= sca_angle_from_degrees (0, 0, -20, 489.8) / R;
+	*L	+= d_abr; 
+}
+
+static void
+_sca_sun_get_apparent_ecliptic (double jd, SCAAngle d_lon, SCAAngle *L, SCAAngle *B, double *R)
+{
+	sca_planet_data_get (SCA_PLANET_EARTH, jd, L, B, R);
+
+	*L += 180.0;
+	*B = -(*B);
+
+	_sca_sun_apply_corrections (d_lon, L, *R);
+}
+
+/**
+ * @brief Finishes Sun's position calculation for the Earth's heliocentric coordinates.
+ * @param s #SCASun object for updating.
+ * @param jd Julian Day.
+ * @param L Earth's heliocentric longitude.
+ * @param B Earth's heliocentric latitude.
+ * @param R Earth's distance from the Sun in AUs.
+ * @since 0.0.2
+ */
+static void
+_sca_sun_update_heliocentric (SCASun *s, double jd, SCAAngle L, SCAAngle B, double R)
+{
+	SCAAngle	d_lon;
+
+	sca_earth_get_nutation (jd, &d_lon, NULL);
+
+	L += 180.0;
+	B = -B;
+
+	_sca_sun_apply_corrections (d_lon, &L, R);
+
+	sca_coordinates_ecliptic_to_equatorial (jd, L, B, &s->ra, &s->dec);
+
+	s->jd	= jd;
+	s->dst	= R;
+}
+
 int
 sca_sun_update_date (SCASun *s, SCADate *date)
 {
-	double		jd;
-	SCAAngle	d_lon, d_abr;
+	if (s == NULL || date == NULL)
+		return -1;
+
+	return sca_sun_update_jd (s, sca_jd_from_calendar_date (date));
+}
 
+int
+sca_sun_update_jd (SCASun *s, double jd)
+{
 	SCAAngle	L, B;
 	double		R;
-	
-	if (s == NULL || date == NULL)
+
+	if (s == NULL || jd < 0)
 		return -1;
 
-	jd	= sca_jd_from_calendar_date (date);
-		
 	sca_planet_data_get (SCA_PLANET_EARTH, jd, &L, &B, &R);
+	_sca_sun_update_heliocentric (s, jd, L, B, R);
 
-	L += 180.0;
-	B = -B;
+	return 0;
+}
 
-	/* Take nutation into account */
-	sca_earth_get_nutation (jd, &d_lon, NULL);
-	L += d_lon;
+int
+sca_sun_update_series (SCASun *suns, const double *jds, size_t n)
+{
+	SCAAngle	L[SCA_SUN_SERIES_BLOCK], B[SCA_SUN_SERIES_BLOCK];
+	double		R[SCA_SUN_SERIES_BLOCK];
+	size_t		i, k, count;
 
-	/* Take aberration into account:
-	 * this constant is K * (1 - e^2), where K is aberration constant, and e is
-	 * Earth's orbit eccentricity */
-	d_abr	= sca_angle_from_degrees (0, 0, -20, 489.8) / R;
-	L	+= d_abr; 
+	if ((suns == NULL || jds == NULL) && n > 0)
+		return -1;
 
-	sca_coordinates_ecliptic_to_equatorial (jd, L, B, &s->ra, &s->dec);
+	for (i = 0; i < n; ++i)
+		if (jds[i] < 0)
+			return -1;
 
-	s->jd	= jd;
+	/* Earth's series are evaluated for a block of the instances at once */
+	for (i = 0; i < n; i += count) {
+		count = (n - i < SCA_SUN_SERIES_BLOCK) ? n - i : SCA_SUN_SERIES_BLOCK;
+
+		if (sca_planet_data_get_many (SCA_PLANET_EARTH, jds + i, count, L, B, R) != 0)
+			return -1;
+
+		for (k = 0; k < count; ++k)
+			_sca_sun_update_heliocentric (suns + i + k, jds[i + k], L[k], B[k], R[k]);
+	}
+
+	return 0;
+}
+
+int
+sca_sun_update_ctx (SCASun *s, const SCAEpoch *epoch)
+{
+	SCAAngle	L, B;
+	double		R;
+
+	if (s == NULL || epoch == NULL)
+		return -1;
+
+	_sca_sun_get_apparent_ecliptic (epoch->jd, epoch->nut_lon, &L, &B, &R);
+
+	sca_coordinates_ecliptic_to_equatorial_ctx (epoch, L, B, &s->ra, &s->dec);
+
+	s->jd	= epoch->jd;
 	s->dst	= R;
-	
+
 	return 0;
 }
 
 int
-sca_sun_get_local_coordinates (SCASun		*s,
-			       SCAGeoLocation	*loc,
-			       SCAAngle		*A,
-			       SCAAngle		*h)
+sca_sun_update_cache (SCASun *s, const SCAEpoch *epoch, const SCAEphemerisCache *cache)
+{
+	SCAAngle	L, B;
+	double		R;
+
+	if (s == NULL || epoch == NULL)
+		return -1;
+
+	if (sca_ephemeris_cache_get (cache, SCA_EPHEMERIS_SUN, epoch->jd, &L, &B, &R) != 0)
+		return -1;
+
+	_sca_sun_apply_corrections (epoch->nut_lon, &L, R);
+
+	sca_coordinates_ecliptic_to_equatorial_ctx (epoch, L, B, &s->ra, &s->dec);
+
+	s->jd	= epoch->jd;
+	s->dst	= R;
+
+	return 0;
+}
+
+int
+sca_sun_update_stepper (SCASun *s, const SCAEpoch *epoch, const SCATimeStepper *stepper)
+{
+	SCAAngle	L, B;
+	double		R;
+
+	if (s == NULL || epoch == NULL || stepper == NULL || epoch->jd != stepper->jd)
+		return -1;
+
+	if (sca_time_stepper_get (stepper, SCA_EPHEMERIS_SUN, &L, &B, &R) != 0)
+		return -1;
+
+	_sca_sun_apply_corrections (epoch->nut_lon, &L, R);
+
+	sca_coordinates_ecliptic_to_equatorial_ctx (epoch, L, B, &s->ra, &s->dec);
+
+	s->jd	= epoch->jd;
+	s->dst	= R;
+
+	return 0;
+}
+
+int
+sca_sun_get_local_coordinates (const SCASun		*s,
+			       const SCAGeoLocation	*loc,
+			       SCAAngle			*A,
+			       SCAAngle			*h)
 {
 	SCAAngle d_ra, d_dec;
 
@@ -132,11 +266,83 @@ sca_sun_get_local_coordinates (SCASun		*s,
 
 	/* Take parallax into account */
 	sca_earth_get_parallax_equatorial (s->jd, s->dst, loc, s->ra, s->dec, &d_ra, &d_dec);
-	
-	s->ra	+= d_ra;
-	s->dec	+= d_dec;
+	sca_coordinates_equatorial_to_local (s->jd, loc, s->ra + d_ra, s->dec + d_dec, A, h);
+
+	return 0;
+}
 
-	sca_coordinates_equatorial_to_local (s->jd, loc, s->ra, s->dec, A, h);
+int
+sca_sun_get_local_coordinates_ctx (const SCASun		*s,
+				   const SCAEpoch	*epoch,
+				   const SCAGeoLocation	*loc,
+				   SCAAngle		*A,
+				   SCAAngle		*h)
+{
+	SCAAngle d_ra, d_dec;
+
+	if (s == NULL || epoch == NULL || loc == NULL || epoch->jd != s->jd)
+		return -1;
+
+	/* Take parallax into account */
+	sca_earth_get_parallax_equatorial_ctx (epoch, s->dst, loc, s->ra, s->dec, &d_ra, &d_dec);
+	sca_coordinates_equatorial_to_local_ctx (epoch, loc, s->ra + d_ra, s->dec + d_dec, A, h);
+
+	return 0;
+}
+
+int
+sca_sun_get_local_coordinates_observer (const SCASun		*s,
+					const SCAEpoch		*epoch,
+					const SCAObserver	*obs,
+					SCAAngle		*A,
+					SCAAngle		*h)
+{
+	SCAAngle d_ra, d_dec;
+
+	if (s == NULL || epoch == NULL || obs == NULL || epoch->jd != s->jd)
+		return -1;
+
+	/* Take parallax into account */
+	sca_earth_get_parallax_equatorial_observer (epoch, s->dst, obs, s->ra, s->dec, &d_ra, &d_dec);
+	sca_coordinates_equatorial_to_local_observer (epoch, obs, s->ra + d_ra, s->dec + d_dec, A, h);
 
 	return 0;
 }
+
+int
+sca_sun_get_topocentric_equatorial (const SCASun	*s,
+				    const SCAEpoch	*epoch,
+				    const SCAObserver	*obs,
+				    SCAAngle		*ra,
+				    SCAAngle		*dec)
+{
+	SCAAngle d_ra, d_dec;
+
+	if (s == NULL || epoch == NULL || obs == NULL || epoch->jd != s->jd)
+		return -1;
+
+	sca_earth_get_parallax_equatorial_observer (epoch, s->dst, obs, s->ra, s->dec, &d_ra, &d_dec);
+
+	if (ra != NULL)
+		*ra = s->ra + d_ra;
+
+	if (dec != NULL)
+		*dec = s->dec + d_dec;
+
+	return 0;
+}
+
+int
+sca_sun_get_local_coordinates_many (const SCASun	*s,
+				    const SCAEpoch	*epoch,
+				    const SCAAngle	*longitudes,
+				    const SCAAngle	*latitudes,
+				    size_t		n,
+				    SCAAngle		*A,
+				    SCAAngle		*h)
+{
+	if (s == NULL || epoch == NULL || epoch->jd != s->jd)
+		return -1;
+
+	return sca_coordinates_equatorial_to_local_many (epoch, s->ra, s->dec, s->dst, longitudes, latitudes, n, A, h);
+}
@@ -89,11 +89,15 @@
 #define __SCASUN_H__
 
 #include <math.h>
+#include <stddef.h>
 
 #include <scamacros.h>
 #include <scaangle.h>
 #include <scajulianday.h>
 #include <scacoordinates.h>
+#include <scaepoch.h>
+#include <scaephemeriscache.h>
+#include <scatimestepper.h>
 
 SCA_BEGIN_DECLS
 
@@ -210,6 +214,62 @@ int	sca_sun_get_mean_anomaly	(double jd, SCAAngle *M);
 #endif
 int	sca_sun_update_date		(SCASun *s, SCADate *date);
 
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает положение Солнца на заданный юлианский день.
+ * @param[out] s Объект #SCASun для обновления.
+ * @param jd Юлианский день в UT для выполнения расчёта.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Результат совпадает с результатом sca_sun_update_date() для даты,
+ * соответствующей @a jd.
+ */
+#else
+/**
+ * @brief Calculates Sun's position for given Julian Day.
+ * @param[out] s #SCASun object for updating.
+ * @param jd Julian Day in UT to perform calculation for.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Result is the same as of sca_sun_update_date() for the date corresponding
+ * to @a jd.
+ */
+#endif
+int	sca_sun_update_jd		(SCASun *s, double jd);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает положения Солнца на несколько моментов времени.
+ * @param[out] suns Массив объектов #SCASun для результатов.
+ * @param jds Массив юлианских дней в UT.
+ * @param n Количество моментов времени.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Ряды VSOP87 для Земли рассчитываются сразу для блока моментов времени
+ * функцией sca_planet_data_get_many(). Результаты совпадают с результатами
+ * sca_sun_update_jd(). Если хотя бы один юлианский день отрицателен, объекты
+ * не обновляются.
+ */
+#else
+/**
+ * @brief Calculates positions of the Sun for several instances of time.
+ * @param[out] suns Array of #SCASun objects for the results.
+ * @param jds Array of Julian Days in UT.
+ * @param n Number of the instances of time.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * VSOP87 series of the Earth are evaluated for a block of the instances at
+ * once with sca_planet_data_get_many(). Results are the same as of
+ * sca_sun_update_jd(). Objects are not updated if any of the Julian Days is
+ * negative.
+ */
+#endif
+int	sca_sun_update_series		(SCASun *suns, const double *jds, size_t n);
+
 #ifdef DOXYGEN_RUSSIAN
 /**
  * @brief Рассчитывает местные координаты Солнца с учётом параллакса.
@@ -220,6 +280,10 @@ int	sca_sun_update_date		(SCASun *s, SCADate *date);
  * @return 0 в случае успеха, иначе -1.
  * @since 0.0.1
  * @note Для учёта рефракции используйте функцию sca_earth_get_refraction().
+ *
+ * Координаты объекта не изменяются, поэтому один объект может одновременно
+ * использоваться из нескольких потоков. Топоцентрические координаты
+ * возвращает функция sca_sun_get_topocentric_equatorial().
  */
 #else
 /**
@@ -231,9 +295,226 @@ int	sca_sun_update_date		(SCASun *s, SCADate *date);
  * @return 0 in case if success, -1 otherwise.
  * @since 0.0.1
  * @note To take in account refraction use sca_earth_get_refraction() routine.
+ *
+ * Coordinates of the object are not modified, so a single object may be used
+ * from several threads at once. Use sca_sun_get_topocentric_equatorial() to
+ * get topocentric coordinates.
+ */
+#endif
+int	sca_sun_get_local_coordinates	(const SCASun *s, const SCAGeoLocation *loc, SCAAngle *A, SCAAngle *h);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает положение Солнца, используя контекст расчётов.
+ * @param[out] s Объект #SCASun для обновления.
+ * @param epoch Контекст расчётов на нужный момент времени.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Calculates Sun's position using calculation context.
+ * @param[out] s #SCASun object for updating.
+ * @param epoch Calculation context for required instance of time.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ */
+#endif
+int	sca_sun_update_ctx		(SCASun *s, const SCAEpoch *epoch);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает положение Солнца, используя кэш эфемерид.
+ * @param[out] s Объект #SCASun для обновления.
+ * @param epoch Контекст расчётов на нужный момент времени.
+ * @param cache Кэш эфемерид, содержащий #SCA_EPHEMERIS_SUN.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Возвращает ошибку, если момент времени находится вне интервала кэша.
+ */
+#else
+/**
+ * @brief Calculates Sun's position using cache of the ephemerides.
+ * @param[out] s #SCASun object for updating.
+ * @param epoch Calculation context for required instance of time.
+ * @param cache Cache of the ephemerides containing #SCA_EPHEMERIS_SUN.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Fails if the instance of time is outside of the cache interval.
+ */
+#endif
+int	sca_sun_update_cache		(SCASun *s, const SCAEpoch *epoch, const SCAEphemerisCache *cache);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает положение Солнца для текущего шага расчёта с постоянным
+ * шагом.
+ * @param[out] s Объект #SCASun для обновления.
+ * @param epoch Контекст расчётов на момент текущего шага.
+ * @param stepper Расчёт с постоянным шагом, содержащий #SCA_EPHEMERIS_SUN.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Возвращает ошибку, если момент времени контекста не совпадает с текущим
+ * шагом.
+ */
+#else
+/**
+ * @brief Calculates Sun's position for the current step of the calculations
+ * with a fixed time step.
+ * @param[out] s #SCASun object for updating.
+ * @param epoch Calculation context for the instance of the current step.
+ * @param stepper Calculations with a fixed time step containing
+ * #SCA_EPHEMERIS_SUN.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Fails if the instance of the context doesn't match the current step.
+ */
+#endif
+int	sca_sun_update_stepper		(SCASun *s, const SCAEpoch *epoch, const SCATimeStepper *stepper);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает местные координаты Солнца с учётом параллакса, используя
+ * контекст расчётов.
+ * @param s Объект #SCASun.
+ * @param epoch Контекст расчётов, должен соответствовать дате объекта @a s.
+ * @param loc Положение наблюдателя.
+ * @param[out] A Азимут (положительный на запад от юга), может быть NULL.
+ * @param[out] h Высота над горизонтом, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ * @note Для учёта рефракции используйте функцию sca_earth_get_refraction().
+ *
+ * Координаты объекта не изменяются, поэтому один объект может одновременно
+ * использоваться из нескольких потоков. Топоцентрические координаты
+ * возвращает функция sca_sun_get_topocentric_equatorial().
+ */
+#else
+/**
+ * @brief Calculates local coordinates of the Sun including parallax corrections
+ * using calculation context.
+ * @param s #SCASun object.
+ * @param epoch Calculation context, must correspond to the date of @a s.
+ * @param loc Observer location.
+ * @param[out] A Azimuth (positive westward from south), may be NULL.
+ * @param[out] h Altitude above horizon, may be NULL.
+ * @return 0 in case if success, -1 otherwise.
+ * @since 0.0.2
+ * @note To take in account refraction use sca_earth_get_refraction() routine.
+ *
+ * Coordinates of the object are not modified, so a single object may be used
+ * from several threads at once. Use sca_sun_get_topocentric_equatorial() to
+ * get topocentric coordinates.
+ */
+#endif
+int	sca_sun_get_local_coordinates_ctx	(const SCASun *s, const SCAEpoch *epoch, const SCAGeoLocation *loc, SCAAngle *A, SCAAngle *h);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает местные координаты Солнца с учётом параллакса для
+ * наблюдателя, используя контекст расчётов.
+ * @param s Объект #SCASun.
+ * @param epoch Контекст расчётов, должен соответствовать дате объекта @a s.
+ * @param obs Наблюдатель.
+ * @param[out] A Азимут (положительный на запад от юга), может быть NULL.
+ * @param[out] h Высота над горизонтом, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ * @note Для учёта рефракции используйте функцию sca_earth_get_refraction().
+ */
+#else
+/**
+ * @brief Calculates local coordinates of the Sun including parallax corrections for
+ * the observer using calculation context.
+ * @param s #SCASun object.
+ * @param epoch Calculation context, must correspond to the date of @a s.
+ * @param obs Observer.
+ * @param[out] A Azimuth (positive westward from south), may be NULL.
+ * @param[out] h Altitude above horizon, may be NULL.
+ * @return 0 in case if success, -1 otherwise.
+ * @since 0.0.2
+ * @note To take in account refraction use sca_earth_get_refraction() routine.
+ */
+#endif
+int	sca_sun_get_local_coordinates_observer	(const SCASun *s, const SCAEpoch *epoch, const SCAObserver *obs, SCAAngle *A, SCAAngle *h);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает топоцентрические экваториальные координаты Солнца для
+ * наблюдателя, используя контекст расчётов.
+ * @param s Объект #SCASun.
+ * @param epoch Контекст расчётов, должен соответствовать дате объекта @a s.
+ * @param obs Наблюдатель.
+ * @param[out] ra Прямое восхождение с учётом параллакса, может быть NULL.
+ * @param[out] dec Склонение с учётом параллакса, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Координаты объекта @a s остаются геоцентрическими.
+ */
+#else
+/**
+ * @brief Calculates topocentric equatorial coordinates of the Sun for the
+ * observer using calculation context.
+ * @param s #SCASun object.
+ * @param epoch Calculation context, must correspond to the date of @a s.
+ * @param obs Observer.
+ * @param[out] ra Right ascension including parallax, may be NULL.
+ * @param[out] dec Declination including parallax, may be NULL.
+ * @return 0 in case if success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Coordinates of the @a s object stay geocentric.
+ */
+#endif
+int	sca_sun_get_topocentric_equatorial	(const SCASun *s, const SCAEpoch *epoch, const SCAObserver *obs, SCAAngle *ra, SCAAngle *dec);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Рассчитывает местные координаты Солнца с учётом параллакса для нескольких мест
+ * наблюдения, используя контекст расчётов.
+ * @param s Объект #SCASun.
+ * @param epoch Контекст расчётов, должен соответствовать дате объекта @a s.
+ * @param longitudes Массив долгот мест наблюдения.
+ * @param latitudes Массив широт мест наблюдения.
+ * @param n Количество мест наблюдения.
+ * @param[out] A Массив азимутов (положительных на запад от юга), может быть NULL.
+ * @param[out] h Массив высот над горизонтом, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ * @note Для учёта рефракции используйте функцию sca_earth_get_refraction().
+ *
+ * Подробности в описании sca_coordinates_equatorial_to_local_many().
+ */
+#else
+/**
+ * @brief Calculates local coordinates of the Sun including parallax corrections for several
+ * sites using calculation context.
+ * @param s #SCASun object.
+ * @param epoch Calculation context, must correspond to the date of @a s.
+ * @param longitudes Array of the site longitudes.
+ * @param latitudes Array of the site latitudes.
+ * @param n Number of the sites.
+ * @param[out] A Array of azimuths (positive westward from south), may be NULL.
+ * @param[out] h Array of altitudes above horizon, may be NULL.
+ * @return 0 in case if success, -1 otherwise.
+ * @since 0.0.2
+ * @note To take in account refraction use sca_earth_get_refraction() routine.
+ *
+ * See sca_coordinates_equatorial_to_local_many() for details.
  */
 #endif
-int	sca_sun_get_local_coordinates	(SCASun *s, SCAGeoLocation *loc, SCAAngle *A, SCAAngle *h);
+int	sca_sun_get_local_coordinates_many	(const SCASun		*s,
+						 const SCAEpoch		*epoch,
+						 const SCAAngle		*longitudes,
+						 const SCAAngle		*latitudes,
+						 size_t			n,
+						 SCAAngle		*A,
+						 SCAAngle		*h);
 
 SCA_END_DECLS
 
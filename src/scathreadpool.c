@@ -0,0 +1,345 @@
+/*
+ * Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+ */
+
+#include <stdlib.h>
+
+#ifndef _WIN32
+#  include <pthread.h>
+#endif
+
+#include "scathreadpool.h"
+
+#ifndef _WIN32
+/* Range of the chunks owned by a worker, padded to avoid false sharing */
+typedef struct _SCAThreadPoolQueue {
+	pthread_mutex_t	lock;
+	size_t		begin;
+	size_t		end;
+	char		pad[64];
+} SCAThreadPoolQueue;
+
+typedef struct _SCAThreadPoolWorker {
+	SCAThreadPool	*pool;
+	int		index;
+} SCAThreadPoolWorker;
+#endif
+
+struct _SCAThreadPool {
+	int			threads;
+#ifndef _WIN32
+	pthread_t		*tids;
+	SCAThreadPoolWorker	*workers;
+	SCAThreadPoolQueue	*queues;
+	pthread_mutex_t		lock;
+	pthread_cond_t		start_cond;
+	pthread_cond_t		done_cond;
+	unsigned long		generation;
+	int			running;
+	int			shutdown;
+
+	/* Current job */
+	size_t			n;
+	size_t			chunk;
+	SCAThreadPoolFunc	func;
+	void			*data;
+#endif
+};
+
+#ifndef _WIN32
+/**
+ * @brief Steals the back half of other worker's range.
+ * @param pool Thread pool.
+ * @param index Index of the worker which steals.
+ * @return 1 if something was stolen, 0 if all the ranges are empty.
+ * @since 0.0.2
+ */
+static int
+_sca_thread_pool_steal (SCAThreadPool *pool, int index)
+{
+	SCAThreadPoolQueue	*victim;
+	SCAThreadPoolQueue	*own;
+	size_t			begin;
+	size_t			take;
+	int			i;
+
+	own = &pool->queues[index];
+
+	for (i = 1; i < pool->threads; ++i) {
+		victim = &pool->queues[(index + i) % pool->threads];
+
+		pthread_mutex_lock (&victim->lock);
+
+		if (victim->begin >= victim->end) {
+			pthread_mutex_unlock (&victim->lock);
+			continue;
+		}
+
+		take = (victim->end - victim->begin + 1) / 2;
+		victim->end -= take;
+		begin = victim->end;
+
+		pthread_mutex_unlock (&victim->lock);
+
+		/* Nobody else puts chunks into the empty range, so no need to lock both */
+		pthread_mutex_lock (&own->lock);
+		own->begin	= begin;
+		own->end	= begin + take;
+		pthread_mutex_unlock (&own->lock);
+
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Processes the chunks of the current job until there are no more.
+ * @param pool Thread pool.
+ * @param index Index of the worker.
+ * @since 0.0.2
+ */
+static void
+_sca_thread_pool_process (SCAThreadPool *pool, int index)
+{
+	SCAThreadPoolQueue	*own;
+	size_t			chunk;
+	size_t			begin, end;
+	int			has_chunk;
+
+	own = &pool->queues[index];
+
+	for (;;) {
+		pthread_mutex_lock (&own->lock);
+
+		if ((has_chunk = (own->begin < own->end)) != 0)
+			chunk = own->begin++;
+
+		pthread_mutex_unlock (&own->lock);
+
+		if (!has_chunk) {
+			if (!_sca_thread_pool_steal (pool, index))
+				return;
+
+			continue;
+		}
+
+		begin	= chunk * pool->chunk;
+		end	= (pool->n - begin > pool->chunk) ? begin + pool->chunk : pool->n;
+
+		pool->func (pool->data, begin, end);
+	}
+}
+
+static void *
+_sca_thread_pool_worker (void *arg)
+{
+	SCAThreadPoolWorker	*worker;
+	SCAThreadPool		*pool;
+	unsigned long		seen;
+
+	worker	= (SCAThreadPoolWorker *) arg;
+	pool	= worker->pool;
+	seen	= 0;
+
+	pthread_mutex_lock (&pool->lock);
+
+	for (;;) {
+		while (pool->generation == seen && !pool->shutdown)
+			pthread_cond_wait (&pool->start_cond, &pool->lock);
+
+		if (pool->shutdown)
+			break;
+
+		seen = pool->generation;
+		pthread_mutex_unlock (&pool->lock);
+
+		_sca_thread_pool_process (pool, worker->index);
+
+		pthread_mutex_lock (&pool->lock);
+
+		if (--pool->running == 0)
+			pthread_cond_signal (&pool->done_cond);
+	}
+
+	pthread_mutex_unlock (&pool->lock);
+
+	return NULL;
+}
+#endif
+
+SCAThreadPool *
+sca_thread_pool_new (int threads)
+{
+	SCAThreadPool	*pool;
+#ifndef _WIN32
+	int		i;
+#endif
+
+	if (threads < 1)
+		return NULL;
+
+	if ((pool = calloc (1, sizeof (SCAThreadPool))) == NULL)
+		return NULL;
+
+#ifdef _WIN32
+	pool->threads = 1;
+#else
+	pool->tids	= calloc ((size_t) threads, sizeof (pthread_t));
+	pool->workers	= calloc ((size_t) threads, sizeof (SCAThreadPoolWorker));
+	pool->queues	= calloc ((size_t) threads, sizeof (SCAThreadPoolQueue));
+
+	/* Nothing is initialized yet, so sca_thread_pool_free() can't be used */
+	if (pool->tids == NULL || pool->workers == NULL || pool->queues == NULL) {
+		free (pool->queues);
+		free (pool->workers);
+		free (pool->tids);
+		free (pool);
+		return NULL;
+	}
+
+	pthread_mutex_init (&pool->lock, NULL);
+	pthread_cond_init (&pool->start_cond, NULL);
+	pthread_cond_init (&pool->done_cond, NULL);
+
+	for (i = 0; i < threads; ++i) {
+		pool->workers[i].pool	= pool;
+		pool->workers[i].index	= i;
+	}
+
+	/* Worker 0 is the calling thread, there is a queue lock for every running worker */
+	pthread_mutex_init (&pool->queues[0].lock, NULL);
+	pool->threads = 1;
+
+	for (i = 1; i < threads; ++i) {
+		pthread_mutex_init (&pool->queues[i].lock, NULL);
+
+		if (pthread_create (&pool->tids[i], NULL, _sca_thread_pool_worker, &pool->workers[i]) != 0) {
+			pthread_mutex_destroy (&pool->queues[i].lock);
+			break;
+		}
+
+		++pool->threads;
+	}
+#endif
+
+	return pool;
+}
+
+void
+sca_thread_pool_free (SCAThreadPool *pool)
+{
+#ifndef _WIN32
+	int	i;
+#endif
+
+	if (pool == NULL)
+		return;
+
+#ifndef _WIN32
+	pthread_mutex_lock (&pool->lock);
+	pool->shutdown = 1;
+	pthread_cond_broadcast (&pool->start_cond);
+	pthread_mutex_unlock (&pool->lock);
+
+	for (i = 1; i < pool->threads; ++i)
+		pthread_join (pool->tids[i], NULL);
+
+	for (i = 0; i < pool->threads; ++i)
+		pthread_mutex_destroy (&pool->queues[i].lock);
+
+	pthread_cond_destroy (&pool->done_cond);
+	pthread_cond_destroy (&pool->start_cond);
+	pthread_mutex_destroy (&pool->lock);
+
+	free (pool->queues);
+	free (pool->workers);
+	free (pool->tids);
+#endif
+
+	free (pool);
+}
+
+int
+sca_thread_pool_get_threads (const SCAThreadPool *pool)
+{
+	if (pool == NULL)
+		return 0;
+
+	return pool->threads;
+}
+
+void
+sca_thread_pool_run (SCAThreadPool	*pool,
+		     size_t		n,
+		     size_t		chunk,
+		     SCAThreadPoolFunc	func,
+		     void		*data)
+{
+	size_t	chunks;
+	size_t	begin;
+#ifndef _WIN32
+	size_t	share;
+	int	i;
+#endif
+
+	if (pool == NULL || func == NULL || chunk == 0 || n == 0)
+		return;
+
+	chunks = (n + chunk - 1) / chunk;
+
+#ifndef _WIN32
+	if (pool->threads > 1 && chunks > 1) {
+		pthread_mutex_lock (&pool->lock);
+
+		pool->n		= n;
+		pool->chunk	= chunk;
+		pool->func	= func;
+		pool->data	= data;
+
+		/* Initial distribution: contiguous ranges of the same size */
+		for (i = 0, begin = 0; i < pool->threads; ++i) {
+			share = chunks / (size_t) pool->threads + ((size_t) i < chunks % (size_t) pool->threads ? 1 : 0);
+
+			pool->queues[i].begin	= begin;
+			pool->queues[i].end	= begin + share;
+
+			begin += share;
+		}
+
+		pool->running = pool->threads - 1;
+		++pool->generation;
+
+		pthread_cond_broadcast (&pool->start_cond);
+		pthread_mutex_unlock (&pool->lock);
+
+		_sca_thread_pool_process (pool, 0);
+
+		pthread_mutex_lock (&pool->lock);
+
+		while (pool->running > 0)
+			pthread_cond_wait (&pool->done_cond, &pool->lock);
+
+		pthread_mutex_unlock (&pool->lock);
+
+		return;
+	}
+#endif
+
+	for (begin = 0; begin < n; begin += chunk)
+		func (data, begin, (n - begin > chunk) ? begin + chunk : n);
+}
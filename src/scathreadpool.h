@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+ */
+
+/**
+ * Private work-stealing thread pool. A job is a range of items split into
+ * chunks. Every worker (including the calling thread) gets its own contiguous
+ * range of chunks and takes them from the front; a worker which has run out
+ * of chunks steals the back half of another worker's range. Each item is
+ * processed exactly once by the same function, so the results do not depend
+ * on the number of threads or on the scheduling.
+ *
+ * On platforms without POSIX threads the job is run in the calling thread.
+ */
+
+#ifndef __SCATHREADPOOL_H__
+#define __SCATHREADPOOL_H__
+
+#include <stddef.h>
+
+/** Opaque type for the thread pool. */
+typedef struct _SCAThreadPool SCAThreadPool;
+
+/**
+ * @brief Processes range of the items.
+ * @param data User data passed to sca_thread_pool_run().
+ * @param begin Index of the first item.
+ * @param end Index past the last item.
+ */
+typedef void (*SCAThreadPoolFunc) (void *data, size_t begin, size_t end);
+
+/**
+ * @brief Creates thread pool.
+ * @param threads Total number of threads including the calling one.
+ * @return Thread pool in case of success, NULL otherwise.
+ * @since 0.0.2
+ */
+SCAThreadPool *	sca_thread_pool_new		(int threads);
+
+/**
+ * @brief Stops all the threads and frees the pool.
+ * @param pool Thread pool to free.
+ * @since 0.0.2
+ */
+void		sca_thread_pool_free		(SCAThreadPool *pool);
+
+/**
+ * @brief Gets total number of threads in the pool.
+ * @param pool Thread pool.
+ * @return Number of threads including the calling one.
+ * @since 0.0.2
+ */
+int		sca_thread_pool_get_threads	(const SCAThreadPool *pool);
+
+/**
+ * @brief Runs the job and waits for its completion.
+ * @param pool Thread pool, only one job may run at a time.
+ * @param n Number of the items.
+ * @param chunk Number of the items in a chunk, must be positive.
+ * @param func Function to process the items.
+ * @param data User data for @a func.
+ * @since 0.0.2
+ */
+void		sca_thread_pool_run		(SCAThreadPool		*pool,
+						 size_t			n,
+						 size_t			chunk,
+						 SCAThreadPoolFunc	func,
+						 void			*data);
+
+#endif /* __SCATHREADPOOL_H__ */
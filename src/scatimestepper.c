@@ -0,0 +1,584 @@
+/*
+ * Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+ */
+
+/**
+ * Every periodic term is kept as a unit vector (cosine and sine of its
+ * argument) with constant amplitudes for the sine and the cosine parts, and
+ * the rotation for a single step. Terms are grouped by the series they belong
+ * to: 18 VSOP87 series of the Earth for the Sun, longitude with distance and
+ * latitude for the Moon, and the nutation.
+ *
+ * Arguments of the Moon and the nutation terms are combinations of the
+ * fundamental arguments, which are polynomials in time. Rotation for them is
+ * taken from the mean change of the arguments over a day (or the nearest
+ * multiple of the step): the change over a single short step would be spoiled
+ * by rounding of the Julian Day itself. The non-linear part of the arguments
+ * stays below 1e-9 degrees within a day. Amplitudes depending
+ * on time (Earth's orbit eccentricity for the Moon, T-dependent nutation
+ * coefficients) are taken at the last full calculation, which is done at
+ * least once a day.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "scatimestepper.h"
+#include "scajulianday.h"
+#include "scamoon.h"
+#include "scasun.h"
+#include "scafastmath.h"
+#include "scaprivate.h"
+
+/* Maximum time between full calculations, in days */
+#define SCA_TIME_STEPPER_SPAN		1.0
+/* Number of steps between renormalizations */
+#define SCA_TIME_STEPPER_RENORM		64
+
+/* Series groups: L, B and R series of the Earth for powers of T up to 5 */
+#define SCA_TIME_STEPPER_SUN		0
+#define SCA_TIME_STEPPER_MOON_LR	18
+#define SCA_TIME_STEPPER_MOON_B		19
+#define SCA_TIME_STEPPER_NUTATION	20
+#define SCA_TIME_STEPPER_GROUPS		21
+#define SCA_TIME_STEPPER_POWERS		6
+
+/* Fundamental arguments: D, M, M', F, Omega, L', A1, A2 and A3 */
+#define SCA_TIME_STEPPER_ARGS		9
+
+typedef struct _SCATimeStepperPrivate {
+	double		jd_sync;				/**< Julian Day of the last full calculation.	*/
+	size_t		steps;					/**< Steps since the last full calculation.	*/
+	size_t		count;					/**< Total number of the terms.			*/
+	size_t		offset[SCA_TIME_STEPPER_GROUPS];	/**< Index of the first term of every group.	*/
+	size_t		size[SCA_TIME_STEPPER_GROUPS];		/**< Number of the terms in every group.	*/
+	double		sum_sin[SCA_TIME_STEPPER_GROUPS];	/**< Sums of the sine parts.			*/
+	double		sum_cos[SCA_TIME_STEPPER_GROUPS];	/**< Sums of the cosine parts.			*/
+	double		*amp_sin;				/**< Amplitudes of the sine parts.		*/
+	double		*amp_cos;				/**< Amplitudes of the cosine parts.		*/
+	double		*sin;					/**< Sines of the arguments.			*/
+	double		*cos;					/**< Cosines of the arguments.			*/
+	double		*rot_sin;				/**< Sines of the step rotations.		*/
+	double		*rot_cos;				/**< Cosines of the step rotations.		*/
+} SCATimeStepperPrivate;
+
+/* Additional Moon's longitude terms: multiples of the fundamental arguments, coefficient */
+static const double moon_extra_l[][SCA_TIME_STEPPER_ARGS + 1] = {
+{0.0,	0.0,	 0.0,	 0.0,	0.0,	0.0,	1.0,	0.0,	0.0,	 0.003958},
+{0.0,	0.0,	 0.0,	-1.0,	0.0,	1.0,	0.0,	0.0,	0.0,	 0.001962},
+{0.0,	0.0,	 0.0,	 0.0,	0.0,	0.0,	0.0,	1.0,	0.0,	 0.000318}
+};
+
+/* Additional Moon's latitude terms: multiples of the fundamental arguments, coefficient */
+static const double moon_extra_b[][SCA_TIME_STEPPER_ARGS + 1] = {
+{0.0,	0.0,	 0.0,	 0.0,	0.0,	1.0,	0.0,	0.0,	0.0,	-0.002235},
+{0.0,	0.0,	 0.0,	 0.0,	0.0,	0.0,	0.0,	0.0,	1.0,	 0.000382},
+{0.0,	0.0,	 0.0,	-1.0,	0.0,	0.0,	1.0,	0.0,	0.0,	 0.000175},
+{0.0,	0.0,	 0.0,	 1.0,	0.0,	0.0,	1.0,	0.0,	0.0,	 0.000175},
+{0.0,	0.0,	-1.0,	 0.0,	0.0,	1.0,	0.0,	0.0,	0.0,	 0.000127},
+{0.0,	0.0,	 1.0,	 0.0,	0.0,	1.0,	0.0,	0.0,	0.0,	-0.000115}
+};
+
+#define SCA_TIME_STEPPER_EXTRA_L	(sizeof (moon_extra_l) / sizeof (moon_extra_l[0]))
+#define SCA_TIME_STEPPER_EXTRA_B	(sizeof (moon_extra_b) / sizeof (moon_extra_b[0]))
+
+static int
+_sca_time_stepper_is_supported (SCAEphemerisBody body)
+{
+	return body == SCA_EPHEMERIS_SUN || body == SCA_EPHEMERIS_MOON || body == SCA_EPHEMERIS_NUTATION;
+}
+
+/**
+ * @brief Calculates number of the terms for the body.
+ * @param body Body.
+ * @return Number of the terms.
+ * @since 0.0.2
+ */
+static size_t
+_sca_time_stepper_get_count (SCAEphemerisBody body)
+{
+	size_t		count;
+	unsigned int	n, v, p;
+
+	count = 0;
+
+	switch (body) {
+	case SCA_EPHEMERIS_SUN:
+		for (v = 0; v < 3; ++v)
+			for (p = 0; p < SCA_TIME_STEPPER_POWERS; ++p) {
+				sca_planet_data_get_terms (SCA_PLANET_EARTH, v, p, &n);
+				count += n;
+			}
+		break;
+	case SCA_EPHEMERIS_MOON:
+		sca_moon_get_lr_terms (&n);
+		count += n + SCA_TIME_STEPPER_EXTRA_L;
+		sca_moon_get_b_terms (&n);
+		count += n + SCA_TIME_STEPPER_EXTRA_B;
+		break;
+	case SCA_EPHEMERIS_NUTATION:
+		sca_earth_get_nutation_terms (&n);
+		count += n;
+		break;
+	default:
+		break;
+	}
+
+	return count;
+}
+
+/**
+ * @brief Calculates fundamental arguments of the Moon and the nutation series.
+ * @param jd Julian Day.
+ * @param[out] args D, M, M', F, Omega, L', A1, A2 and A3.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ */
+static int
+_sca_time_stepper_get_args (double jd, SCAAngle *args)
+{
+	double	t;
+
+	if (jd < 0)
+		return -1;
+
+	t = sca_jd_get_centuries_2000 (jd);
+
+	sca_moon_get_mean_elongation_from_sun (jd, &args[0]);
+	sca_sun_get_mean_anomaly (jd, &args[1]);
+	sca_moon_get_mean_anomaly (jd, &args[2]);
+	sca_moon_get_latitude_argument (jd, &args[3]);
+	sca_moon_get_mean_longitude_of_ascnode (jd, &args[4]);
+	sca_moon_get_mean_longitude (jd, &args[5]);
+
+	/* Same as in sca_moon_get_ecliptic () */
+	args[6] = sca_angle_from_decimal_degrees (119.75 + 131.849 * t);
+	args[7] = sca_angle_from_decimal_degrees (53.09 + 479264.290 * t);
+	args[8] = sca_angle_from_decimal_degrees (313.45 + 481266.484 * t);
+
+	sca_angle_reduce (&args[6]);
+	sca_angle_reduce (&args[7]);
+	sca_angle_reduce (&args[8]);
+
+	return 0;
+}
+
+/**
+ * @brief Sets the term which argument is a combination of the fundamental arguments.
+ * @param priv Stepper state.
+ * @param j Index of the term.
+ * @param mult Multiples of the fundamental arguments.
+ * @param n Number of the multiples.
+ * @param args Fundamental arguments.
+ * @param d_args Change of the fundamental arguments over a step.
+ * @param amp_sin Amplitude of the sine part.
+ * @param amp_cos Amplitude of the cosine part.
+ * @since 0.0.2
+ */
+static void
+_sca_time_stepper_set_term (SCATimeStepperPrivate	*priv,
+			    size_t			j,
+			    const double		*mult,
+			    unsigned int		n,
+			    const SCAAngle		*args,
+			    const SCAAngle		*d_args,
+			    double			amp_sin,
+			    double			amp_cos)
+{
+	SCAAngle	arg, d_arg;
+	unsigned int	i;
+
+	arg = d_arg = 0.0;
+
+	for (i = 0; i < n; ++i) {
+		if (mult[i] == 0.0)
+			continue;
+
+		arg	+= mult[i] * args[i];
+		d_arg	+= mult[i] * d_args[i];
+	}
+
+	sca_angle_get_sincos (arg, &priv->sin[j], &priv->cos[j]);
+	sca_angle_get_sincos (d_arg, &priv->rot_sin[j], &priv->rot_cos[j]);
+
+	priv->amp_sin[j] = amp_sin;
+	priv->amp_cos[j] = amp_cos;
+}
+
+/**
+ * @brief Sums all the groups of the terms.
+ * @param priv Stepper state.
+ * @since 0.0.2
+ */
+static void
+_sca_time_stepper_sum (SCATimeStepperPrivate *priv)
+{
+	double		ss, sc;
+	size_t		j, end;
+	unsigned int	g;
+
+	for (g = 0; g < SCA_TIME_STEPPER_GROUPS; ++g) {
+		ss = sc = 0.0;
+		end = priv->offset[g] + priv->size[g];
+
+		for (j = priv->offset[g]; j < end; ++j) {
+			ss += priv->amp_sin[j] * priv->sin[j];
+			sc += priv->amp_cos[j] * priv->cos[j];
+		}
+
+		priv->sum_sin[g] = ss;
+		priv->sum_cos[g] = sc;
+	}
+}
+
+/**
+ * @brief Rotates all the terms by a single step.
+ * @param priv Stepper state.
+ * @param renorm Whether to renormalize the vectors.
+ * @since 0.0.2
+ */
+static void
+_sca_time_stepper_rotate (SCATimeStepperPrivate *priv, int renorm)
+{
+	double * SCA_RESTRICT		s = priv->sin;
+	double * SCA_RESTRICT		c = priv->cos;
+	const double * SCA_RESTRICT	rs = priv->rot_sin;
+	const double * SCA_RESTRICT	rc = priv->rot_cos;
+	double				sn, cn, k;
+	size_t				j;
+
+	for (j = 0; j < priv->count; ++j) {
+		sn = s[j] * rc[j] + c[j] * rs[j];
+		cn = c[j] * rc[j] - s[j] * rs[j];
+
+		s[j] = sn;
+		c[j] = cn;
+	}
+
+	if (!renorm)
+		return;
+
+	/* Single Newton step for 1 / sqrt (x), the length is close to 1 */
+	for (j = 0; j < priv->count; ++j) {
+		k = 1.5 - 0.5 * (s[j] * s[j] + c[j] * c[j]);
+
+		s[j] *= k;
+		c[j] *= k;
+	}
+}
+
+/**
+ * @brief Calculates all the terms for the given instance.
+ * @param stepper Calculations with a fixed time step.
+ * @param jd Julian Day.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ */
+static int
+_sca_time_stepper_sync (SCATimeStepper *stepper, double jd)
+{
+	SCATimeStepperPrivate	*priv;
+	SCAAngle		args[SCA_TIME_STEPPER_ARGS];
+	SCAAngle		d_args[SCA_TIME_STEPPER_ARGS];
+	const double		*terms;
+	double			t, tm, E, E_corr[3], steps;
+	size_t			j;
+	unsigned int		i, n, v, p, g;
+
+	priv = stepper->priv;
+
+	steps = floor (SCA_TIME_STEPPER_SPAN / fabs (stepper->step));
+
+	if (steps < 1.0)
+		steps = 1.0;
+
+	if (_sca_time_stepper_get_args (jd, args) != 0 ||
+	    _sca_time_stepper_get_args (jd + steps * stepper->step, d_args) != 0)
+		return -1;
+
+	/* None of the arguments changes by more than 180 degrees a day */
+	for (i = 0; i < SCA_TIME_STEPPER_ARGS; ++i) {
+		d_args[i] -= args[i];
+		sca_angle_reduce (&d_args[i]);
+
+		if (d_args[i] > 180.0)
+			d_args[i] -= 360.0;
+		else if (d_args[i] < -180.0)
+			d_args[i] += 360.0;
+
+		d_args[i] /= steps;
+	}
+
+	memset (priv->offset, 0, sizeof (priv->offset));
+	memset (priv->size, 0, sizeof (priv->size));
+
+	t	= sca_jd_get_centuries_2000 (jd);
+	tm	= sca_jd_get_millenia_2000 (jd);
+	j	= 0;
+
+	if (stepper->bodies & (1U << SCA_EPHEMERIS_SUN)) {
+		for (v = 0; v < 3; ++v)
+			for (p = 0; p < SCA_TIME_STEPPER_POWERS; ++p) {
+				g		= SCA_TIME_STEPPER_SUN + v * SCA_TIME_STEPPER_POWERS + p;
+				terms		= sca_planet_data_get_terms (SCA_PLANET_EARTH, v, p, &n);
+				priv->offset[g]	= j;
+				priv->size[g]	= n;
+
+				/* VSOP87 arguments are linear in time, rotation is exact */
+				for (i = 0; i < n; ++i, ++j) {
+					priv->sin[j]		= sin (terms[3 * i + 1] + terms[3 * i + 2] * tm);
+					priv->cos[j]		= cos (terms[3 * i + 1] + terms[3 * i + 2] * tm);
+					priv->rot_sin[j]	= sin (terms[3 * i + 2] * stepper->step / 365250.0);
+					priv->rot_cos[j]	= cos (terms[3 * i + 2] * stepper->step / 365250.0);
+					priv->amp_sin[j]	= 0.0;
+					priv->amp_cos[j]	= terms[3 * i];
+				}
+			}
+	}
+
+	if (stepper->bodies & (1U << SCA_EPHEMERIS_MOON)) {
+		/* Corrections for Earth's orbit eccentricity, indexed by |M| multiple */
+		E		= 1.0 - 0.002516 * t - 0.0000074 * t * t;
+		E_corr[0]	= 1.0;
+		E_corr[1]	= E;
+		E_corr[2]	= E * E;
+
+		terms					= sca_moon_get_lr_terms (&n);
+		priv->offset[SCA_TIME_STEPPER_MOON_LR]	= j;
+		priv->size[SCA_TIME_STEPPER_MOON_LR]	= n + SCA_TIME_STEPPER_EXTRA_L;
+
+		for (i = 0; i < n; ++i, ++j)
+			_sca_time_stepper_set_term (priv, j, &terms[6 * i], 4, args, d_args,
+						    terms[6 * i + 4] * E_corr[abs ((int) terms[6 * i + 1])],
+						    terms[6 * i + 5] * E_corr[abs ((int) terms[6 * i + 1])]);
+
+		for (i = 0; i < SCA_TIME_STEPPER_EXTRA_L; ++i, ++j)
+			_sca_time_stepper_set_term (priv, j, moon_extra_l[i], SCA_TIME_STEPPER_ARGS, args, d_args,
+						    moon_extra_l[i][SCA_TIME_STEPPER_ARGS], 0.0);
+
+		terms					= sca_moon_get_b_terms (&n);
+		priv->offset[SCA_TIME_STEPPER_MOON_B]	= j;
+		priv->size[SCA_TIME_STEPPER_MOON_B]	= n + SCA_TIME_STEPPER_EXTRA_B;
+
+		for (i = 0; i < n; ++i, ++j)
+			_sca_time_stepper_set_term (priv, j, &terms[5 * i], 4, args, d_args,
+						    terms[5 * i + 4] * E_corr[abs ((int) terms[5 * i + 1])],
+						    0.0);
+
+		for (i = 0; i < SCA_TIME_STEPPER_EXTRA_B; ++i, ++j)
+			_sca_time_stepper_set_term (priv, j, moon_extra_b[i], SCA_TIME_STEPPER_ARGS, args, d_args,
+						    moon_extra_b[i][SCA_TIME_STEPPER_ARGS], 0.0);
+	}
+
+	if (stepper->bodies & (1U << SCA_EPHEMERIS_NUTATION)) {
+		terms					= sca_earth_get_nutation_terms (&n);
+		priv->offset[SCA_TIME_STEPPER_NUTATION]	= j;
+		priv->size[SCA_TIME_STEPPER_NUTATION]	= n;
+
+		for (i = 0; i < n; ++i, ++j)
+			_sca_time_stepper_set_term (priv, j, &terms[9 * i], 5, args, d_args,
+						    terms[9 * i + 5] + terms[9 * i + 6] * t,
+						    terms[9 * i + 7] + terms[9 * i + 8] * t);
+	}
+
+	_sca_time_stepper_sum (priv);
+
+	priv->jd_sync	= jd;
+	priv->steps	= 0;
+	stepper->jd	= jd;
+
+	return 0;
+}
+
+int
+sca_time_stepper_new (SCATimeStepper *stepper, double jd, double step)
+{
+	SCATimeStepperPrivate	*priv;
+
+	if (stepper == NULL || jd < 0 || step == 0.0)
+		return -1;
+
+	if ((priv = calloc (1, sizeof (SCATimeStepperPrivate))) == NULL)
+		return -1;
+
+	priv->jd_sync	= jd;
+
+	stepper->jd	= jd;
+	stepper->step	= step;
+	stepper->bodies	= 0;
+	stepper->priv	= priv;
+
+	return 0;
+}
+
+void
+sca_time_stepper_free (SCATimeStepper *stepper)
+{
+	SCATimeStepperPrivate	*priv;
+
+	if (stepper == NULL)
+		return;
+
+	if ((priv = stepper->priv) != NULL) {
+		free (priv->amp_sin);
+		free (priv);
+	}
+
+	memset (stepper, 0, sizeof (SCATimeStepper));
+}
+
+int
+sca_time_stepper_add (SCATimeStepper *stepper, SCAEphemerisBody body)
+{
+	SCATimeStepperPrivate	*priv;
+	double			*data;
+	unsigned int		bodies;
+	size_t			count;
+	int			i;
+
+	if (stepper == NULL || stepper->priv == NULL || !_sca_time_stepper_is_supported (body))
+		return -1;
+
+	if (body == SCA_EPHEMERIS_SUN && !sca_planet_data_is_available (SCA_PLANET_EARTH))
+		return -1;
+
+	priv	= stepper->priv;
+	bodies	= stepper->bodies | (1U << body);
+	count	= 0;
+
+	for (i = 0; i < SCA_EPHEMERIS_BODIES; ++i)
+		if (bodies & (1U << i))
+			count += _sca_time_stepper_get_count ((SCAEphemerisBody) i);
+
+	if ((data = malloc (6 * count * sizeof (double))) == NULL)
+		return -1;
+
+	free (priv->amp_sin);
+
+	priv->count	= count;
+	priv->amp_sin	= data;
+	priv->amp_cos	= data + count;
+	priv->sin	= data + 2 * count;
+	priv->cos	= data + 3 * count;
+	priv->rot_sin	= data + 4 * count;
+	priv->rot_cos	= data + 5 * count;
+
+	stepper->bodies = bodies;
+
+	if (_sca_time_stepper_sync (stepper, stepper->jd) != 0) {
+		stepper->bodies &= ~(1U << body);
+		return -1;
+	}
+
+	return 0;
+}
+
+int
+sca_time_stepper_next (SCATimeStepper *stepper)
+{
+	SCATimeStepperPrivate	*priv;
+	size_t			steps;
+	double			jd;
+
+	if (stepper == NULL || stepper->priv == NULL)
+		return -1;
+
+	priv	= stepper->priv;
+	steps	= priv->steps + 1;
+	jd	= priv->jd_sync + steps * stepper->step;
+
+	if (jd < 0)
+		return -1;
+
+	if (fabs (steps * stepper->step) > SCA_TIME_STEPPER_SPAN)
+		return _sca_time_stepper_sync (stepper, jd);
+
+	_sca_time_stepper_rotate (priv, steps % SCA_TIME_STEPPER_RENORM == 0);
+	_sca_time_stepper_sum (priv);
+
+	priv->steps	= steps;
+	stepper->jd	= jd;
+
+	return 0;
+}
+
+int
+sca_time_stepper_get (const SCATimeStepper	*stepper,
+		      SCAEphemerisBody		body,
+		      SCAAngle			*lon,
+		      SCAAngle			*lat,
+		      double			*dst)
+{
+	const SCATimeStepperPrivate	*priv;
+	double				tm, val[3];
+	SCAAngle			L;
+	unsigned int			v;
+	int				p;
+
+	if (stepper == NULL || stepper->priv == NULL || !_sca_time_stepper_is_supported (body))
+		return -1;
+
+	if (!(stepper->bodies & (1U << body)))
+		return -1;
+
+	priv = stepper->priv;
+
+	switch (body) {
+	case SCA_EPHEMERIS_SUN:
+		tm = sca_jd_get_millenia_2000 (stepper->jd);
+
+		for (v = 0; v < 3; ++v) {
+			val[v] = 0.0;
+
+			for (p = SCA_TIME_STEPPER_POWERS - 1; p >= 0; --p)
+				val[v] = val[v] * tm + priv->sum_cos[SCA_TIME_STEPPER_SUN + v * SCA_TIME_STEPPER_POWERS + p];
+		}
+
+		val[0] = sca_angle_from_radians (val[0]) + 180.0;
+		val[1] = -sca_angle_from_radians (val[1]);
+		break;
+	case SCA_EPHEMERIS_MOON:
+		sca_moon_get_mean_longitude (stepper->jd, &L);
+
+		val[0] = L + sca_angle_from_decimal_degrees (priv->sum_sin[SCA_TIME_STEPPER_MOON_LR]);
+		val[1] = sca_angle_from_decimal_degrees (priv->sum_sin[SCA_TIME_STEPPER_MOON_B]);
+		val[2] = (385000.56 + priv->sum_cos[SCA_TIME_STEPPER_MOON_LR]) / SCA_AU;
+		break;
+	default:
+		val[0] = sca_angle_from_decimal_degrees (priv->sum_sin[SCA_TIME_STEPPER_NUTATION] / 3600.0);
+		val[1] = sca_angle_from_decimal_degrees (priv->sum_cos[SCA_TIME_STEPPER_NUTATION] / 3600.0);
+		val[2] = 1.0;
+		break;
+	}
+
+	if (body != SCA_EPHEMERIS_NUTATION) {
+		sca_angle_reduce (&val[0]);
+		sca_angle_reduce (&val[1]);
+	}
+
+	if (lon != NULL)
+		*lon = val[0];
+
+	if (lat != NULL)
+		*lat = val[1];
+
+	if (dst != NULL)
+		*dst = val[2];
+
+	return 0;
+}
@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+ */
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @file scatimestepper.h
+ * @brief Расчёт с постоянным шагом по времени
+ * @author Александр Сапрыкин
+ *
+ * #SCATimeStepper рассчитывает положения Солнца, Луны и нутацию для моментов
+ * времени с постоянным шагом, например, каждую секунду в течение ночи.
+ * Аргументы всех периодических членов рядов почти линейно зависят от времени,
+ * поэтому синус и косинус каждого аргумента на следующем шаге получаются
+ * поворотом на постоянный угол, без вызовов sin() и cos().
+ * @code
+ * SCATimeStepper	stepper;
+ * SCAEpoch		epoch;
+ * SCAMoon		moon;
+ * int			i;
+ *
+ * sca_time_stepper_new (&stepper, jd, 1.0 / 86400.0);
+ * sca_time_stepper_add (&stepper, SCA_EPHEMERIS_MOON);
+ * sca_time_stepper_add (&stepper, SCA_EPHEMERIS_NUTATION);
+ *
+ * for (i = 0; i < 3600; ++i) {
+ *	sca_epoch_new_stepper (&epoch, &stepper);
+ *	sca_moon_update_stepper (&moon, &epoch, &stepper);
+ *	sca_time_stepper_next (&stepper);
+ * }
+ *
+ * sca_time_stepper_free (&stepper);
+ * @endcode
+ * Ошибки округления накапливаются при поворотах, поэтому длина векторов
+ * периодически нормализуется, а не реже одного раза в сутки все члены
+ * рассчитываются заново. Ошибка относительно аналитических рядов не превышает
+ * 0.001 секунды дуги.
+ */
+#else
+/**
+ * @file scatimestepper.h
+ * @brief Calculations with a fixed time step
+ * @author Alexander Saprykin
+ *
+ * #SCATimeStepper calculates positions of the Sun, the Moon and the nutation
+ * for instances with a fixed time step, e.g. every second during the night.
+ * Arguments of all the periodic terms of the series are almost linear in
+ * time, so sine and cosine of every argument at the next step are obtained by
+ * rotation through a constant angle, without sin() and cos() calls.
+ * @code
+ * SCATimeStepper	stepper;
+ * SCAEpoch		epoch;
+ * SCAMoon		moon;
+ * int			i;
+ *
+ * sca_time_stepper_new (&stepper, jd, 1.0 / 86400.0);
+ * sca_time_stepper_add (&stepper, SCA_EPHEMERIS_MOON);
+ * sca_time_stepper_add (&stepper, SCA_EPHEMERIS_NUTATION);
+ *
+ * for (i = 0; i < 3600; ++i) {
+ *	sca_epoch_new_stepper (&epoch, &stepper);
+ *	sca_moon_update_stepper (&moon, &epoch, &stepper);
+ *	sca_time_stepper_next (&stepper);
+ * }
+ *
+ * sca_time_stepper_free (&stepper);
+ * @endcode
+ * Rounding errors accumulate with the rotations, so the vectors are
+ * renormalized periodically, and all the terms are calculated again at least
+ * once a day. The error relative to the analytical series doesn't exceed 0.001
+ * arcseconds.
+ */
+#endif
+
+#if !defined (__SCALIB_H_INSIDE__) && !defined (SCALIB_COMPILATION)
+#  error "Header files shouldn't be included directly, consider using <scalib.h> instead."
+#endif
+
+#ifndef __SCATIMESTEPPER_H__
+#define __SCATIMESTEPPER_H__
+
+#include <scamacros.h>
+#include <scaangle.h>
+#include <scaephemeriscache.h>
+
+SCA_BEGIN_DECLS
+
+#ifdef DOXYGEN_RUSSIAN
+/** Определение типа для расчёта с постоянным шагом. */
+#else
+/** Typedef for calculations with a fixed time step. */
+#endif
+typedef struct _SCATimeStepper {
+#ifdef DOXYGEN_RUSSIAN
+	/** Юлианский день текущего шага.				*/
+#else
+	/** Julian Day of the current step.				*/
+#endif
+	double		jd;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Шаг в днях.							*/
+#else
+	/** Step in days.						*/
+#endif
+	double		step;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Битовая маска добавленных тел, (1 << #SCAEphemerisBody).	*/
+#else
+	/** Bit mask of the added bodies, (1 << #SCAEphemerisBody).	*/
+#endif
+	unsigned int	bodies;
+
+#ifdef DOXYGEN_RUSSIAN
+	/** Внутреннее состояние.					*/
+#else
+	/** Internal state.						*/
+#endif
+	void		*priv;
+} SCATimeStepper;
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Создаёт расчёт с постоянным шагом без тел.
+ * @param[out] stepper Структура #SCATimeStepper для инициализации.
+ * @param jd Юлианский день первого шага.
+ * @param step Шаг в днях, может быть отрицательным.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Тела добавляются функцией sca_time_stepper_add(). Память должна быть
+ * освобождена функцией sca_time_stepper_free().
+ */
+#else
+/**
+ * @brief Creates calculations with a fixed time step without bodies.
+ * @param[out] stepper #SCATimeStepper structure to initialize.
+ * @param jd Julian Day of the first step.
+ * @param step Step in days, may be negative.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Bodies are added with sca_time_stepper_add(). Memory must be freed with
+ * sca_time_stepper_free().
+ */
+#endif
+int		sca_time_stepper_new		(SCATimeStepper *stepper, double jd, double step);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Освобождает память, выделенную для расчёта с постоянным шагом.
+ * @param stepper Расчёт для освобождения.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Frees memory allocated for the calculations with a fixed time step.
+ * @param stepper Calculations to free.
+ * @since 0.0.2
+ */
+#endif
+void		sca_time_stepper_free		(SCATimeStepper *stepper);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Добавляет тело в расчёт с постоянным шагом.
+ * @param stepper Расчёт с постоянным шагом.
+ * @param body Тело для добавления: #SCA_EPHEMERIS_SUN, #SCA_EPHEMERIS_MOON
+ * или #SCA_EPHEMERIS_NUTATION.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Члены всех тел рассчитываются заново для текущего шага.
+ */
+#else
+/**
+ * @brief Adds the body into the calculations with a fixed time step.
+ * @param stepper Calculations with a fixed time step.
+ * @param body Body to add: #SCA_EPHEMERIS_SUN, #SCA_EPHEMERIS_MOON or
+ * #SCA_EPHEMERIS_NUTATION.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Terms of all the bodies are calculated again for the current step.
+ */
+#endif
+int		sca_time_stepper_add		(SCATimeStepper *stepper, SCAEphemerisBody body);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Переходит к следующему шагу.
+ * @param stepper Расчёт с постоянным шагом.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ */
+#else
+/**
+ * @brief Advances to the next step.
+ * @param stepper Calculations with a fixed time step.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ */
+#endif
+int		sca_time_stepper_next		(SCATimeStepper *stepper);
+
+#ifdef DOXYGEN_RUSSIAN
+/**
+ * @brief Возвращает эклиптические координаты тела для текущего шага.
+ * @param stepper Расчёт с постоянным шагом.
+ * @param body Тело.
+ * @param[out] lon Эклиптическая долгота, может быть NULL.
+ * @param[out] lat Эклиптическая широта, может быть NULL.
+ * @param[out] dst Расстояние в АЕ, может быть NULL.
+ * @return 0 в случае успеха, иначе -1.
+ * @since 0.0.2
+ *
+ * Значения соответствуют sca_ephemeris_cache_get(): положение до учёта
+ * нутации и аберрации для Солнца и Луны, нутация в долготе (@a lon) и в
+ * наклоне (@a lat) для #SCA_EPHEMERIS_NUTATION.
+ */
+#else
+/**
+ * @brief Gets ecliptical coordinates of the body for the current step.
+ * @param stepper Calculations with a fixed time step.
+ * @param body Body.
+ * @param[out] lon Ecliptical longitude, may be NULL.
+ * @param[out] lat Ecliptical latitude, may be NULL.
+ * @param[out] dst Distance in AUs, may be NULL.
+ * @return 0 in case of success, -1 otherwise.
+ * @since 0.0.2
+ *
+ * Values correspond to sca_ephemeris_cache_get(): position before nutation
+ * and aberration for the Sun and the Moon, nutation in longitude (@a lon) and
+ * in obliquity (@a lat) for #SCA_EPHEMERIS_NUTATION.
+ */
+#endif
+int		sca_time_stepper_get		(const SCATimeStepper	*stepper,
+						 SCAEphemerisBody	body,
+						 SCAAngle		*lon,
+						 SCAAngle		*lat,
+						 double			*dst);
+
+SCA_END_DECLS
+
+#endif /* __SCATIMESTEPPER_H__ */
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+ */
+
+/**
+ * Builds precomputed ephemerides file for sca_ephemeris_cache_open().
+ * The file contains the Sun, the Moon, nutation and all the planets which
+ * have VSOP87 data, fitted with the default segments and orders.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <scalib.h>
+
+static const char *body_names[SCA_EPHEMERIS_BODIES] = {
+	"Sun",
+	"Moon",
+	"Mercury",
+	"Venus",
+	"Earth",
+	"Mars",
+	"Jupiter",
+	"Saturn",
+	"Uranus",
+	"Neptune",
+	"Nutation"
+};
+
+static void
+usage (const char *name)
+{
+	fprintf (stderr, "Usage: %s [-b YEAR] [-n YEARS] [-q] FILE\n"
+			 "  -b YEAR   First year of the interval (default 2000)\n"
+			 "  -n YEARS  Number of the years (default 30)\n"
+			 "  -q        Do not print errors of the bodies\n",
+		 name);
+}
+
+int
+main (int argc, char *argv[])
+{
+	SCAEphemerisCache	cache;
+	SCADate			date;
+	const char		*path;
+	double			jd_begin, jd_end, err;
+	int			year, years, quiet;
+	int			i;
+
+	year	= 2000;
+	years	= 30;
+	quiet	= 0;
+	path	= NULL;
+
+	for (i = 1; i < argc; ++i) {
+		if (strcmp (argv[i], "-b") == 0 && i + 1 < argc)
+			year = atoi (argv[++i]);
+		else if (strcmp (argv[i], "-n") == 0 && i + 1 < argc)
+			years = atoi (argv[++i]);
+		else if (strcmp (argv[i], "-q") == 0)
+			quiet = 1;
+		else if (argv[i][0] != '-' && path == NULL)
+			path = argv[i];
+		else {
+			usage (argv[0]);
+			return 1;
+		}
+	}
+
+	if (path == NULL || years < 1) {
+		usage (argv[0]);
+		return 1;
+	}
+
+	date.year	= year;
+	date.month	= SCA_MONTH_JANUARY;
+	date.day	= 1.0;
+	jd_begin	= sca_jd_from_calendar_date (&date);
+
+	date.year	= year + years;
+	jd_end		= sca_jd_from_calendar_date (&date);
+
+	if (sca_ephemeris_cache_new (&cache, jd_begin, jd_end) != 0) {
+		fprintf (stderr, "Invalid interval: %d, %d years\n", year, years);
+		return 1;
+	}
+
+	for (i = 0; i < SCA_EPHEMERIS_BODIES; ++i) {
+		if (i >= SCA_EPHEMERIS_MERCURY && i <= SCA_EPHEMERIS_NEPTUNE &&
+		    !sca_planet_data_is_available ((SCAPlanet) (i - 1)))
+			continue;
+
+		if (sca_ephemeris_cache_add (&cache, (SCAEphemerisBody) i, 0.0, 0, &err) != 0) {
+			fprintf (stderr, "Failed to fit %s\n", body_names[i]);
+			sca_ephemeris_cache_free (&cache);
+			return 1;
+		}
+
+		if (!quiet)
+			printf ("%-10s %6zu segments, max error %.2e\"\n",
+				body_names[i], cache.series[i].count, err);
+	}
+
+	if (sca_ephemeris_cache_save (&cache, path) != 0) {
+		fprintf (stderr, "Failed to write %s\n", path);
+		sca_ephemeris_cache_free (&cache);
+		return 1;
+	}
+
+	sca_ephemeris_cache_free (&cache);
+
+	return 0;
+}
@@ -0,0 +1,193 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2026 Alexander Saprykin <xelfium@gmail.com>
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+
+"""Generates planet data tables for src/scaplanetdata.c from VSOP87D files.
+
+VSOP87D files (heliocentric spherical coordinates, equinox of the date) are
+available from IMCCE, i.e. VSOP87D.mar for Mars. Each series header line
+contains the variable number (1 - L, 2 - B, 3 - R) and the power of T, each
+term line ends with A, B and C values.
+
+Usage:
+    vsop87gen.py [--min-amplitude A] NAME VSOP87D.xxx > table.c
+
+Terms with |A| < min-amplitude (in radians or AU) are dropped, Meeus uses
+tables truncated at about 1e-8. Terms inside each series are written sorted
+by decreasing amplitude, as required by the accuracy based truncation.
+
+For each accuracy tier (see SCA_PLANET_DATA_TIERS in scaplanetdata.c) the
+number of leading terms of each series is calculated, so that the sum of
+dropped amplitudes of all the series of a variable doesn't exceed the tier's
+accuracy for |T| <= 1 (within 1000 years from J2000). Accuracy for R is
+relative to the first term of R0 series (mean distance).
+"""
+
+import argparse
+import re
+import sys
+
+SERIES_MAX = 6
+# Must match planet_data_tiers[] in scaplanetdata.c, in arcseconds
+TIERS = (0.1, 1.0, 10.0, 60.0)
+ARCSEC = 3.14159265358979323846 / 180.0 / 3600.0
+HEADER_RE = re.compile (r'VSOP87.*VARIABLE\s+(\d).*\*T\*\*(\d)\s+(\d+)\s+TERMS')
+
+
+def parse (path):
+    series = {}
+    current = None
+
+    with open (path) as f:
+        for line in f:
+            m = HEADER_RE.search (line)
+
+            if m:
+                var, power = int (m.group (1)), int (m.group (2))
+
+                if var > 3 or power >= SERIES_MAX:
+                    current = None
+                    continue
+
+                current = series.setdefault ((var, power), [])
+                continue
+
+            if current is None or not line.strip ():
+                continue
+
+            fields = line.split ()
+            current.append (tuple (float (x) for x in fields[-3:]))
+
+    return series
+
+
+def get_cuts (var_series, tolerance):
+    """Number of terms to keep in each series of a variable."""
+    cuts = []
+    budget = tolerance / len (var_series)
+
+    for terms in var_series:
+        dropped = 0.0
+        keep = len (terms)
+
+        while keep > 0 and dropped + abs (terms[keep - 1][0]) <= budget:
+            dropped += abs (terms[keep - 1][0])
+            keep -= 1
+
+        cuts.append (keep)
+
+    return cuts
+
+
+def format_term (term):
+    """Term line aligned like the hand written tables of scaplanetdata.c."""
+    line = '{'
+    column = 1
+
+    for i, value in enumerate (term):
+        text = ('%.11f' % value).rstrip ('0')
+
+        if text.endswith ('.'):
+            text += '0'
+
+        text += ',' if i != 2 else ''
+        line += text
+        column += len (text)
+
+        # Fields start at columns 24, 40 and 56, i.e. as the Earth table
+        tabs = max (1, (24 + i * 16 - column + 7) // 8)
+        line += '\t' * tabs
+        column = (column // 8 + tabs) * 8
+
+    return line + '},'
+
+
+def main ():
+    parser = argparse.ArgumentParser (description = 'Generate SCALib planet data from VSOP87D file')
+    parser.add_argument ('--min-amplitude', type = float, default = 0.0)
+    parser.add_argument ('name', help = 'planet name, i.e. mars')
+    parser.add_argument ('path', help = 'VSOP87D file')
+    args = parser.parse_args ()
+
+    series = parse (args.path)
+    name = args.name.lower ()
+    sizes = {1: [], 2: [], 3: []}
+    sorted_series = {1: [], 2: [], 3: []}
+    out = []
+
+    out.append ('static const double %s_terms[][3] = {' % name)
+
+    for var, letter in ((1, 'L'), (2, 'B'), (3, 'R')):
+        for power in range (SERIES_MAX):
+            terms = [t for t in series.get ((var, power), []) if abs (t[0]) >= args.min_amplitude]
+            terms.sort (key = lambda t: -abs (t[0]))
+
+            if not terms:
+                break
+
+            sizes[var].append (len (terms))
+            sorted_series[var].append (terms)
+            out.append ('/* %s%d data */' % (letter, power))
+
+            for a, b, c in terms:
+                out.append (format_term ((a, b, c)))
+
+            out.append ('')
+
+    if out[-1] == '':
+        out.pop ()
+
+    out[-1] = out[-1].rstrip (',')
+    out.append ('};')
+    out.append ('')
+    out.append ('static const SCAPlanetDataPrivate %s_data = {' % name)
+    out.append ('/* L, B and R series sizes */')
+    out.append ('{')
+
+    for var in (1, 2, 3):
+        s = sizes[var] + [0] * (SERIES_MAX - len (sizes[var]))
+        out.append ('\t{' + ',\t'.join (str (x) for x in s) + '}' + (',' if var != 3 else ''))
+
+    out.append ('},')
+
+    out.append ('/* Cut points for accuracy tiers */')
+    out.append ('{')
+
+    for n, tier in enumerate (TIERS):
+        out.append ('\t{')
+
+        for var in (1, 2, 3):
+            tolerance = tier * ARCSEC
+
+            if var == 3:
+                tolerance *= abs (sorted_series[3][0][0][0])
+
+            c = get_cuts (sorted_series[var], tolerance) if sorted_series[var] else []
+            c += [0] * (SERIES_MAX - len (c))
+            out.append ('\t\t{' + ',\t'.join (str (x) for x in c) + '}' + (',' if var != 3 else ''))
+
+        out.append ('\t}' + (',' if n != len (TIERS) - 1 else ''))
+
+    out.append ('},')
+    out.append ('%s_terms' % name)
+    out.append ('};')
+
+    sys.stdout.write ('\n'.join (out) + '\n')
+
+
+if __name__ == '__main__':
+    main ()